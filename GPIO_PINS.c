@@ -24,11 +24,64 @@
 
 
 
+/*****************************************************************************************************************
+*	@PinDecodeTable																																																	*
+*	Pin and port names are decoded with a single table lookup instead of a switch. The table is indexed by the name	*
+*	(GPIO_PORT_A..GPIO_PORT_F, PA0..PF7), and every entry is packed as (PIN_VALID | port<<3 | pin number).					*
+*	Names which don't exist are 0, so they decode to GPIO_PORT_A and pin 0 as before.																*
+******************************************************************************************************************/
+#define NO_OF_PIN_NAMES				68
+#define PIN_VALID							0x80
+#define PIN_ENTRY(port, bit)	( PIN_VALID | ((port)<<3) | (bit) )
+#define PIN_PORT(entry)				( ((entry)>>3) & 0x7 )
+#define PIN_BIT(entry)				( (entry) & 0x7 )
+#define PORT_PINS(port)				PIN_ENTRY(port,0), PIN_ENTRY(port,1), PIN_ENTRY(port,2), PIN_ENTRY(port,3),	\
+															PIN_ENTRY(port,4), PIN_ENTRY(port,5), PIN_ENTRY(port,6), PIN_ENTRY(port,7)
+
+static const uint8_t PinDecodeTable[NO_OF_PIN_NAMES] =
+{
+	PIN_ENTRY(GPIO_PORT_A,0), PIN_ENTRY(GPIO_PORT_B,0), PIN_ENTRY(GPIO_PORT_C,0),				//	0 - 9	:	Port names
+	PIN_ENTRY(GPIO_PORT_D,0), PIN_ENTRY(GPIO_PORT_E,0), PIN_ENTRY(GPIO_PORT_F,0), 0, 0, 0, 0,
+	PORT_PINS(GPIO_PORT_A), 0, 0,																												//	10 - 19	:	PA0 - PA7
+	PORT_PINS(GPIO_PORT_B), 0, 0,																												//	20 - 29	:	PB0 - PB7
+	PORT_PINS(GPIO_PORT_C), 0, 0,																												//	30 - 39	:	PC0 - PC7
+	PORT_PINS(GPIO_PORT_D), 0, 0,																												//	40 - 49	:	PD0 - PD7
+	PORT_PINS(GPIO_PORT_E), 0, 0,																												//	50 - 59	:	PE0 - PE7
+	PORT_PINS(GPIO_PORT_F)																															//	60 - 67	:	PF0 - PF7
+};
+
+/*	Module access pointers of the GPIO ports, [bus][port]. On the target they are constants. On the host, the register
+*		model is mapped at run time, so SimInit() fills the table once with GPIO_MapPorts(), and getPortAddr() costs the
+*		same single load as on the target. */
+#define PORT_ACCESS_POINTERS																																		\
+{																																																				\
+	{	GPIO_A_P, GPIO_B_P, GPIO_C_P, GPIO_D_P, GPIO_E_P, GPIO_F_P	},																			\
+	{	GPIO_A_H, GPIO_B_H, GPIO_C_H, GPIO_D_H, GPIO_E_H, GPIO_F_H	}																				\
+}
+
+#ifdef TM4C123XX_HOST_SIM
+static GPIO_reg* PortBaseAddress[2][6];
+
+void GPIO_MapPorts(void)
+{
+	GPIO_reg* const Map[2][6] = PORT_ACCESS_POINTERS;
+	uint8_t bus, port;
+	
+	for(bus = 0; bus < 2; bus++)
+		for(port = 0; port < 6; port++)
+			PortBaseAddress[bus][port] = Map[bus][port];
+}
+#else
+static GPIO_reg* const PortBaseAddress[2][6] = PORT_ACCESS_POINTERS;
+#endif
+
+
+
 /******************************************************************************************************************
 * @getPortAddr()																																																	*
 * @brief	-	Get module access pointer to a GPIO port using name of a pin or port.																	*
 * @pin		-	Pin name or GPIO port, whose address (access pointer) is needed.																			*
-* @bus		-	APB/AHB Bus.																																													*
+* @bus		-	APB/AHB Bus, or SELECTED_BUS for the bus chosen for the port with GPIO_SelectBus().										*
 * @return	- Module access pointer to a GPIO port.																																	*
 *																																																									*
 * @Note		- If an incorrect pin_name or port_name is given as an input to this function, it returns the pointer 	*
@@ -36,83 +89,11 @@
 ******************************************************************************************************************/
 GPIO_reg* getPortAddr(uint8_t pin, uint8_t bus)
 {
-	GPIO_reg* PortAddress;
-	switch(pin)
-	{
-		case GPIO_PORT_A:
-		case PA0:
-		case PA1:
-		case PA2:
-		case PA3:
-		case PA4:
-		case PA5:
-		case PA6:
-		case PA7:	if(bus == AHB_BUS)	PortAddress = GPIO_A_H;
-							else								PortAddress = GPIO_A_P;
-							break;
-		
-		case GPIO_PORT_B:
-		case PB0:
-		case PB1:
-		case PB2:
-		case PB3:
-		case PB4:
-		case PB5:
-		case PB6:
-		case PB7:	if(bus == AHB_BUS)	PortAddress = GPIO_B_H;
-							else								PortAddress = GPIO_B_P;
-							break;
-		
-		case GPIO_PORT_C:
-		case PC0:
-		case PC1:
-		case PC2:
-		case PC3:
-		case PC4:
-		case PC5:
-		case PC6:
-		case PC7:	if(bus == AHB_BUS)	PortAddress = GPIO_C_H;
-							else								PortAddress = GPIO_C_P;
-		
-		case GPIO_PORT_D:
-		case PD0:
-		case PD1:
-		case PD2:
-		case PD3:
-		case PD4:
-		case PD5:
-		case PD6:
-		case PD7:	if(bus == AHB_BUS)	PortAddress = GPIO_D_H;
-							else								PortAddress = GPIO_D_P;
-							break;
-		
-		case GPIO_PORT_E:
-		case PE0:
-		case PE1:
-		case PE2:
-		case PE3:
-		case PE4:
-		case PE5:
-		case PE6:
-		case PE7:	if(bus == AHB_BUS)	PortAddress = GPIO_E_H;
-							else								PortAddress = GPIO_E_P;
-							break;
-		
-		case GPIO_PORT_F:
-		case PF0:
-		case PF1:
-		case PF2:
-		case PF3:
-		case PF4:
-		case PF5:
-		case PF6:
-		case PF7:	if(bus == AHB_BUS)	PortAddress = GPIO_F_H;
-							else								PortAddress = GPIO_F_P;
-							break;
-		
-		default:	PortAddress = GPIO_A_H;
-	}
-	return PortAddress;
+	uint8_t Entry = (pin < NO_OF_PIN_NAMES) ? PinDecodeTable[pin] : 0;
+
+	if( !(Entry & PIN_VALID) )		return PortBaseAddress[1][GPIO_PORT_A];
+	if(bus == SELECTED_BUS)				bus = GET_BIT( GPIOBusSelect, PIN_PORT(Entry) );
+	return PortBaseAddress[bus == AHB_BUS][ PIN_PORT(Entry) ];
 }
 
 
@@ -127,67 +108,8 @@ GPIO_reg* getPortAddr(uint8_t pin, uint8_t bus)
 ******************************************************************************************************************/
 uint8_t getPortName(uint8_t pin)
 {
-	uint8_t PortName = 0;
-	switch(pin)
-	{
-		case PA0:
-		case PA1:
-		case PA2:
-		case PA3:
-		case PA4:
-		case PA5:
-		case PA6:
-		case PA7:	PortName = GPIO_PORT_A;
-							break;
-		case PB0:
-		case PB1:
-		case PB2:
-		case PB3:
-		case PB4:
-		case PB5:
-		case PB6:
-		case PB7:	PortName = GPIO_PORT_B;
-							break;
-		case PC0:
-		case PC1:
-		case PC2:
-		case PC3:
-		case PC4:
-		case PC5:
-		case PC6:
-		case PC7:	PortName = GPIO_PORT_C;
-							break;
-		case PD0:
-		case PD1:
-		case PD2:
-		case PD3:
-		case PD4:
-		case PD5:
-		case PD6:
-		case PD7:	PortName = GPIO_PORT_D;
-							break;
-		case PE0:
-		case PE1:
-		case PE2:
-		case PE3:
-		case PE4:
-		case PE5:
-		case PE6:
-		case PE7:	PortName = GPIO_PORT_E;
-							break;
-		case PF0:
-		case PF1:
-		case PF2:
-		case PF3:
-		case PF4:
-		case PF5:
-		case PF6:
-		case PF7:	PortName = GPIO_PORT_F;
-							break;
-		
-		default:	PortName = GPIO_PORT_A;
-	}
-	return PortName;
+	uint8_t Entry = (pin < NO_OF_PIN_NAMES) ? PinDecodeTable[pin] : 0;
+	return PIN_PORT(Entry);
 }
 
 
@@ -202,75 +124,8 @@ uint8_t getPortName(uint8_t pin)
 ******************************************************************************************************************/
 uint8_t getPinNumber(uint8_t pin)
 {
-	uint8_t pinNumber = 0;
-	switch(pin)
-	{
-		case PA0:
-		case PB0:
-		case PC0:
-		case PD0:
-		case PE0:
-		case PF0:	pinNumber = 0;
-							break;
-
-		case PA1:
-		case PB1:
-		case PC1:
-		case PD1:
-		case PE1:
-		case PF1:	pinNumber = 1;
-							break;
-
-		case PA2:
-		case PB2:
-		case PC2:
-		case PD2:
-		case PE2:
-		case PF2:	pinNumber = 2;
-							break;
-
-		case PA3:
-		case PB3:
-		case PC3:
-		case PD3:
-		case PE3:
-		case PF3:	pinNumber = 3;
-							break;
-
-		case PA4:
-		case PB4:
-		case PC4:
-		case PD4:
-		case PE4:
-		case PF4:	pinNumber = 4;
-							break;
-
-		case PA5:
-		case PB5:
-		case PC5:
-		case PD5:
-		case PE5:
-		case PF5:	pinNumber = 5;
-							break;
-
-		case PA6:
-		case PB6:
-		case PC6:
-		case PD6:
-		case PE6:
-		case PF6:	pinNumber = 6;
-							break;
-
-		case PA7:
-		case PB7:
-		case PC7:
-		case PD7:
-		case PE7:
-		case PF7:	pinNumber = 7;
-							break;
-	}
-
-	return pinNumber;
+	uint8_t Entry = (pin < NO_OF_PIN_NAMES) ? PinDecodeTable[pin] : 0;
+	return PIN_BIT(Entry);
 }
 
 
@@ -283,81 +138,271 @@ uint8_t getPinNumber(uint8_t pin)
 *	@TurnOff()			-	Turn Off an LED.																																							*
 *	@WhiteLEDon()		-	Turn all LEDs On, creating white light.																												*
 *	@WhiteLEDoff()	-	Turn all LEDs Off.																																						*
-*	@blink()				-	Blink a given LED once.																																				*
+*	@blink()				-	Blink a pin once (without waiting for LEDs, after UseLEDPatterns()).													*
+*	@blinkWhiteLED()	-	Blink all LEDs once (without waiting, after UseLEDPatterns()).															*
+*																																																									*
+*	@UseLEDPatterns()	-	Start the timer tick which runs the LED patterns. Needed by the functions below.						*
+*	@LEDBlink()			-	Blink a color a given no of times, or forever.																								*
+*	@LEDBreathe()		-	Fade a color in and out continuously.																													*
+*	@LEDSequence()	-	Show a sequence of colors a given no of times, or forever.																		*
+*	@LEDStop()			-	Stop the running pattern and turn all LEDs Off.																								*
+*	@LEDPatternIT_H()	-	Helper for the Interrupt Handler function of the LED pattern timer.													*
 *																																																									*
 *	@UseButtons()		-	Initialize on-board buttons as Input (pulled up) pins.																				*
 * @ReadButtons()	-	Read the state of on-board buttons. (This function is not working properly)										*
 ******************************************************************************************************************/
-static void delay_for_blink(void);		// see definition below
+#define LED_PORT_DATA		(getPortAddr(GPIO_PORT_F,SELECTED_BUS))->GPIO_DATA_A[COLOR_WHITE]
 void UseLEDs(void)
 {
-	GPIO_Init(LED_RED, Output, Digital, Two_mA, NoInterrupt);
-	GPIO_Init(LED_BLUE, Output, Digital, Two_mA, NoInterrupt);
-	GPIO_Init(LED_GREEN, Output, Digital, Two_mA, NoInterrupt);
+	GPIO_InitPort(GPIO_PORT_F, COLOR_WHITE, Output, Digital, Two_mA, NoInterrupt);
 }
 
 
 void TurnOn(uint8_t pin)
 {
-	getPortAddr(pin,APB_BUS)->GPIO_DATA SET_BIT( getPinNumber(pin) );
+	(getPortAddr(pin,SELECTED_BUS))->GPIO_DATA_A[1<<getPinNumber(pin)] = 0xFF;
 }
 
 void TurnOff(uint8_t pin)
 {
-	getPortAddr(pin,APB_BUS)->GPIO_DATA CLR_BIT( getPinNumber(pin) );
+	(getPortAddr(pin,SELECTED_BUS))->GPIO_DATA_A[1<<getPinNumber(pin)] = 0x00;
 }
 
 
 void WhiteLEDon(void)
 {
-	TurnOn(LED_RED);
-	TurnOn(LED_BLUE);
-	TurnOn(LED_GREEN);
-	delay_for_blink();
+	WriteToPortMasked(GPIO_PORT_F, COLOR_WHITE, 0xFF);		//	All three LEDs change with one store.
 }
 
 void WhiteLEDoff(void)
 {
-	TurnOff(LED_RED);
-	TurnOff(LED_BLUE);
-	TurnOff(LED_GREEN);
+	WriteToPortMasked(GPIO_PORT_F, COLOR_WHITE, 0x00);
+}
+
+
+
+/******************************************************************************************************************
+* LED pattern engine																																															*
+*																																																									*
+*	The LEDs are driven from the interrupt of a periodic timer running at LED_TICK_HZ, so no function waits for an	*
+*	LED and the timing doesn't depend on the optimization level. A tick costs a few instructions and at most one		*
+*	store to the LED pins. The color is not cached, as TurnOn(), WhiteLEDon() etc. write the same pins.							*
+*	<>	Blink and Sequence patterns step through a list of (Color, Duration) steps.																	*
+*	<>	Breathe pattern runs a triangle wave through a square-law (gamma) curve, and turns it into On/Off ticks with *
+*			a first order sigma-delta modulator, which switches the LED much faster than a PWM frame of the same tick.	*
+*																																																									*
+*	A new pattern is set up while LED.Mode is LED_IDLE, and then started with a single store to LED.Mode, so a tick	*
+*	which interrupts the set up never sees half of a pattern.																												*
+******************************************************************************************************************/
+#define LED_IDLE				0
+#define LED_SEQUENCE		1
+#define LED_BREATHE			2
+
+typedef struct
+{
+	uint8_t					Mode;
+	uint8_t					Timer;							//	Timer which generates the ticks. 0 => UseLEDPatterns() not called
+	
+	const LEDStep*	pSteps;							//	Sequence pattern
+	uint8_t					NoOfSteps;
+	uint8_t					StepIndex;
+	uint8_t					Count;							//	No of times the sequence is still to be shown. 0 => forever
+	uint16_t				TicksLeft;
+	
+	uint8_t					Color;							//	Breathe pattern
+	uint32_t				Phase;
+	uint32_t				PhaseStep;
+	uint16_t				Accumulator;
+}LEDPatternState;
+
+static __vo LEDPatternState LED;
+static LEDStep LEDBlinkSteps[2];
+
+
+static void LEDShow(uint8_t Color)
+{
+	LED_PORT_DATA = Color;
+}
+
+//	Busy-wait of about Ms milliseconds, for blink() and blinkWhiteLED() when no pattern timer is running. The counter
+//	is volatile, so the loop is kept at every optimization level. An iteration takes about 4 cycles.
+static void LEDDelay(uint16_t Ms)
+{
+	__vo uint32_t i;
+	
+	for(i = (SYS_CLK/4000) * Ms; i; i--);
+}
+
+static void LEDShowStep(void)
+{
+	const LEDStep* pStep = &LED.pSteps[LED.StepIndex];
+	
+	LED.TicksLeft = pStep->Duration ? pStep->Duration : 1;
+	LEDShow(pStep->Color);
 }
 
 
 /******************************************************************************************************************
-* @delay_for_blink()																																															*
-* @brief	-	Used to create delay between ON and OFF states of an LED.																							*
+* @UseLEDPatterns()																																																*
+* @brief	-	Initialize on-board LEDs and start the tick of the LED pattern engine.																*
+* @Timerx	-	Timer module used for the ticks.																																			*
 * @return	-	Nothing (void)																																												*
 *																																																									*
-* @Note		-	This function runs an empty loop for creating delay. It may be replaced by a timer api in future, if	*
-*						blocking creates a problem.																																						*
-*						This function is declared "static" so that it couldn't be used outside this file.											*
+* @Note		-	The handler of the timer (TIMERxA_Handler in the startup file) must call LEDPatternIT_H().						*
 ******************************************************************************************************************/
-static void delay_for_blink(void)
+void UseLEDPatterns(uint8_t Timerx)
 {
-	unsigned long i;
-	for(i = 0; i<7500000; i++);
+	UseLEDs();
+	LED.Mode = LED_IDLE;
+	LED.Timer = Timerx;
+	
+	TimerInit(Timerx, PeriodicTimer, CountDown, SYS_CLK/LED_TICK_HZ);
+	TimerIntControl(Timerx, ENABLE);
+	TimerStart(Timerx);
 }
 
+
+/******************************************************************************************************************
+* @LEDBlink()																																																			*
+* @brief		-	Blink a color. Returns immediately, the blinking is done by the tick.																*
+* @Color		-	COLOR_x.																																														*
+* @OnTime		-	No of ticks (ms) for which the LEDs stay On.																												*
+* @OffTime	-	No of ticks (ms) for which the LEDs stay Off.																												*
+* @Count		-	No of blinks. 0 => blink until another pattern is started.																					*
+******************************************************************************************************************/
+void LEDBlink(uint8_t Color, uint16_t OnTime, uint16_t OffTime, uint8_t Count)
+{
+	LED.Mode = LED_IDLE;
+	LEDBlinkSteps[0].Color = Color;					LEDBlinkSteps[0].Duration = OnTime;
+	LEDBlinkSteps[1].Color = COLOR_OFF;			LEDBlinkSteps[1].Duration = OffTime;
+	LEDSequence(LEDBlinkSteps, 2, Count);
+}
+
+
+/******************************************************************************************************************
+* @LEDBreathe()																																																		*
+* @brief		-	Fade a color in and out until another pattern is started. Returns immediately.											*
+* @Color		-	COLOR_x.																																														*
+* @Period		-	No of ticks (ms) for one fade in and fade out.																											*
+******************************************************************************************************************/
+void LEDBreathe(uint8_t Color, uint16_t Period)
+{
+	LED.Mode = LED_IDLE;
+	LED.Color = Color;
+	LED.Phase = 0;
+	LED.PhaseStep = 0xFFFFFFFF / (Period ? Period : 1);
+	LED.Accumulator = 0;
+	LED.Mode = LED_BREATHE;
+}
+
+
+/******************************************************************************************************************
+* @LEDSequence()																																																	*
+* @brief			-	Show a sequence of colors. Returns immediately, the sequence is shown by the tick.								*
+* @pSteps			-	Steps of the sequence. The array is not copied, it must stay valid while the sequence is shown.		*
+* @NoOfSteps	-	No of steps.																																											*
+* @Count			-	No of times the sequence is shown. 0 => repeat until another pattern is started.									*
+*																																																									*
+* @Note			-	The LEDs are turned Off when the sequence ends.																											*
+******************************************************************************************************************/
+void LEDSequence(const LEDStep* pSteps, uint8_t NoOfSteps, uint8_t Count)
+{
+	LED.Mode = LED_IDLE;
+	if(NoOfSteps == 0)
+	{
+		LEDStop();
+		return;
+	}
+	LED.pSteps = pSteps;
+	LED.NoOfSteps = NoOfSteps;
+	LED.StepIndex = 0;
+	LED.Count = Count;
+	LEDShowStep();
+	LED.Mode = LED_SEQUENCE;
+}
+
+
+void LEDStop(void)
+{
+	LED.Mode = LED_IDLE;
+	LEDShow(COLOR_OFF);
+}
+
+
+/******************************************************************************************************************
+* @blink() / @blinkWhiteLED()																																											*
+* @brief	-	Blink a pin / all LEDs once, LED_BLINK_MS On and LED_BLINK_MS Off.																		*
+* @pin		-	Pin to blink.																																													*
+* @return	-	Nothing (void)																																												*
+*																																																									*
+* @Note		-	After UseLEDPatterns(), the LEDs are blinked by the pattern engine and these functions return at once.	*
+*						Without it, or for a pin which is not an LED, the pin is turned On and Off with a busy-wait as before.	*
+******************************************************************************************************************/
 void blink(uint8_t pin)
 {
-	ToggleGPIOPin(pin);				delay_for_blink();
-	ToggleGPIOPin(pin);				delay_for_blink();
+	if(LED.Timer != 0 && (pin == LED_RED || pin == LED_BLUE || pin == LED_GREEN))
+	{
+		LEDBlink(1<<getPinNumber(pin), LED_BLINK_MS, LED_BLINK_MS, 1);
+		return;
+	}
+	ToggleGPIOPin(pin);				LEDDelay(LED_BLINK_MS);
+	ToggleGPIOPin(pin);				LEDDelay(LED_BLINK_MS);
 }
 
 void blinkWhiteLED(void)
 {
-	WriteToPin(LED_RED, PIN_SET);
-	WriteToPin(LED_BLUE, PIN_SET);
-	WriteToPin(LED_GREEN, PIN_SET);
-	
-	delay_for_blink();
-	
-	WriteToPin(LED_RED, PIN_RESET);
-	WriteToPin(LED_BLUE, PIN_RESET);
-	WriteToPin(LED_GREEN, PIN_RESET);
+	if(LED.Timer != 0)
+	{
+		LEDBlink(COLOR_WHITE, LED_BLINK_MS, LED_BLINK_MS, 1);
+		return;
+	}
+	LEDShow(COLOR_WHITE);			LEDDelay(LED_BLINK_MS);
+	LEDShow(COLOR_OFF);				LEDDelay(LED_BLINK_MS);
+}
+
+
+/******************************************************************************************************************
+* @LEDPatternIT_H()																																																*
+* @brief	-	Interrupt handler helper for the LED pattern timer. Call it from the handler of the timer.						*
+* @return	-	Nothing (void)																																												*
+******************************************************************************************************************/
+void LEDPatternIT_H(void)
+{
+	TimerClearInt(LED.Timer);
 	
-	delay_for_blink();
+	if(LED.Mode == LED_SEQUENCE)
+	{
+		if(--LED.TicksLeft)		return;
+		
+		if(++LED.StepIndex == LED.NoOfSteps)
+		{
+			LED.StepIndex = 0;
+			if(LED.Count && --LED.Count == 0)
+			{
+				LEDStop();
+				return;
+			}
+		}
+		LEDShowStep();
+	}
+	else if(LED.Mode == LED_BREATHE)
+	{
+		uint32_t Triangle = LED.Phase >> 23;											//	0 ... 511
+		uint32_t Brightness;
+		
+		if(Triangle > 255)		Triangle = 511 - Triangle;
+		Brightness = (Triangle * Triangle) >> 8;									//	0 ... 254, square law for the eye
+		
+		LED.Phase += LED.PhaseStep;
+		LED.Accumulator += Brightness;
+		if(LED.Accumulator >= 256)
+		{
+			LED.Accumulator -= 256;
+			LEDShow(LED.Color);
+		}
+		else
+			LEDShow(COLOR_OFF);
+	}
 }
 
 
@@ -91,6 +91,26 @@
 #define USER_SW1		PF4
 #define USER_SW2		PF0
 
+// Colors of the on-board RGB LED, as masks of the LED pins (PF1, PF2, PF3) in GPIO Port F
+#define COLOR_OFF			0x00
+#define COLOR_RED			0x02
+#define COLOR_BLUE		0x04
+#define COLOR_GREEN		0x08
+#define COLOR_MAGENTA	( COLOR_RED | COLOR_BLUE )
+#define COLOR_YELLOW	( COLOR_RED | COLOR_GREEN )
+#define COLOR_CYAN		( COLOR_BLUE | COLOR_GREEN )
+#define COLOR_WHITE		( COLOR_RED | COLOR_BLUE | COLOR_GREEN )
+
+// LED pattern engine
+#define LED_TICK_HZ		1000				//	Tick rate of the pattern engine. All pattern durations are in ticks (ms).
+#define LED_BLINK_MS	250					//	On and Off time used by blink() and blinkWhiteLED()
+
+typedef struct
+{
+	uint8_t		Color;							//	COLOR_x
+	uint16_t	Duration;						//	No of ticks (ms) for which the color is shown
+}LEDStep;
+
 
 
 /******************************************************************************************************************
@@ -105,6 +125,10 @@ GPIO_reg* getPortAddr(uint8_t pin, uint8_t bus);
 uint8_t getPortName(uint8_t pin);
 uint8_t getPinNumber(uint8_t pin);
 
+#ifdef TM4C123XX_HOST_SIM
+void GPIO_MapPorts(void);																	//	Called by SimInit()
+#endif
+
 
 /******************************************************************************************************************
 * Section 3: Functions for on-board LEDs and Buttons																															*
@@ -114,7 +138,18 @@ uint8_t getPinNumber(uint8_t pin);
 *	@TurnOff()			-	Turn Off an LED.																																							*
 *	@WhiteLEDon()		-	Turn all LEDs On, creating white light.																												*
 *	@WhiteLEDoff()	-	Turn all LEDs Off.																																						*
-*	@blink()				-	Blink a given LED once.																																				*
+*	@blink()				-	Blink a pin once.																																							*
+*	@blinkWhiteLED()	-	Blink all LEDs once.																																				*
+*										blink() and blinkWhiteLED() wait LED_BLINK_MS On and Off, as before, unless UseLEDPatterns()	*
+*										has been called. Then they start an LEDBlink() on the LED pins and return at once. To drop the	*
+*										busy-wait, call UseLEDPatterns() at start up and use LEDBlink() etc. in new code.							*
+*																																																									*
+*	@UseLEDPatterns()	-	Start the timer tick which runs the LED patterns. Needed by the functions below.						*
+*	@LEDBlink()			-	Blink a color a given no of times, or forever.																								*
+*	@LEDBreathe()		-	Fade a color in and out continuously.																													*
+*	@LEDSequence()	-	Show a sequence of colors a given no of times, or forever.																		*
+*	@LEDStop()			-	Stop the running pattern and turn all LEDs Off.																								*
+*	@LEDPatternIT_H()	-	Helper for the Interrupt Handler function of the LED pattern timer.													*
 *																																																									*
 *	@UseButtons()		-	Initialize on-board buttons as Input (pulled up) pins.																				*
 * @ReadButtons()	-	Read the state of on-board buttons. (This function is not working properly)										*
@@ -127,6 +162,13 @@ void blinkWhiteLED(void);
 void WhiteLEDon(void);
 void WhiteLEDoff(void);
 
+void UseLEDPatterns(uint8_t Timerx);
+void LEDBlink(uint8_t Color, uint16_t OnTime, uint16_t OffTime, uint8_t Count);
+void LEDBreathe(uint8_t Color, uint16_t Period);
+void LEDSequence(const LEDStep* pSteps, uint8_t NoOfSteps, uint8_t Count);
+void LEDStop(void);
+void LEDPatternIT_H(void);
+
 void UseButtons(void);
 uint8_t ReadButtons(void);
 
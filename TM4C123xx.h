@@ -29,6 +29,7 @@
 * 3. SSI Modules																																																	*
 *	4. I2C Modules																																																	*
 *	5. UART Modules																																																	*
+*	8. uDMA Controller																																															*
 *																																																									*
 *	9.	Miscellaneous macros & aliases																																							*
 *	9.	Driver & other dependencies																																									*
@@ -53,6 +54,36 @@
 
 
 
+/******************************************************************************************************************
+*	Host simulation build																																														*
+*	Module access pointers (section 4 of each peripheral) are built with PERIPH_ADDR(). On the target it is just the *
+*	hardware address. When TM4C123XX_HOST_SIM is defined, the address is translated into the register model of			*
+*	TM4C123xxSIM.c, so that the drivers can be run on a Linux build machine. See TM4C123xxSIM.h for details.				*
+*																																																									*
+*	Addresses which are handed to the uDMA controller are built with BUS_ADDR(). On the target it is just the 32-bit	*
+*	value of the pointer. On the host it is the address which the register model uses for that memory.							*
+******************************************************************************************************************/
+#ifdef TM4C123XX_HOST_SIM
+
+extern uint8_t* SimFlashRegion;									//	Stands in for 0x00000000 - 0x00000FFF (Vector Table)
+extern uint8_t* SimPeriphRegion;								//	Stands in for 0x40000000 - 0x400FFFFF (Peripherals)
+extern uint8_t* SimCoreRegion;									//	Stands in for 0xE000E000 - 0xE000EFFF (Core Peripherals)
+
+#define PERIPH_ADDR(addr)	( (addr) >= CORE_PERIPHERAL_BASE_ADDR ?	(SimCoreRegion	 + ((addr) - CORE_PERIPHERAL_BASE_ADDR))	: \
+														(addr) >= PERIPHERAL_BASE_ADDR ?			(SimPeriphRegion + ((addr) - PERIPHERAL_BASE_ADDR))				: \
+																																		(SimFlashRegion	 + ((addr) - FLASH_BASE_ADDR)) )
+
+uint32_t SimBusAddress(const __vo void* p);
+#define BUS_ADDR(p)				SimBusAddress(p)
+#else
+
+#define PERIPH_ADDR(addr)	(addr)
+#define BUS_ADDR(p)				( (uint32_t)(p) )
+
+#endif
+
+
+
 /******************************************************************************************************************
 *																									Peripheral Names																								*
 ******************************************************************************************************************/
@@ -115,6 +146,7 @@
 //	1.1 - Base Addresses
 #define FLASH_BASE_ADDR								0X00000000U							// Base Addr of Flash Memory
 #define SRAM_BASE_ADDR								0x20000000U							// Base Addr of SRAM1
+#define PERIPHERAL_BASE_ADDR					0x40000000U							// Base Addr of On-chip Peripherals
 
 #define CORE_PERIPHERAL_BASE_ADDR 		0xE000E000U							// Base Addr of Core Peripherals
 #define SYSTEM_CONTROL_BASE_ADDR			0x400FE000U							// Base Addr of System Control Block Register
@@ -315,7 +347,7 @@ typedef struct
   __vo uint32_t  PRWTIMER; 
 }SYSCTL_reg;
 
-#define SYSCTL ( (SYSCTL_reg*)SYSTEM_CONTROL_BASE_ADDR )		// Pointer for Register Access (System Control Block)
+#define SYSCTL ( (SYSCTL_reg*)PERIPH_ADDR(SYSTEM_CONTROL_BASE_ADDR) )		// Pointer for Register Access (System Control Block)
 
 
 
@@ -363,7 +395,7 @@ typedef struct
 }Exception_Handler_reg;
 
 		/* Pointer for Register Access (Exception Handlers)	*/
-#define ExceptionHandlers ( (Exception_Handler_reg*)VECTOR_TABLE_BASE_ADDR )
+#define ExceptionHandlers ( (Exception_Handler_reg*)PERIPH_ADDR(VECTOR_TABLE_BASE_ADDR) )
 
 
 
@@ -381,7 +413,7 @@ typedef struct
 	
 }NVIC_reg;
 
-#define NVIC ( (NVIC_reg*)NVIC_BASE_ADDR )
+#define NVIC ( (NVIC_reg*)PERIPH_ADDR(NVIC_BASE_ADDR) )
 /****************************************************************************
 *		NVIC Enable Registers Bit definitions																		*
 *																																						*
@@ -465,10 +497,23 @@ typedef struct
 
 //	2.3 Register Definition
 
+#if defined(__CC_ARM)
+#pragma anon_unions
+#endif
+
 typedef struct
 {
-	__vo uint32_t GPIO_DATA_A[255];						//	GPIO Data (Address Masked)
-	__vo uint32_t GPIO_DATA;									//	GPIO Data Register (All bits can be changed)
+	union
+	{
+		//	GPIO Data (Address Masked). GPIO_DATA_A[mask] reads/writes only the pins set in mask, so a single store
+		//	changes a group of pins without a read-modify-write. GPIO_DATA_A[0xFF] is GPIO_DATA.
+		__vo uint32_t GPIO_DATA_A[256];
+		struct
+		{
+			__vo uint32_t GPIO_DATA_RESERVED[255];
+			__vo uint32_t GPIO_DATA;							//	GPIO Data Register (All bits can be changed)
+		};
+	};
 	__vo uint32_t GPIO_DIR;										//	GPIO Direction Register
 	__vo uint32_t GPIO_IS;										//	GPIO Interrupt Sense Register
 	__vo uint32_t GPIO_IBE;										//	GPIO Interrupt Both Edges
@@ -514,19 +559,19 @@ typedef struct
 
 //	2.4 Module Access Pointers
 
-#define GPIO_A_H 		( (GPIO_reg*) GPIOAH_BASE_ADDRESS )				//	Pointers for GPIO Module on AHB Bus
-#define GPIO_B_H 		( (GPIO_reg*) GPIOBH_BASE_ADDRESS )
-#define GPIO_C_H 		( (GPIO_reg*) GPIOCH_BASE_ADDRESS )
-#define GPIO_D_H 		( (GPIO_reg*) GPIODH_BASE_ADDRESS )
-#define GPIO_E_H 		( (GPIO_reg*) GPIOEH_BASE_ADDRESS )
-#define GPIO_F_H 		( (GPIO_reg*) GPIOFH_BASE_ADDRESS )
+#define GPIO_A_H 		( (GPIO_reg*) PERIPH_ADDR(GPIOAH_BASE_ADDRESS) )				//	Pointers for GPIO Module on AHB Bus
+#define GPIO_B_H 		( (GPIO_reg*) PERIPH_ADDR(GPIOBH_BASE_ADDRESS) )
+#define GPIO_C_H 		( (GPIO_reg*) PERIPH_ADDR(GPIOCH_BASE_ADDRESS) )
+#define GPIO_D_H 		( (GPIO_reg*) PERIPH_ADDR(GPIODH_BASE_ADDRESS) )
+#define GPIO_E_H 		( (GPIO_reg*) PERIPH_ADDR(GPIOEH_BASE_ADDRESS) )
+#define GPIO_F_H 		( (GPIO_reg*) PERIPH_ADDR(GPIOFH_BASE_ADDRESS) )
 
-#define GPIO_A_P 		( (GPIO_reg*) GPIOAP_BASE_ADDRESS )				//	Pointers for GPIO Module on APB Bus
-#define GPIO_B_P 		( (GPIO_reg*) GPIOBP_BASE_ADDRESS )
-#define GPIO_C_P 		( (GPIO_reg*) GPIOCP_BASE_ADDRESS )
-#define GPIO_D_P 		( (GPIO_reg*) GPIODP_BASE_ADDRESS )
-#define GPIO_E_P 		( (GPIO_reg*) GPIOEP_BASE_ADDRESS )
-#define GPIO_F_P 		( (GPIO_reg*) GPIOFP_BASE_ADDRESS )
+#define GPIO_A_P 		( (GPIO_reg*) PERIPH_ADDR(GPIOAP_BASE_ADDRESS) )				//	Pointers for GPIO Module on APB Bus
+#define GPIO_B_P 		( (GPIO_reg*) PERIPH_ADDR(GPIOBP_BASE_ADDRESS) )
+#define GPIO_C_P 		( (GPIO_reg*) PERIPH_ADDR(GPIOCP_BASE_ADDRESS) )
+#define GPIO_D_P 		( (GPIO_reg*) PERIPH_ADDR(GPIODP_BASE_ADDRESS) )
+#define GPIO_E_P 		( (GPIO_reg*) PERIPH_ADDR(GPIOEP_BASE_ADDRESS) )
+#define GPIO_F_P 		( (GPIO_reg*) PERIPH_ADDR(GPIOFP_BASE_ADDRESS) )
 
 
 
@@ -585,10 +630,10 @@ typedef struct
 
 //	3.4 Module Access Pointers
 
-#define pSSI0 		( (ssi_reg*) SSI0_BASE_ADDRESS )
-#define pSSI1 		( (ssi_reg*) SSI1_BASE_ADDRESS )
-#define pSSI2 		( (ssi_reg*) SSI2_BASE_ADDRESS )
-#define pSSI3 		( (ssi_reg*) SSI3_BASE_ADDRESS )
+#define pSSI0 		( (ssi_reg*) PERIPH_ADDR(SSI0_BASE_ADDRESS) )
+#define pSSI1 		( (ssi_reg*) PERIPH_ADDR(SSI1_BASE_ADDRESS) )
+#define pSSI2 		( (ssi_reg*) PERIPH_ADDR(SSI2_BASE_ADDRESS) )
+#define pSSI3 		( (ssi_reg*) PERIPH_ADDR(SSI3_BASE_ADDRESS) )
 
 
 
@@ -660,10 +705,10 @@ typedef struct
 
 
 //	4.4 Module Access Pointers
-#define pI2C0					( (I2C_reg*) I2C0_BASE_ADDRESS )
-#define pI2C1					( (I2C_reg*) I2C1_BASE_ADDRESS )
-#define pI2C2					( (I2C_reg*) I2C2_BASE_ADDRESS )
-#define pI2C3					( (I2C_reg*) I2C3_BASE_ADDRESS )
+#define pI2C0					( (I2C_reg*) PERIPH_ADDR(I2C0_BASE_ADDRESS) )
+#define pI2C1					( (I2C_reg*) PERIPH_ADDR(I2C1_BASE_ADDRESS) )
+#define pI2C2					( (I2C_reg*) PERIPH_ADDR(I2C2_BASE_ADDRESS) )
+#define pI2C3					( (I2C_reg*) PERIPH_ADDR(I2C3_BASE_ADDRESS) )
 
 
 
@@ -751,14 +796,14 @@ typedef struct
 
 
 //	5.4 Module Access Pointers
-#define pUART0					( (UART_Reg*) UART0_BASE_ADDRESS )
-#define pUART1					( (UART_Reg*) UART1_BASE_ADDRESS )
-#define pUART2					( (UART_Reg*) UART2_BASE_ADDRESS )
-#define pUART3					( (UART_Reg*) UART3_BASE_ADDRESS )
-#define pUART4					( (UART_Reg*) UART4_BASE_ADDRESS )
-#define pUART5					( (UART_Reg*) UART5_BASE_ADDRESS )
-#define pUART6					( (UART_Reg*) UART6_BASE_ADDRESS )
-#define pUART7					( (UART_Reg*) UART7_BASE_ADDRESS )
+#define pUART0					( (UART_Reg*) PERIPH_ADDR(UART0_BASE_ADDRESS) )
+#define pUART1					( (UART_Reg*) PERIPH_ADDR(UART1_BASE_ADDRESS) )
+#define pUART2					( (UART_Reg*) PERIPH_ADDR(UART2_BASE_ADDRESS) )
+#define pUART3					( (UART_Reg*) PERIPH_ADDR(UART3_BASE_ADDRESS) )
+#define pUART4					( (UART_Reg*) PERIPH_ADDR(UART4_BASE_ADDRESS) )
+#define pUART5					( (UART_Reg*) PERIPH_ADDR(UART5_BASE_ADDRESS) )
+#define pUART6					( (UART_Reg*) PERIPH_ADDR(UART6_BASE_ADDRESS) )
+#define pUART7					( (UART_Reg*) PERIPH_ADDR(UART7_BASE_ADDRESS) )
 
 
 
@@ -851,19 +896,82 @@ typedef struct
 
 // 7.4 Module Access Pointers
 
-#define pTimer0 ( (Timer_Reg*) Timer0_BASE_ADDRESS)
-#define pTimer1 ( (Timer_Reg*) Timer1_BASE_ADDRESS)
-#define pTimer2 ( (Timer_Reg*) Timer2_BASE_ADDRESS)
-#define pTimer3 ( (Timer_Reg*) Timer3_BASE_ADDRESS)
-#define pTimer4 ( (Timer_Reg*) Timer4_BASE_ADDRESS)
-#define pTimer5 ( (Timer_Reg*) Timer5_BASE_ADDRESS)
+#define pTimer0 ( (Timer_Reg*) PERIPH_ADDR(Timer0_BASE_ADDRESS) )
+#define pTimer1 ( (Timer_Reg*) PERIPH_ADDR(Timer1_BASE_ADDRESS) )
+#define pTimer2 ( (Timer_Reg*) PERIPH_ADDR(Timer2_BASE_ADDRESS) )
+#define pTimer3 ( (Timer_Reg*) PERIPH_ADDR(Timer3_BASE_ADDRESS) )
+#define pTimer4 ( (Timer_Reg*) PERIPH_ADDR(Timer4_BASE_ADDRESS) )
+#define pTimer5 ( (Timer_Reg*) PERIPH_ADDR(Timer5_BASE_ADDRESS) )
+
+#define pTimer0W ( (Timer_Reg*) PERIPH_ADDR(Timer0W_BASE_ADDRESS) )
+#define pTimer1W ( (Timer_Reg*) PERIPH_ADDR(Timer1W_BASE_ADDRESS) )
+#define pTimer2W ( (Timer_Reg*) PERIPH_ADDR(Timer2W_BASE_ADDRESS) )
+#define pTimer3W ( (Timer_Reg*) PERIPH_ADDR(Timer3W_BASE_ADDRESS) )
+#define pTimer4W ( (Timer_Reg*) PERIPH_ADDR(Timer4W_BASE_ADDRESS) )
+#define pTimer5W ( (Timer_Reg*) PERIPH_ADDR(Timer5W_BASE_ADDRESS) )
+
 
-#define pTimer0W ( (Timer_Reg*) Timer0W_BASE_ADDRESS)
-#define pTimer1W ( (Timer_Reg*) Timer1W_BASE_ADDRESS)
-#define pTimer2W ( (Timer_Reg*) Timer2W_BASE_ADDRESS)
-#define pTimer3W ( (Timer_Reg*) Timer3W_BASE_ADDRESS)
-#define pTimer4W ( (Timer_Reg*) Timer4W_BASE_ADDRESS)
-#define pTimer5W ( (Timer_Reg*) Timer5W_BASE_ADDRESS)
+
+/******************************************************************************************************************
+*																			MICRO DIRECT MEMORY ACCESS (uDMA) CONTROLLER																*
+******************************************************************************************************************/
+
+//	8.1 Base Address
+#define DMA_BASE_ADDR					0x400FF000U
+
+
+//	8.2 Clock Enable and Disable Macros
+#define DMA_PCLK_EN()					( SYSCTL->RCGCDMA |= (1<<0) )
+#define DMA_PCLK_DIS()				( SYSCTL->RCGCDMA &= ~(1<<0) )
+
+
+//	8.3 Register Definition
+
+typedef struct
+{
+	__vo uint32_t STAT;										//	DMA Status
+	__vo uint32_t CFG;										//	DMA Configuration
+	__vo uint32_t CTLBASE;								//	DMA Channel Control Base Pointer
+	__vo uint32_t ALTBASE;								//	DMA Alternate Channel Control Base Pointer
+	__vo uint32_t WAITSTAT;								//	DMA Channel Wait-on-Request Status
+	__vo uint32_t SWREQ;									//	DMA Channel Software Request
+	__vo uint32_t USEBURSTSET;						//	DMA Channel Useburst Set
+	__vo uint32_t USEBURSTCLR;						//	DMA Channel Useburst Clear
+	__vo uint32_t REQMASKSET;							//	DMA Channel Request Mask Set
+	__vo uint32_t REQMASKCLR;							//	DMA Channel Request Mask Clear
+	__vo uint32_t ENASET;									//	DMA Channel Enable Set
+	__vo uint32_t ENACLR;									//	DMA Channel Enable Clear
+	__vo uint32_t ALTSET;									//	DMA Channel Primary Alternate Set
+	__vo uint32_t ALTCLR;									//	DMA Channel Primary Alternate Clear
+	__vo uint32_t PRIOSET;								//	DMA Channel Priority Set
+	__vo uint32_t PRIOCLR;								//	DMA Channel Priority Clear
+	__vo uint32_t	RESERVED8_1[3];
+	__vo uint32_t ERRCLR;									//	DMA Bus Error Clear
+	__vo uint32_t	RESERVED8_2[300];
+	__vo uint32_t CHASGN;									//	DMA Channel Assignment
+	__vo uint32_t CHIS;										//	DMA Channel Interrupt Status
+	__vo uint32_t	RESERVED8_3[2];
+	__vo uint32_t CHMAP[4];								//	DMA Channel Map Select 0 - 3
+	__vo uint32_t	RESERVED8_4[684];
+	
+	/* Registers Defined below are READ-ONLY */
+	__vo uint32_t PeriphID4;							//	Peripheral Identification 4
+	__vo uint32_t	RESERVED8_5[3];
+	__vo uint32_t PeriphID0;							//	Peripheral Identification 0
+	__vo uint32_t PeriphID1;							//	Peripheral Identification 1
+	__vo uint32_t PeriphID2;							//	Peripheral Identification 2
+	__vo uint32_t PeriphID3;							//	Peripheral Identification 3
+	
+	__vo uint32_t PCellID0;								//	Prime Cell Identification 0
+	__vo uint32_t PCellID1;								//	Prime Cell Identification 1
+	__vo uint32_t PCellID2;								//	Prime Cell Identification 2
+	__vo uint32_t PCellID3;								//	Prime Cell Identification 3
+	
+}DMA_Reg;
+
+
+//	8.4 Module Access Pointer
+#define pDMA						( (DMA_Reg*) PERIPH_ADDR(DMA_BASE_ADDR) )
 
 /******************************************************************************************************************
 *																					Miscellaneous macros and aliases																				*
@@ -891,11 +999,32 @@ typedef struct
 
 #define APB_BUS	0
 #define AHB_BUS	1
+#define SELECTED_BUS	2									//	The bus selected for the port with GPIO_SelectBus()
 
 #define SET_BIT(x) |= 1<<x
 #define CLR_BIT(X) &= ~ (1<<X)
 #define GET_BIT(reg,bit) ( ( reg & (1 << bit) )?1:0 )
 
+//	Count Trailing Zeros: position of the lowest set bit (x must not be 0). Compiles to RBIT + CLZ on Cortex-M4.
+#if defined(__CC_ARM)
+#define CTZ(x)	__clz( __rbit(x) )
+#else
+#define CTZ(x)	__builtin_ctz(x)
+#endif
+
+//	Interrupt lock: IRQ_LOCK(Saved) saves PRIMASK into Saved (uint32_t) and masks interrupts, IRQ_UNLOCK(Saved) puts
+//	PRIMASK back, so locks can be nested. The host model delivers interrupts only from SimDispatchInterrupts().
+#if defined(TM4C123XX_HOST_SIM)
+#define IRQ_LOCK(Saved)		( (Saved) = 0 )
+#define IRQ_UNLOCK(Saved)	( (void)(Saved) )
+#elif defined(__CC_ARM)
+#define IRQ_LOCK(Saved)		do{ register uint32_t IRQPriMask __asm("primask"); (Saved) = IRQPriMask; __disable_irq(); }while(0)
+#define IRQ_UNLOCK(Saved)	do{ register uint32_t IRQPriMask __asm("primask"); IRQPriMask = (Saved); }while(0)
+#else
+#define IRQ_LOCK(Saved)		__asm volatile( "mrs %0, primask\n\tcpsid i" : "=r"(Saved) : : "memory" )
+#define IRQ_UNLOCK(Saved)	__asm volatile( "msr primask, %0" : : "r"(Saved) : "memory" )
+#endif
+
 
 
 /******************************************************************************************************************
@@ -907,6 +1036,14 @@ typedef struct
 #include "TM4C123xxGPIO_DRIVER.h"
 #include "TM4C123xxSSI_DRIVER.h"
 #include "TM4C123xxI2C_DRIVER.h"
+#include "TM4C123xxDMA_DRIVER.h"
 #include "TM4C123xxUART_DRIVER.h"
+#include "TM4C123xxTIMER_DRIVER.h"
+#include "TM4C123xxLOG.h"
+#include "TM4C123xxMODBUS.h"
+
+#ifdef TM4C123XX_HOST_SIM
+#include "TM4C123xxSIM.h"
+#endif
 
 #endif
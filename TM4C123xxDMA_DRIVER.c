@@ -0,0 +1,350 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxDMA_DRIVER.c																																								*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains the definitions of uDMA Driver APIs.																													*
+*																																																									*
+* @Note			-	All of the code present in the this file applies to TM4C123GH6PM microcontroller.										*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#include "TM4C123xxDMA_DRIVER.h"
+
+
+// @DMAControlTable - Control structures of all channels. See TM4C123xxDMA_DRIVER.h
+DMAControl DMAControlTable[64] __attribute__((aligned(1024)));
+
+
+
+/*****************************************************************************************************************
+*	@DMAClockControl()																																															*
+* @brief			-	This function is used to enable or disable clock for the uDMA controller.													*
+*	@ENorDI			- This variable speifies whether we have to enable or disable the clock.														*
+*								Use (I) ENABLE or (II) DISABLE macros for this variable.																					*
+******************************************************************************************************************/
+void DMAClockControl(uint8_t ENorDI)
+{
+	if(ENorDI == ENABLE)
+		DMA_PCLK_EN();
+	else
+		DMA_PCLK_DIS();
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAInit()																																																			*
+*	@brief			-	This function enables the uDMA controller and points it to DMAControlTable. The channels are not	*
+*								enabled.																																													*
+*																																																									*
+*	@Note				-	See Pg No. 600 (Section 9.3) for detailed steps on uDMA initialization.														*
+******************************************************************************************************************/
+void DMAInit(void)
+{
+	DMAClockControl(ENABLE);
+
+	pDMA->CFG = 1<<DMA_CFG_MASTEN;
+	pDMA->CTLBASE = BUS_ADDR(DMAControlTable);
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMADeInit()																																																		*
+*	@brief			-	This function resets the uDMA controller and turns off its clock.																	*
+******************************************************************************************************************/
+void DMADeInit(void)
+{
+	SYSCTL->SRDMA	SET_BIT(0);
+	SYSCTL->SRDMA	CLR_BIT(0);
+	DMAClockControl(DISABLE);
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAAssignChannel()																																															*
+*	@brief			-	This function selects the peripheral which requests a channel.																		*
+*	@Channel		-	Channel number (0 - 31).																																					*
+*	@Encoding		-	Channel encoding (0 - 4). See Table 9-1 on Pg No. 587 for the peripheral of each encoding.				*
+******************************************************************************************************************/
+void DMAAssignChannel(uint8_t Channel, uint8_t Encoding)
+{
+	uint8_t Shift = (Channel % 8) * 4;
+
+	if(Channel >= DMA_CHANNELS)
+		return;
+
+	pDMA->CHMAP[Channel / 8] = ( pDMA->CHMAP[Channel / 8] & ~(0xFUL << Shift) ) | ( (uint32_t)(Encoding & 0xF) << Shift );
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAChannelConfig()																																															*
+*	@brief			-	This function sets the request type and priority of a channel, and unmasks its requests. The channel	*
+*								will start with its primary control structure.																										*
+*	@Channel		-	Channel number (0 - 31).																																					*
+*	@UseBurst		-	1 => the channel responds to burst requests only. 0 => single and burst requests.									*
+*	@HighPriority	-	1 => high priority channel.																																			*
+******************************************************************************************************************/
+void DMAChannelConfig(uint8_t Channel, uint8_t UseBurst, uint8_t HighPriority)
+{
+	if(Channel >= DMA_CHANNELS)
+		return;
+
+	if(UseBurst)		pDMA->USEBURSTSET = 1UL<<Channel;
+	else						pDMA->USEBURSTCLR = 1UL<<Channel;
+
+	if(HighPriority)	pDMA->PRIOSET = 1UL<<Channel;
+	else							pDMA->PRIOCLR = 1UL<<Channel;
+
+	pDMA->ALTCLR = 1UL<<Channel;
+	pDMA->REQMASKCLR = 1UL<<Channel;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAControlWord()																																																*
+*	@brief			-	This function builds the control word of a transfer.																							*
+*	@Mode				-	Transfer mode. Use @DMAMode macros.																																*
+*	@DataSize		-	Size of one item. Use @DMADataSize macros. Source and destination use the same size.							*
+*	@SrcInc			-	Source address increment. Use @DMAIncrement macros.																								*
+*	@DstInc			-	Destination address increment. Use @DMAIncrement macros.																					*
+*	@ArbSize		-	Items moved per request/arbitration. Use @DMAArbSize macros.																			*
+*	@Count			-	No of items (1 - DMA_MAX_TRANSFER).																																*
+* @return			-	Control word. 0 (DMA_Mode_Stop) for an invalid count.																							*
+******************************************************************************************************************/
+uint32_t DMAControlWord(uint8_t Mode, uint8_t DataSize, uint8_t SrcInc, uint8_t DstInc, uint8_t ArbSize, uint32_t Count)
+{
+	if(Count == 0 || Count > DMA_MAX_TRANSFER)
+		return 0;
+
+	return	( (uint32_t)(DstInc & 3)		<< DMA_CHCTL_DSTINC )		|
+					( (uint32_t)(DataSize & 3)	<< DMA_CHCTL_DSTSIZE )	|
+					( (uint32_t)(SrcInc & 3)		<< DMA_CHCTL_SRCINC )		|
+					( (uint32_t)(DataSize & 3)	<< DMA_CHCTL_SRCSIZE )	|
+					( (uint32_t)(ArbSize & 0xF)	<< DMA_CHCTL_ARBSIZE )	|
+					( (Count - 1)								<< DMA_CHCTL_XFERSIZE )	|
+					( Mode & 7 );
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAFillEntry()																																																	*
+*	@brief			-	This function fills a control structure, or a task of a scatter-gather list, for a transfer.			*
+*	@pEntry			-	Control structure to fill.																																				*
+*	@Control		-	Control word (see DMAControlWord()).																															*
+*	@Src				-	Address of the first source item (a data register for a peripheral).															*
+*	@Dst				-	Address of the first destination item (a data register for a peripheral).													*
+*																																																									*
+*	@Note				-	The controller takes the address of the last item. An address which does not increment (a data		*
+*								register) is used as it is.																																				*
+******************************************************************************************************************/
+void DMAFillEntry(DMAControl* pEntry, uint32_t Control, const __vo void* Src, __vo void* Dst)
+{
+	uint32_t Last = (Control >> DMA_CHCTL_XFERSIZE) & 0x3FF;
+	uint8_t SrcInc = (Control >> DMA_CHCTL_SRCINC) & 3;
+	uint8_t DstInc = (Control >> DMA_CHCTL_DSTINC) & 3;
+
+	pEntry->SrcEnd = BUS_ADDR(Src) + (SrcInc == DMA_Inc_None ? 0 : (Last << SrcInc));
+	pEntry->DstEnd = BUS_ADDR(Dst) + (DstInc == DMA_Inc_None ? 0 : (Last << DstInc));
+	pEntry->Control = Control;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMASetTransfer()																																																*
+*	@brief			-	This function fills the primary or alternate control structure of a channel.											*
+*	@Channel		-	Channel number (0 - 31).																																					*
+*	@Structure	-	DMA_PRIMARY or DMA_ALTERNATE.																																			*
+*	@Control		-	Control word (see DMAControlWord()).																															*
+*	@Src/@Dst		-	Address of the first source/destination item.																											*
+*																																																									*
+*	@Note				-	For a ping-pong transfer fill both structures with DMA_Mode_PingPong. When one half completes, refill	*
+*								it (DMAGetMode() returns DMA_Mode_Stop for it) while the controller runs the other one.						*
+******************************************************************************************************************/
+void DMASetTransfer(uint8_t Channel, uint8_t Structure, uint32_t Control, const __vo void* Src, __vo void* Dst)
+{
+	DMAControl* pEntry = DMAGetEntry(Channel, Structure);
+
+	if(pEntry == NULL)
+		return;
+
+	DMAFillEntry(pEntry, Control, Src, Dst);
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMASetScatterGather()																																													*
+*	@brief			-	This function sets up a channel to run a list of tasks. The primary structure of the channel copies	*
+*								each task into the alternate structure, which then runs it.																				*
+*	@Channel		-	Channel number (0 - 31).																																					*
+*	@Peripheral	-	0 => memory scatter-gather (runs to the end after one request).																		*
+*								1 => peripheral scatter-gather (each task moves data on the requests of the peripheral).					*
+*	@pTasks			-	List of tasks, filled with DMAFillEntry(). Every task except the last one must use								*
+*								DMA_Mode_MemSGAlt (or DMA_Mode_PeriphSGAlt). The last one normally uses DMA_Mode_Auto (or					*
+*								DMA_Mode_Basic).																																									*
+*	@TaskCount	-	No of tasks (1 - DMA_MAX_TASKS).																																	*
+******************************************************************************************************************/
+void DMASetScatterGather(uint8_t Channel, uint8_t Peripheral, DMAControl* pTasks, uint32_t TaskCount)
+{
+	DMAControl* pPrimary = DMAGetEntry(Channel, DMA_PRIMARY);
+	DMAControl* pAlternate = DMAGetEntry(Channel, DMA_ALTERNATE);
+
+	if(pPrimary == NULL || TaskCount == 0 || TaskCount > DMA_MAX_TASKS)
+		return;
+
+	// Each task is copied as 4 words into the last 4 words of the alternate structure
+	pPrimary->SrcEnd = BUS_ADDR(&pTasks[TaskCount - 1].Unused);
+	pPrimary->DstEnd = BUS_ADDR(&pAlternate->Unused);
+	pPrimary->Control = DMAControlWord( (Peripheral ? DMA_Mode_PeriphSG : DMA_Mode_MemSG), DMA_Size_32bit,
+																			DMA_Inc_32bit, DMA_Inc_32bit, DMA_Arb_4, TaskCount * 4 );
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAEnableChannel() / @DMADisableChannel()																																			*
+*	@brief			-	These functions arm/stop a channel. The controller disables a channel by itself when it completes.	*
+*	@Channel		-	Channel number (0 - 31).																																					*
+******************************************************************************************************************/
+void DMAEnableChannel(uint8_t Channel)
+{
+	if(Channel < DMA_CHANNELS)
+		pDMA->ENASET = 1UL<<Channel;
+}
+
+void DMADisableChannel(uint8_t Channel)
+{
+	if(Channel < DMA_CHANNELS)
+		pDMA->ENACLR = 1UL<<Channel;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMARequest()																																																		*
+*	@brief			-	This function requests a channel from software (memory-to-memory transfers).											*
+*	@Channel		-	Channel number (0 - 31).																																					*
+******************************************************************************************************************/
+void DMARequest(uint8_t Channel)
+{
+	if(Channel < DMA_CHANNELS)
+		pDMA->SWREQ = 1UL<<Channel;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAIsChannelEnabled()																																													*
+*	@Channel		-	Channel number (0 - 31).																																					*
+* @return			-	1 if the channel is armed, 0 if it has completed or was disabled.																	*
+******************************************************************************************************************/
+uint8_t DMAIsChannelEnabled(uint8_t Channel)
+{
+	if(Channel >= DMA_CHANNELS)
+		return 0;
+
+	return (pDMA->ENASET >> Channel) & 1;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAGetMode()																																																		*
+*	@Channel		-	Channel number (0 - 31).																																					*
+*	@Structure	-	DMA_PRIMARY or DMA_ALTERNATE.																																			*
+* @return			-	Transfer mode of the control structure. The controller sets it to DMA_Mode_Stop when it completes.	*
+******************************************************************************************************************/
+uint8_t DMAGetMode(uint8_t Channel, uint8_t Structure)
+{
+	DMAControl* pEntry = DMAGetEntry(Channel, Structure);
+
+	if(pEntry == NULL)
+		return DMA_Mode_Stop;
+
+	return pEntry->Control & 7;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAGetRemaining()																																															*
+*	@Channel		-	Channel number (0 - 31).																																					*
+*	@Structure	-	DMA_PRIMARY or DMA_ALTERNATE.																																			*
+* @return			-	No of items which the control structure has not transferred yet.																	*
+******************************************************************************************************************/
+uint32_t DMAGetRemaining(uint8_t Channel, uint8_t Structure)
+{
+	DMAControl* pEntry = DMAGetEntry(Channel, Structure);
+	uint32_t Control;
+
+	if(pEntry == NULL)
+		return 0;
+
+	Control = pEntry->Control;
+	if( (Control & 7) == DMA_Mode_Stop )
+		return 0;
+
+	return ( (Control >> DMA_CHCTL_XFERSIZE) & 0x3FF ) + 1;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAGetIntStatus() / @DMAClearIntStatus()																																				*
+*	@brief			-	These functions read/clear the completion status (DMACHIS) of the channels. A set bit means that	*
+*								the channel has completed.																																				*
+*	@Channels		-	Bit mask of the channels to clear.																																*
+*																																																									*
+*	@Note				-	The completion interrupt of a peripheral channel is the interrupt of that peripheral. Clear the bit	*
+*								of the channel in its interrupt handler.																													*
+******************************************************************************************************************/
+uint32_t DMAGetIntStatus(void)
+{
+	return pDMA->CHIS;
+}
+
+void DMAClearIntStatus(uint32_t Channels)
+{
+	pDMA->CHIS = Channels;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAGetError() / @DMAClearError()																																								*
+*	@brief			-	These functions read/clear the bus error flag of the controller. A channel which hits a bus error is	*
+*								disabled by the controller.																																				*
+******************************************************************************************************************/
+uint8_t DMAGetError(void)
+{
+	return GET_BIT(pDMA->ERRCLR, DMA_ERRCLR_ERRCLR);
+}
+
+void DMAClearError(void)
+{
+	pDMA->ERRCLR = 1<<DMA_ERRCLR_ERRCLR;
+}
+
+
+
+/*****************************************************************************************************************
+*	@DMAGetEntry()																																																	*
+*	@Channel		-	Channel number (0 - 31).																																					*
+*	@Structure	-	DMA_PRIMARY or DMA_ALTERNATE.																																			*
+* @return			-	Control structure of the channel. NULL for an invalid channel.																		*
+******************************************************************************************************************/
+DMAControl* DMAGetEntry(uint8_t Channel, uint8_t Structure)
+{
+	if(Channel >= DMA_CHANNELS)
+		return NULL;
+
+	return &DMAControlTable[ (Structure == DMA_ALTERNATE ? DMA_CHANNELS : 0) + Channel ];
+}
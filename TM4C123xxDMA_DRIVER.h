@@ -0,0 +1,174 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxDMA_DRIVER.h																																								*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains prototypes of uDMA Driver APIs. Bit position macros and shorthands which are used by the uDMA	*
+*	Driver APIs are also defined here.																																							*
+*																																																									*
+*	How the uDMA controller is used:-																																								*
+*	<>	Every channel has a primary and an alternate control structure (DMAControl) in a control table in SRAM. Each	*
+*			structure holds the source end pointer, the destination end pointer and the control word of one transfer.		*
+*	<>	DMAControlWord() builds a control word, DMASetTransfer() writes a control structure of a channel, and				*
+*			DMAEnableChannel() arms it. The channel then moves data on the requests of its peripheral, or on						*
+*			DMARequest() for a software channel.																																				*
+*	<>	When a channel completes, its bit is set in DMACHIS and the interrupt of the peripheral which owns the channel	*
+*			is pended (the uDMA software interrupt for software channels).																							*
+*																																																									*
+* @Note			-	All of the code present in the this file applies to TM4C123GH6PM microcontroller.										*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#ifndef TM4C123XXDMA_DRIVER_H
+#define TM4C123XXDMA_DRIVER_H
+
+#include "TM4C123xx.h"
+
+/*****************************************************************************************************************
+*																								Bit Position Macros																								*
+******************************************************************************************************************/
+// DMA Status / Configuration Registers
+#define DMA_STAT_MASTEN				0				//	Master Enable Status
+#define DMA_STAT_DMACHANS			16			//	Available uDMA Channels Minus 1 (5 bits)
+#define DMA_CFG_MASTEN				0				//	Controller Master Enable
+
+// DMA Bus Error Clear Register
+#define DMA_ERRCLR_ERRCLR			0				//	uDMA Bus Error Status
+
+// Channel Control Word
+#define DMA_CHCTL_XFERMODE		0				//	Transfer Mode (3 bits)
+#define DMA_CHCTL_NXTUSEBURST	3				//	Next Useburst
+#define DMA_CHCTL_XFERSIZE		4				//	Transfer Size minus 1 (10 bits)
+#define DMA_CHCTL_ARBSIZE			14			//	Arbitration Size (4 bits)
+#define DMA_CHCTL_SRCSIZE			24			//	Source Data Size (2 bits)
+#define DMA_CHCTL_SRCINC			26			//	Source Address Increment (2 bits)
+#define DMA_CHCTL_DSTSIZE			28			//	Destination Data Size (2 bits)
+#define DMA_CHCTL_DSTINC			30			//	Destination Address Increment (2 bits)
+
+
+
+/*****************************************************************************************************************
+*															Miscellaneous macros, shorthands and Global variables																*
+******************************************************************************************************************/
+
+/*****************************************************************************************************************
+	@DMAControl
+	Control structure of one channel (or one task of a scatter-gather list). The layout is fixed by the hardware.
+******************************************************************************************************************/
+typedef struct
+{
+	__vo uint32_t SrcEnd;									//	Source End Pointer (address of the last item)
+	__vo uint32_t DstEnd;									//	Destination End Pointer (address of the last item)
+	__vo uint32_t Control;								//	Control Word
+	__vo uint32_t Unused;
+}DMAControl;
+
+
+/*****************************************************************************************************************
+	@DMAControlTable
+	Primary (entries 0 - 31) and alternate (entries 32 - 63) control structures of all channels. It must be aligned
+	on a 1024-byte boundary.
+******************************************************************************************************************/
+extern DMAControl DMAControlTable[64];
+
+#define DMA_CHANNELS					32
+#define DMA_MAX_TRANSFER			1024						//	Items per control structure
+#define DMA_MAX_TASKS					256							//	Tasks per scatter-gather list
+
+// @DMAStructure
+#define DMA_PRIMARY						0
+#define DMA_ALTERNATE					1
+
+// @DMAMode
+#define DMA_Mode_Stop					0
+#define DMA_Mode_Basic				1
+#define DMA_Mode_Auto					2
+#define DMA_Mode_PingPong			3
+#define DMA_Mode_MemSG				4								//	Memory scatter-gather (primary structure)
+#define DMA_Mode_MemSGAlt			5								//	Memory scatter-gather task (alternate structure)
+#define DMA_Mode_PeriphSG			6								//	Peripheral scatter-gather (primary structure)
+#define DMA_Mode_PeriphSGAlt	7								//	Peripheral scatter-gather task (alternate structure)
+
+// @DMADataSize
+#define DMA_Size_8bit					0
+#define DMA_Size_16bit				1
+#define DMA_Size_32bit				2
+
+// @DMAIncrement
+#define DMA_Inc_8bit					0
+#define DMA_Inc_16bit					1
+#define DMA_Inc_32bit					2
+#define DMA_Inc_None					3
+
+// @DMAArbSize - No of items transferred before the controller arbitrates again (2^n).
+#define DMA_Arb_1							0
+#define DMA_Arb_2							1
+#define DMA_Arb_4							2
+#define DMA_Arb_8							3
+#define DMA_Arb_16						4
+#define DMA_Arb_32						5
+#define DMA_Arb_64						6
+#define DMA_Arb_128						7
+#define DMA_Arb_256						8
+#define DMA_Arb_512						9
+#define DMA_Arb_1024					10
+
+// Interrupt numbers of the uDMA controller
+#define DMA_IRQ_SOFTWARE			46							//	Completion of software channels
+#define DMA_IRQ_ERROR					47							//	Bus error
+
+
+
+/*****************************************************************************************************************
+*																					APIs Supported by this Driver																						*
+*	Below are the prototypes for driver APIs																																				*
+*																																																									*
+*	1.	DMAClockControl()				-	Enable/Disable clock for the uDMA controller.																			*
+*	2.	DMAInit()								-	Enable the controller and point it to DMAControlTable.														*
+*	3.	DMADeInit()							-	Reset and turn off the controller.																								*
+*	4.	DMAAssignChannel()			-	Select the peripheral (encoding) which requests a channel.												*
+*	5.	DMAChannelConfig()			-	Select burst-only requests and high priority for a channel.												*
+*	6.	DMAControlWord()				-	Build a control word.																															*
+*	7.	DMAFillEntry()					-	Fill a control structure (or a scatter-gather task) from a control word and buffers.	*
+*	8.	DMASetTransfer()				-	Fill the primary or alternate control structure of a channel.											*
+*	9.	DMASetScatterGather()		-	Set up a channel to run a list of tasks.																					*
+*	10.	DMAEnableChannel()			-	Arm a channel.																																		*
+*	11.	DMADisableChannel()			-	Stop a channel.																																		*
+*	12.	DMARequest()						-	Request a channel from software.																									*
+*	13.	DMAIsChannelEnabled()		-	Check if a channel is still armed.																								*
+*	14.	DMAGetMode()						-	Mode of a control structure (DMA_Mode_Stop when it has completed).								*
+*	15.	DMAGetRemaining()				-	No of items a control structure has not transferred yet.													*
+*	16.	DMAGetIntStatus()				-	Channels which have completed (DMACHIS).																					*
+*	17.	DMAClearIntStatus()			-	Clear completed channels.																													*
+*	18.	DMAGetError()						-	Check for a bus error.																														*
+*	19.	DMAClearError()					-	Clear a bus error.																																*
+*	20.	DMAGetEntry()						-	Get the primary or alternate control structure of a channel.											*
+******************************************************************************************************************/
+void DMAClockControl(uint8_t ENorDI);
+void DMAInit(void);
+void DMADeInit(void);
+
+void DMAAssignChannel(uint8_t Channel, uint8_t Encoding);
+void DMAChannelConfig(uint8_t Channel, uint8_t UseBurst, uint8_t HighPriority);
+
+uint32_t DMAControlWord(uint8_t Mode, uint8_t DataSize, uint8_t SrcInc, uint8_t DstInc, uint8_t ArbSize, uint32_t Count);
+void DMAFillEntry(DMAControl* pEntry, uint32_t Control, const __vo void* Src, __vo void* Dst);
+void DMASetTransfer(uint8_t Channel, uint8_t Structure, uint32_t Control, const __vo void* Src, __vo void* Dst);
+void DMASetScatterGather(uint8_t Channel, uint8_t Peripheral, DMAControl* pTasks, uint32_t TaskCount);
+
+void DMAEnableChannel(uint8_t Channel);
+void DMADisableChannel(uint8_t Channel);
+void DMARequest(uint8_t Channel);
+uint8_t DMAIsChannelEnabled(uint8_t Channel);
+
+uint8_t DMAGetMode(uint8_t Channel, uint8_t Structure);
+uint32_t DMAGetRemaining(uint8_t Channel, uint8_t Structure);
+
+uint32_t DMAGetIntStatus(void);
+void DMAClearIntStatus(uint32_t Channels);
+uint8_t DMAGetError(void);
+void DMAClearError(void);
+
+DMAControl* DMAGetEntry(uint8_t Channel, uint8_t Structure);
+
+#endif
@@ -14,6 +14,80 @@
 #include "TM4C123xxGPIO_DRIVER.h"
 
 
+// GLOBAL VARIABLES
+
+// @GPIOBusSelect - Bus (APB/AHB) through which each GPIO port is accessed. Changed by GPIO_SelectBus().
+uint8_t GPIOBusSelect = 0b00000000;
+
+// @GPIOPinHandlers - Interrupt handlers of the pins, registered by interruptpin(). Index = port*8 + pin number.
+void (*GPIOPinHandlers[48])(void);
+
+// @GPIOEdgeOverflows - No of captured edges dropped because the edge buffer was full.
+uint32_t GPIOEdgeOverflows = 0;
+
+// Edge capture state. The head is written only by GPIOPortIT_H(), the tail only by GPIO_ReadEdges(). The handlers of
+// all ports write the head, so GPIOPortIT_H() masks the interrupts while it adds edges. GPIOCaptureRising and
+// GPIOCaptureBoth hold the pins captured on RisingEdge and on BothEdges, for the level recorded with the edge.
+static Timer_Reg* pCaptureTimer = NULL;
+static uint8_t GPIOCaptureMask[6];
+static uint8_t GPIOCaptureRising[6];
+static uint8_t GPIOCaptureBoth[6];
+static __vo GPIOEdge GPIOEdgeBuffer[GPIO_EDGE_BUFFER_SIZE];
+static __vo uint32_t GPIOEdgeHead = 0;
+static __vo uint32_t GPIOEdgeTail = 0;
+
+// @DebounceOverflows - No of press/release events dropped because the event buffer was full.
+uint32_t DebounceOverflows = 0;
+
+// Debouncer state. Each port has a bit-parallel (vertical) 2-bit counter for its 8 pins: bit n of Cnt0 and Cnt1 is
+// the counter of pin n. The head of the event ring is written only by DebounceIT_H(), the tail only by
+// GPIO_ReadButtonEvents().
+typedef struct
+{
+	uint8_t Mask;												//	Pins of the port which are debounced
+	uint8_t ActiveLow;									//	Pins which read 0 when pressed (pulled-up inputs)
+	uint8_t State;											//	Debounced levels
+	uint8_t Cnt0;
+	uint8_t Cnt1;
+}DebouncePort;
+
+static uint8_t DebounceTimer = 0;
+static uint8_t DebouncePorts = 0;					//	Bit n set => port n has debounced pins
+static __vo DebouncePort DebounceState[6];
+static __vo DebounceEvent DebounceEventBuffer[DEBOUNCE_EVENT_BUFFER_SIZE];
+static __vo uint32_t DebounceEventHead = 0;
+static __vo uint32_t DebounceEventTail = 0;
+
+// Software PWM state. The schedule is double buffered: SoftPWMUpdate() builds the buffer which is not active, and
+// SoftPWMIT_H() switches to it at the end of a period.
+typedef struct
+{
+	uint32_t	Interval;									//	System clock cycles until the next step
+	uint8_t		Ports;										//	Bit n set => the step writes port n
+	uint8_t		Mask[6];
+	uint8_t		Value[6];
+}SoftPWMStep;
+
+typedef struct
+{
+	uint8_t		Timer;
+	uint8_t		Running;
+	uint32_t	Period;
+	uint8_t		NoOfChannels;
+	uint8_t		pin[SOFT_PWM_CHANNELS];
+	uint32_t	Duty[SOFT_PWM_CHANNELS];
+	GPIO_reg*	pPort[6];
+	
+	SoftPWMStep	Schedule[2][SOFT_PWM_CHANNELS + 1];
+	uint8_t		NoOfSteps[2];
+	uint8_t		Active;										//	Schedule used by SoftPWMIT_H()
+	uint8_t		Pending;									//	1 => the other schedule is used from the next period on
+	uint8_t		StepIndex;								//	Step which is applied on the next time-out
+}SoftPWMState;
+
+static __vo SoftPWMState SoftPWM;
+
+
 
 /******************************************************************************************************************
 *																					User Switches and Onboard LEDs																					*
@@ -65,6 +139,24 @@
 *	9. 	ToggleGPIOPin()				-		Toggle the state of a GPIO pin																										*
 *	10. ReadFromPin()					-		Read data from a GPIO pin																													*
 *	11. ReadFromPort()				-		Read data from a GPIO port																												*
+*	12. WriteToPortMasked()		-		Write digital values to selected pins of a GPIO port with a single store					*
+*	13. GPIO_SelectBus()			-		Select the bus (APB/AHB) through which a GPIO port is accessed										*
+*	14. GPIO_InitPort()				-		Initialize a group of pins of a GPIO port with the same configuration							*
+*	15. interruptpin()				-		Initialize an interrupt pin and register a handler for it													*
+*	16. GPIOPortIT_H()				-		Helper for GPIO Interrupt Handler function. Dispatches to the handlers of the pins *
+*	17. GPIO_EdgeCaptureInit()	-		Start the free-running timer which timestamps captured edges										*
+*	18. EdgeCapturePin()			-		Initialize an interrupt pin whose edges are timestamped and recorded							*
+*	19. GPIO_ReadEdges()			-		Read the recorded edges																														*
+*	20. GPIO_DebounceInit()		-		Start the periodic timer which samples the debounced pins													*
+*	21. DebouncePin()					-		Initialize an input pin which is debounced																				*
+*	22. DebounceIT_H()				-		Helper for the Interrupt Handler function of the debounce timer										*
+*	23. GPIO_ReadButtonEvents()	-		Read the press/release events of the debounced pins															*
+*	24. ReadDebouncedPin()		-		Read the debounced state (pressed/released) of a pin															*
+*	25. SoftPWMInit()					-		Set up the timer which runs the software PWM																			*
+*	26. SoftPWMPin()					-		Initialize a pin as a software PWM output, or change its duty											*
+*	27. SoftPWMUpdate()				-		Apply the duties set with SoftPWMPin() from the next period on										*
+*	28. SoftPWMIT_H()					-		Helper for the Interrupt Handler function of the software PWM timer								*
+*	29. SoftPWMStop()					-		Stop the software PWM and drive all its pins low																	*
 ******************************************************************************************************************/
 
 
@@ -135,31 +227,53 @@ void	GPIO_ClockControl(uint8_t GPIOPort, uint8_t ClkEn)
 ******************************************************************************************************************/
 void	GPIO_Init(uint8_t pin, uint8_t ioMode, uint8_t pinMode, uint8_t DriveStrength, uint8_t Trigger)
 {
-	GPIO_reg* pGPIO =		getPortAddr(pin,APB_BUS);		//	Pointer to the GPIO port.
-	uint8_t GPIO_Port = getPortName(pin);						//	Name of the GPIO port.
-	uint8_t PinNumber = getPinNumber(pin);					//	Pin number which needs to be initialized.
+	GPIO_InitPort( getPortName(pin), 1<<getPinNumber(pin), ioMode, pinMode, DriveStrength, Trigger );
+}
+
+
+
+/*****************************************************************************************************************
+*	@GPIO_InitPort																																																	*
+*	@brief					- This function is used to Initialize/Configure a group of pins of a GPIO port.									*
+*	@GPIOPort				-	GPIO Port.																																										*
+*	@PinMask				-	Pins which are to be configured (bit n => pin n).																							*
+*	@ioMode					-	Direction (In/Out), and Pin Type (Pull Up, Pull Down, Open Drain).														*
+*	@pinMode				-	Pin Mode ( Analog / Digital ).																																*
+*	@DriveStrength	- Drive Strength ( 2mA, 4mA, 8mA ).																															*
+* @Trigger				-	Interrupt Trigger Mode ( Rising/Falling/Both Edge trigger or High/Low Level trigger ).				*
+* @return					-	Nothing (void).																																								*
+*																																																									*
+*	@Note						-	All the pins in PinMask get the same configuration. The clock is enabled once, and every			*
+*										register is updated once for the whole group, so configuring n pins costs the same number			*
+*										of register accesses as configuring a single pin. See GPIO_Init() for the steps.							*
+******************************************************************************************************************/
+void	GPIO_InitPort(uint8_t GPIOPort, uint8_t PinMask, uint8_t ioMode, uint8_t pinMode, uint8_t DriveStrength, uint8_t Trigger)
+{
+	GPIO_reg* pGPIO =		getPortAddr(GPIOPort,SELECTED_BUS);		//	Pointer to the GPIO port.
+	
+	if(GPIOPort > GPIO_PORT_F || PinMask == 0)		return;
 	
 	//	Step1:	Enable Clock.
-	GPIO_ClockControl(GPIO_Port, ENABLE);
+	GPIO_ClockControl(GPIOPort, ENABLE);
 	
 	//	Step2,5:	Set pin direction, and mode by setting/clearing appropriate bits in the GPIODIR and GPIO(PUR/PDR/ODR) registers.
 	switch(ioMode)
 	{
-		case OutputOpenDrain:			pGPIO->GPIO_ODR	SET_BIT( PinNumber );
-															pGPIO->GPIO_DIR SET_BIT( PinNumber );
+		case OutputOpenDrain:			pGPIO->GPIO_ODR |= PinMask;
+															pGPIO->GPIO_DIR |= PinMask;
 															break;
-		case Output:							pGPIO->GPIO_ODR	CLR_BIT( PinNumber );
-															pGPIO->GPIO_DIR SET_BIT( PinNumber );
+		case Output:							pGPIO->GPIO_ODR &= ~PinMask;
+															pGPIO->GPIO_DIR |= PinMask;
 															break; 
-		case InputPullUp:					pGPIO->GPIO_PUR	SET_BIT( PinNumber );
-															pGPIO->GPIO_DIR CLR_BIT(PinNumber);
+		case InputPullUp:					pGPIO->GPIO_PUR |= PinMask;
+															pGPIO->GPIO_DIR &= ~PinMask;
 															break;
-		case InputPullDown:				pGPIO->GPIO_PDR	SET_BIT( PinNumber );
-															pGPIO->GPIO_DIR CLR_BIT(PinNumber);
+		case InputPullDown:				pGPIO->GPIO_PDR |= PinMask;
+															pGPIO->GPIO_DIR &= ~PinMask;
 															break;
-		case Input:								pGPIO->GPIO_PUR	CLR_BIT( PinNumber );
-															pGPIO->GPIO_PDR	CLR_BIT( PinNumber );
-															pGPIO->GPIO_DIR CLR_BIT(PinNumber);
+		case Input:								pGPIO->GPIO_PUR &= ~PinMask;
+															pGPIO->GPIO_PDR &= ~PinMask;
+															pGPIO->GPIO_DIR &= ~PinMask;
 															break;
 	}
 	
@@ -177,9 +291,9 @@ void	GPIO_Init(uint8_t pin, uint8_t ioMode, uint8_t pinMode, uint8_t DriveStreng
 	****************************************************************************************************************/
 	switch(DriveStrength)
 	{
-		case Two_mA		:		pGPIO->GPIO_DR2R SET_BIT( PinNumber );		break;
-		case Four_mA	:		pGPIO->GPIO_DR4R SET_BIT( PinNumber );		break;
-		case Eight_mA	:		pGPIO->GPIO_DR8R SET_BIT( PinNumber );		break;
+		case Two_mA		:		pGPIO->GPIO_DR2R |= PinMask;		break;
+		case Four_mA	:		pGPIO->GPIO_DR4R |= PinMask;		break;
+		case Eight_mA	:		pGPIO->GPIO_DR8R |= PinMask;		break;
 	}
 
 	
@@ -189,8 +303,8 @@ void	GPIO_Init(uint8_t pin, uint8_t ioMode, uint8_t pinMode, uint8_t DriveStreng
 	****************************************************************************************************************/
 	switch(pinMode)
 	{
-		case Digital:			pGPIO->GPIO_DEN		SET_BIT( PinNumber );		break;
-		case Analog	:			pGPIO->GPIO_AMSEL	SET_BIT( PinNumber );		break;
+		case Digital:			pGPIO->GPIO_DEN |= PinMask;		break;
+		case Analog	:			pGPIO->GPIO_AMSEL |= PinMask;		break;
 	}
 	
 	/****************************************************************************************************************
@@ -230,40 +344,40 @@ void	GPIO_Init(uint8_t pin, uint8_t ioMode, uint8_t pinMode, uint8_t DriveStreng
 	else
 	{
 		uint8_t clearICR = 0;											// Flag to clear ICR register for Edge-triggered interrupts.
-		pGPIO->GPIO_IM CLR_BIT( PinNumber );			// Mask the interrupt so that it doesn't cause any unwanted event while configuring the interrupt registers.
+		pGPIO->GPIO_IM &= ~PinMask;			// Mask the interrupt so that it doesn't cause any unwanted event while configuring the interrupt registers.
 		switch(Trigger)
 		{
-			case RisingEdge:	pGPIO->GPIO_IS		CLR_BIT( PinNumber );
-												pGPIO->GPIO_IBE 	CLR_BIT( PinNumber );
-												pGPIO->GPIO_IEV 	SET_BIT( PinNumber );
+			case RisingEdge:	pGPIO->GPIO_IS &= ~PinMask;
+												pGPIO->GPIO_IBE &= ~PinMask;
+												pGPIO->GPIO_IEV |= PinMask;
 												clearICR = 1;
 												break;
 			
-			case FallingEdge:	pGPIO->GPIO_IS		CLR_BIT( PinNumber );
-												pGPIO->GPIO_IBE 	CLR_BIT( PinNumber );
-												pGPIO->GPIO_IEV 	CLR_BIT( PinNumber );
+			case FallingEdge:	pGPIO->GPIO_IS &= ~PinMask;
+												pGPIO->GPIO_IBE &= ~PinMask;
+												pGPIO->GPIO_IEV &= ~PinMask;
 												clearICR = 1;
 												break;
 			
-			case BothEdges:		pGPIO->GPIO_IS		CLR_BIT( PinNumber );
-												pGPIO->GPIO_IBE 	SET_BIT( PinNumber );
+			case BothEdges:		pGPIO->GPIO_IS &= ~PinMask;
+												pGPIO->GPIO_IBE |= PinMask;
 												clearICR = 1;
 												break;
 												
-			case HighLevel:		pGPIO->GPIO_IS		SET_BIT( PinNumber );
-												pGPIO->GPIO_IBE		CLR_BIT( PinNumber );
-												pGPIO->GPIO_IEV		SET_BIT( PinNumber );
+			case HighLevel:		pGPIO->GPIO_IS |= PinMask;
+												pGPIO->GPIO_IBE &= ~PinMask;
+												pGPIO->GPIO_IEV |= PinMask;
 												break;
 			
-			case LowLevel:		pGPIO->GPIO_IS		SET_BIT( PinNumber );
-												pGPIO->GPIO_IBE 	CLR_BIT( PinNumber );
-												pGPIO->GPIO_IEV 	CLR_BIT( PinNumber );
+			case LowLevel:		pGPIO->GPIO_IS |= PinMask;
+												pGPIO->GPIO_IBE &= ~PinMask;
+												pGPIO->GPIO_IEV &= ~PinMask;
 												break;
 		}
 		if(clearICR)
-			pGPIO->GPIO_ICR SET_BIT( PinNumber );		//	Clear ICR register for Edge-triggered interrupts.
+			pGPIO->GPIO_ICR = PinMask;		//	Clear ICR register for Edge-triggered interrupts (Write 1 to Clear).
 		
-		pGPIO->GPIO_IM SET_BIT( PinNumber );			//	Disable the interrupt mask to re-enable the interrupts.
+		pGPIO->GPIO_IM |= PinMask;			//	Disable the interrupt mask to re-enable the interrupts.
 	}
 }
 
@@ -285,6 +399,35 @@ void	GPIO_DeInit(uint8_t GPIOPort)
 	
 	GPIO_ClockControl(GPIOPort,DISABLE);				// Disable the clock.
 }
+
+
+
+/*****************************************************************************************************************
+*	@GPIO_SelectBus()																																																*
+*	@brief				-	This function selects the bus through which a GPIO port is accessed															*
+* @GPIO_PORT		-	This is the name of the GPIO Port.																															*
+*	@Bus					-	APB_BUS or AHB_BUS.																																							*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The port is moved to the selected aperture by setting/clearing its bit in the GPIOHBCTL register. *
+*									Only one aperture of a port can be used at a time, so all driver APIs use the aperture recorded	*
+*									in GPIOBusSelect. AHB has a lower access latency than APB.																			*
+******************************************************************************************************************/
+void	GPIO_SelectBus(uint8_t GPIOPort, uint8_t Bus)
+{
+	if(GPIOPort > GPIO_PORT_F)		return;
+	
+	if(Bus == AHB_BUS)
+	{
+		SYSCTL->GPIOHBCTL	SET_BIT( GPIOPort );
+		GPIOBusSelect			SET_BIT( GPIOPort );
+	}
+	else if(Bus == APB_BUS)
+	{
+		SYSCTL->GPIOHBCTL	CLR_BIT( GPIOPort );
+		GPIOBusSelect			CLR_BIT( GPIOPort );
+	}
+}
 	
 	
 
@@ -296,7 +439,7 @@ void	GPIO_DeInit(uint8_t GPIOPort)
 ******************************************************************************************************************/
 uint8_t	ReadFromPin(uint8_t pin)
 {
-	GPIO_reg* pGPIOx = getPortAddr(pin, APB_BUS);
+	GPIO_reg* pGPIOx = getPortAddr(pin, SELECTED_BUS);
 	return GET_BIT( pGPIOx->GPIO_DATA, getPinNumber(pin) );
 //	The above statement is equivalent to return ( pGPIO->GPIO_DATA & (1<<PinNumber) )
 }
@@ -311,7 +454,7 @@ uint8_t	ReadFromPin(uint8_t pin)
 ******************************************************************************************************************/
 uint8_t	ReadFromPort(uint8_t GPIOPort)
 {
-	GPIO_reg* pGPIO = getPortAddr(GPIOPort, APB_BUS);
+	GPIO_reg* pGPIO = getPortAddr(GPIOPort, SELECTED_BUS);
 	return (uint8_t)( pGPIO->GPIO_DATA );
 }
 	
@@ -326,13 +469,13 @@ uint8_t	ReadFromPort(uint8_t GPIOPort)
 ******************************************************************************************************************/
 void WriteToPin(uint8_t pin, uint8_t Value)
 {
-	GPIO_reg* pGPIO = getPortAddr(pin, APB_BUS);
-	if(Value == PIN_SET)					pGPIO->GPIO_DATA SET_BIT( getPinNumber(pin) );
-	else if(Value == PIN_RESET)		pGPIO->GPIO_DATA CLR_BIT( getPinNumber(pin) );
+	GPIO_reg* pGPIO = getPortAddr(pin, SELECTED_BUS);
+	uint8_t PinMask = 1<<getPinNumber(pin);
 	
-	//	The above statement is equivalent to the following:-
-	//	if(Value == PIN_SET)					pGPIO->GPIO_DATA |=	(1<<PinNumber);
-	//	else if(Value == PIN_RESET)		pGPIO->GPIO_DATA &= ~(1<<PinNumber);
+	//	Only the addressed pin is affected by this store, so there is no read-modify-write which could overwrite
+	//	changes made to other pins of the port by an ISR.
+	if(Value == PIN_SET)					pGPIO->GPIO_DATA_A[PinMask] = 0xFF;
+	else if(Value == PIN_RESET)		pGPIO->GPIO_DATA_A[PinMask] = 0x00;
 }
 	
 
@@ -346,12 +489,31 @@ void WriteToPin(uint8_t pin, uint8_t Value)
 ******************************************************************************************************************/
 void WriteToPort(uint8_t GPIO_PORT, uint8_t Values)
 {
-	GPIO_reg* pGPIO = getPortAddr(GPIO_PORT, APB_BUS);
+	GPIO_reg* pGPIO = getPortAddr(GPIO_PORT, SELECTED_BUS);
 	pGPIO->GPIO_DATA = Values;
 }
 	
 	
 
+/*****************************************************************************************************************
+*	@WriteToPortMasked()																																														*
+*	@brief				-	This function writes the given data to selected pins of a GPIO port															*
+* @GPIO_PORT		-	This is the GPIO Port to which we have to write the data.																				*
+*	@Mask					-	Pins which are to be written (bit n => pin n). Other pins of the port are not affected.					*
+*	@Values				-	Values which are to be written to the selected pins.																						*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+* @Note					-	The write is a single store to the address-masked data window (no read-modify-write), so				*
+*									it is safe to use from main code and ISRs on the same port without masking interrupts.					*
+******************************************************************************************************************/
+void WriteToPortMasked(uint8_t GPIO_PORT, uint8_t Mask, uint8_t Values)
+{
+	GPIO_reg* pGPIO = getPortAddr(GPIO_PORT, SELECTED_BUS);
+	pGPIO->GPIO_DATA_A[Mask] = Values;
+}
+	
+	
+
 /******************************************************************************************************************
 *	@ToggleGPIOPin()																																																*
 *	@brief				-	This function toggles the state of a GPIO pin																										*
@@ -360,9 +522,12 @@ void WriteToPort(uint8_t GPIO_PORT, uint8_t Values)
 ******************************************************************************************************************/
 void ToggleGPIOPin(uint8_t pin)
 {
-	getPortAddr(pin,APB_BUS)->GPIO_DATA ^= (1<<getPinNumber(pin));
-	//	The above statement is equivalent to pGPIOx->GPIO_DATA ^= (1<<PinNumber)
+	GPIO_reg* pGPIO = getPortAddr(pin, SELECTED_BUS);
+	uint8_t PinMask = 1<<getPinNumber(pin);
+	
+	//	Read and write only the addressed pin. Other pins of the port are neither read nor written.
 	//	Remember x^1 = x'
+	pGPIO->GPIO_DATA_A[PinMask] ^= 0xFF;
 }
 
 
@@ -427,42 +592,533 @@ void	InterruptPin(uint8_t pin, uint8_t triggerMode)
 
 
 
-/******************************************************************************************************************
-*																									Broken APIs																											*
-*		Below are the definitions for functions/APIs which are not in a working state yet.														*
+/*****************************************************************************************************************
+*	@interruptpin()																																																	*
+*	@brief				-	This function configures a GPIO pin as an Interrupt pin, and registers a handler for the pin		*
+* @pin					-	This variable holds the pin number which needs to be configured.																*
+*	@isr_func			-	Function which is called by GPIOPortIT_H() when an interrupt occurs on the pin.									*
+*	@triggerMode	-	Interrupt Trigger Mode ( Rising/Falling/Both Edge trigger or High/Low Level trigger )						*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The handler of the port (GPIOx_Handler in the startup file) must call GPIOPortIT_H() for the port. *
 ******************************************************************************************************************/
-//void	interruptpin(uint8_t pin, void (*isr_func)(void), uint8_t triggerMode)
-//{
-//	uint8_t PortName = getPortName(pin);
-//	uint8_t PinNumber = getPinNumber(pin);
-
-//	GPIO_Init(pin, Input, Digital, Eight_mA, triggerMode);
-//	
-//	/****************************************************************************************************************
-//	*	Specify the address of the ISR, and Enable the interrupt by setting the appropriate bit in the NVIC Enable		*
-//	*	register (in our case, EN0).																																									*
-//	****************************************************************************************************************/
-//	switch(PortName)
-//	{
-//		case GPIO_PORT_A:	ExceptionHandlers->_GPIOA = (uint32_t)isr_func;
-//											Nvic->EN[0] |= 1<<0;
-//											break;
-//		case GPIO_PORT_B:	ExceptionHandlers->_GPIOB = (uint32_t)isr_func;
-//											Nvic->EN[0] |= 1<<1;
-//											break;
-//		case GPIO_PORT_C:	ExceptionHandlers->_GPIOC = (uint32_t)isr_func;
-//											Nvic->EN[0] |= 1<<2;
-//											break;
-//		case GPIO_PORT_D:	ExceptionHandlers->_GPIOD = (uint32_t)isr_func;
-//											Nvic->EN[0] |= 1<<3;
-//											break;
-//		case GPIO_PORT_E:	ExceptionHandlers->_GPIOE = (uint32_t)isr_func;
-//											Nvic->EN[0] |= 1<<4;
-//											break;
-//		case GPIO_PORT_F: ExceptionHandlers->_GPIOF = (uint32_t)isr_func;
-//											Nvic->EN[0] |= 1<<30;
-//											break;
-//	}
-//}
+void	interruptpin(uint8_t pin, void (*isr_func)(void), uint8_t triggerMode)
+{
+	GPIOPinHandlers[ getPortName(pin)*8 + getPinNumber(pin) ] = isr_func;
+	InterruptPin(pin, triggerMode);
+}
+
+
+
+/*****************************************************************************************************************
+*	@GPIOPortIT_H()																																																	*
+*	@brief				-	Interrupt handler helper for a GPIO port. Call it from the handler of the port.									*
+* @GPIO_PORT		-	GPIO port which has raised the interrupt. Values above GPIO_PORT_F are ignored.									*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	GPIOMIS is read once and all the pending edge interrupts are cleared with a single write to			*
+*									GPIOICR, before the handlers run, so an edge which arrives while a handler is running is not		*
+*									lost. The handlers of the pending pins are then called lowest pin first, finding each pin with	*
+*									CTZ instead of testing the bits one by one.																											*
+*									Level triggered interrupts are not affected by GPIOICR, their handlers must remove the cause.		*
+*									Captured edges are added with the interrupts masked, so the handlers of the ports may have			*
+*									different priorities.																																						*
+******************************************************************************************************************/
+void	GPIOPortIT_H(uint8_t GPIOPort)
+{
+	GPIO_reg* pGPIO;
+	void (**Handlers)(void);
+	uint32_t Timestamp, Pending, Saved;
+	uint8_t Captured, Levels = 0;
+	
+	if(GPIOPort > GPIO_PORT_F)
+		return;
+	
+	pGPIO = getPortAddr(GPIOPort, SELECTED_BUS);
+	Handlers = &GPIOPinHandlers[GPIOPort*8];
+	Timestamp = GPIOCaptureMask[GPIOPort] ? pCaptureTimer->TAV : 0;				//	Read the timer first.
+	Pending = pGPIO->GPIO_MIS;
+	Captured = Pending & GPIOCaptureMask[GPIOPort];
+	
+	//	The level after a single-edge trigger is known from the edge. Pins on BothEdges are read before GPIOICR is
+	//	written, together with GPIOMIS.
+	if(Captured & GPIOCaptureBoth[GPIOPort])
+		Levels = pGPIO->GPIO_DATA_A[ Captured & GPIOCaptureBoth[GPIOPort] ];
+	Levels |= GPIOCaptureRising[GPIOPort];
+	
+	pGPIO->GPIO_ICR = Pending;
+	
+	if(Captured)
+	{
+		uint32_t Head;
+		
+		IRQ_LOCK(Saved);
+		Head = GPIOEdgeHead;
+		while(Captured)
+		{
+			uint8_t PinNumber = CTZ(Captured);
+			Captured &= Captured - 1;
+			
+			if(Head - GPIOEdgeTail >= GPIO_EDGE_BUFFER_SIZE)
+			{
+				GPIOEdgeOverflows++;
+				continue;
+			}
+			GPIOEdgeBuffer[Head & (GPIO_EDGE_BUFFER_SIZE-1)].Timestamp = Timestamp;
+			GPIOEdgeBuffer[Head & (GPIO_EDGE_BUFFER_SIZE-1)].pin = (GPIOPort+1)*10 + PinNumber;
+			GPIOEdgeBuffer[Head & (GPIO_EDGE_BUFFER_SIZE-1)].Level = GET_BIT(Levels, PinNumber);
+			Head++;
+		}
+		GPIOEdgeHead = Head;															//	Publish the new edges to GPIO_ReadEdges().
+		IRQ_UNLOCK(Saved);
+	}
+	
+	while(Pending)
+	{
+		uint8_t PinNumber = CTZ(Pending);
+		Pending &= Pending - 1;														//	Clear the lowest set bit.
+		
+		if(Handlers[PinNumber] != NULL)
+			Handlers[PinNumber]();
+	}
+}
+
+
+
+/*****************************************************************************************************************
+*	@GPIO_EdgeCaptureInit()																																													*
+*	@brief				-	This function starts the free-running timer which is used to timestamp captured edges						*
+* @Timerx				-	Timer module used for the timestamps. Use a 32/64-bit timer (Timer0W ... Timer5W) so that the		*
+*									16/32-bit timers stay free for other uses.																											*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The timer counts up at the system clock and wraps around every 2^32 cycles, so the difference of *
+*									two timestamps (Later - Earlier) is correct across a wrap-around.																*
+******************************************************************************************************************/
+void	GPIO_EdgeCaptureInit(uint8_t Timerx)
+{
+	TimerInit(Timerx, PeriodicTimer, CountUp, 0);
+	TimerStart(Timerx);
+	pCaptureTimer = TimerGetAddress(Timerx);
+}
+
+
+
+/*****************************************************************************************************************
+*	@EdgeCapturePin()																																																*
+*	@brief				-	This function configures a GPIO pin as an Interrupt pin whose edges are recorded								*
+* @pin					-	This variable holds the pin number which needs to be configured.																*
+*	@triggerMode	-	RisingEdge, FallingEdge or BothEdges.																														*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	GPIO_EdgeCaptureInit() must be called first. The handler of the port must call GPIOPortIT_H().	*
+*									A handler registered with interruptpin() for the same pin is still called.											*
+******************************************************************************************************************/
+void	EdgeCapturePin(uint8_t pin, uint8_t triggerMode)
+{
+	uint8_t PortName = getPortName(pin);
+	uint8_t PinMask = 1<<getPinNumber(pin);
+	
+	if(pCaptureTimer == NULL)		return;
+	
+	GPIOCaptureMask[PortName] |= PinMask;
+	GPIOCaptureRising[PortName] &= ~PinMask;
+	GPIOCaptureBoth[PortName] &= ~PinMask;
+	if(triggerMode == RisingEdge)					GPIOCaptureRising[PortName] |= PinMask;
+	else if(triggerMode == BothEdges)			GPIOCaptureBoth[PortName] |= PinMask;
+	InterruptPin(pin, triggerMode);
+}
+
+
+
+/*****************************************************************************************************************
+*	@GPIO_ReadEdges()																																																*
+*	@brief				-	This function reads the recorded edges, oldest first																						*
+* @pEdges				-	Buffer for the edges.																																						*
+*	@MaxEdges			-	Size of the buffer (in edges).																																	*
+* @return				-	No of edges read.																																								*
+*																																																									*
+*	@Note					-	This function must only be called from one place (normally the main loop). It never blocks, and	*
+*									it doesn't need the interrupts to be disabled.																									*
+******************************************************************************************************************/
+uint32_t	GPIO_ReadEdges(GPIOEdge* pEdges, uint32_t MaxEdges)
+{
+	uint32_t Tail = GPIOEdgeTail;
+	uint32_t Head = GPIOEdgeHead;
+	uint32_t Count = 0;
+	
+	while(Count < MaxEdges && Tail != Head)
+	{
+		pEdges[Count++] = GPIOEdgeBuffer[Tail & (GPIO_EDGE_BUFFER_SIZE-1)];
+		Tail++;
+	}
+	GPIOEdgeTail = Tail;																//	Hand the entries back to GPIOPortIT_H().
+	
+	return Count;
+}
+
+
+
+/*****************************************************************************************************************
+*	@GPIO_DebounceInit()																																														*
+*	@brief				-	This function starts the periodic timer which samples the debounced pins												*
+* @Timerx				-	Timer module used for the sampling ticks.																												*
+*	@TickPeriod		-	No of system clock cycles between two samples. A pin has to stay at a new level for							*
+*									DEBOUNCE_SAMPLES ticks before it changes its debounced state. Ex: 80000 => 5ms at 16MHz, so a		*
+*									press is reported after 20ms.																																		*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The handler of the timer (TIMERxA_Handler in the startup file) must call DebounceIT_H().				*
+******************************************************************************************************************/
+void	GPIO_DebounceInit(uint8_t Timerx, uint32_t TickPeriod)
+{
+	DebounceTimer = Timerx;
+	
+	TimerInit(Timerx, PeriodicTimer, CountDown, TickPeriod);
+	TimerIntControl(Timerx, ENABLE);
+	TimerStart(Timerx);
+}
+
 
 
+/*****************************************************************************************************************
+*	@DebouncePin()																																																	*
+*	@brief				-	This function configures a GPIO pin as a digital input and adds it to the debounced pins				*
+* @pin					-	This variable holds the pin number which needs to be configured.																*
+*	@IOmode				-	Input, InputPullUp or InputPullDown. A pin with InputPullUp reads 0 when pressed, all other pins *
+*									read 1 when pressed.																																						*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The current level of the pin is taken as its debounced state, so no event is reported for it.		*
+*									Register the pins before GPIO_DebounceInit(), or while the timer interrupt is disabled.					*
+******************************************************************************************************************/
+void	DebouncePin(uint8_t pin, uint8_t IOmode)
+{
+	uint8_t PortName = getPortName(pin);
+	uint8_t PinMask = 1 << getPinNumber(pin);
+	__vo DebouncePort* pPort = &DebounceState[PortName];
+	
+	DigitalPin(pin, IOmode);
+	
+	if(IOmode == InputPullUp)		pPort->ActiveLow |= PinMask;
+	else												pPort->ActiveLow &= ~PinMask;
+	
+	pPort->State = (pPort->State & ~PinMask) | (getPortAddr(pin,SELECTED_BUS))->GPIO_DATA_A[PinMask];
+	pPort->Cnt0 |= PinMask;
+	pPort->Cnt1 |= PinMask;
+	pPort->Mask |= PinMask;
+	DebouncePorts SET_BIT(PortName);
+}
+
+
+
+/*****************************************************************************************************************
+*	@DebounceIT_H()																																																	*
+*	@brief				-	Interrupt handler helper for the debounce timer. Call it from the handler of the timer.					*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	All the debounced pins of a port are sampled with a single read and debounced together with a		*
+*									vertical counter: a few logic operations update the counters of all 8 pins at once. The counter	*
+*									of a pin is reset while the sample equals the debounced state, and counts on while it differs.	*
+*									When it rolls over, the pin changes its state and an event is recorded.													*
+******************************************************************************************************************/
+void	DebounceIT_H(void)
+{
+	uint8_t Ports = DebouncePorts;
+	uint32_t Head = DebounceEventHead;
+	
+	TimerClearInt(DebounceTimer);
+	
+	while(Ports)
+	{
+		uint8_t PortName = CTZ(Ports);
+		__vo DebouncePort* pPort = &DebounceState[PortName];
+		uint8_t Sample = (getPortAddr(PortName,SELECTED_BUS))->GPIO_DATA_A[pPort->Mask];
+		uint8_t Delta = Sample ^ pPort->State;
+		uint8_t Cnt0 = ~(pPort->Cnt0 & Delta);
+		uint8_t Cnt1 = Cnt0 ^ (pPort->Cnt1 & Delta);
+		uint8_t Changed = Delta & Cnt0 & Cnt1;
+		uint8_t Pressed = (pPort->State ^ Changed) ^ pPort->ActiveLow;
+		
+		Ports &= Ports - 1;
+		pPort->Cnt0 = Cnt0;
+		pPort->Cnt1 = Cnt1;
+		pPort->State ^= Changed;
+		
+		while(Changed)
+		{
+			uint8_t PinNumber = CTZ(Changed);
+			Changed &= Changed - 1;
+			
+			if(Head - DebounceEventTail >= DEBOUNCE_EVENT_BUFFER_SIZE)
+			{
+				DebounceOverflows++;
+				continue;
+			}
+			DebounceEventBuffer[Head & (DEBOUNCE_EVENT_BUFFER_SIZE-1)].pin = (PortName+1)*10 + PinNumber;
+			DebounceEventBuffer[Head & (DEBOUNCE_EVENT_BUFFER_SIZE-1)].Pressed = GET_BIT(Pressed, PinNumber);
+			Head++;
+		}
+	}
+	DebounceEventHead = Head;														//	Publish the new events to GPIO_ReadButtonEvents().
+}
+
+
+
+/*****************************************************************************************************************
+*	@GPIO_ReadButtonEvents()																																												*
+*	@brief				-	This function reads the press/release events of the debounced pins, oldest first								*
+* @pEvents			-	Buffer for the events.																																					*
+*	@MaxEvents		-	Size of the buffer (in events).																																	*
+* @return				-	No of events read.																																							*
+*																																																									*
+*	@Note					-	This function must only be called from one place (normally the main loop). It never blocks, and	*
+*									it doesn't need the interrupts to be disabled.																									*
+******************************************************************************************************************/
+uint32_t	GPIO_ReadButtonEvents(DebounceEvent* pEvents, uint32_t MaxEvents)
+{
+	uint32_t Tail = DebounceEventTail;
+	uint32_t Head = DebounceEventHead;
+	uint32_t Count = 0;
+	
+	while(Count < MaxEvents && Tail != Head)
+	{
+		pEvents[Count++] = DebounceEventBuffer[Tail & (DEBOUNCE_EVENT_BUFFER_SIZE-1)];
+		Tail++;
+	}
+	DebounceEventTail = Tail;														//	Hand the entries back to DebounceIT_H().
+	
+	return Count;
+}
+
+
+
+/*****************************************************************************************************************
+*	@ReadDebouncedPin()																																															*
+*	@brief				-	This function reads the debounced state of a pin registered with DebouncePin()									*
+* @pin					-	Pin name.																																												*
+* @return				-	1 => pressed, 0 => released.																																		*
+******************************************************************************************************************/
+uint8_t	ReadDebouncedPin(uint8_t pin)
+{
+	__vo DebouncePort* pPort = &DebounceState[ getPortName(pin) ];
+	
+	return GET_BIT( (pPort->State ^ pPort->ActiveLow), getPinNumber(pin) );
+}
+
+
+
+/*****************************************************************************************************************
+*	@SoftPWMInit()																																																	*
+*	@brief				-	This function sets up the timer which runs the software PWM. No channel is driven yet.					*
+* @Timerx				-	Timer module used for the PWM.																																	*
+*	@Period				-	PWM period in system clock cycles. Ex: 16000 => 1kHz at 16MHz.																	*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The handler of the timer (TIMERxA_Handler in the startup file) must call SoftPWMIT_H().					*
+*									The timer runs periodic and counting down with TAILD set, so a TAILR written by SoftPWMIT_H() is *
+*									loaded on the next time-out. The steps follow each other back to back without any drift, no			*
+*									matter how late the interrupt is serviced. SoftPWMUpdate() sets TAILD when it starts the timer,	*
+*									after the interval of the first step has been loaded.																						*
+******************************************************************************************************************/
+void	SoftPWMInit(uint8_t Timerx, uint32_t Period)
+{
+	SoftPWM.Running = 0;
+	SoftPWM.Timer = Timerx;
+	SoftPWM.Period = Period;
+	SoftPWM.NoOfChannels = 0;
+	SoftPWM.Pending = 0;
+	
+	TimerInit(Timerx, PeriodicTimer, CountDown, Period);
+	TimerIntControl(Timerx, ENABLE);
+}
+
+
+
+/*****************************************************************************************************************
+*	@SoftPWMPin()																																																		*
+*	@brief				-	This function adds a pin to the software PWM channels, or changes the duty of a channel					*
+* @pin					-	This variable holds the pin number which needs to be configured.																*
+*	@Duty					-	No of system clock cycles per period for which the pin is high. 0 => always low,								*
+*									Period or more => always high.																																	*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The new duty is used after SoftPWMUpdate() is called. Pins which don't fit in SOFT_PWM_CHANNELS	*
+*									are ignored.																																										*
+******************************************************************************************************************/
+void	SoftPWMPin(uint8_t pin, uint32_t Duty)
+{
+	uint8_t Channel;
+	
+	for(Channel = 0; Channel < SoftPWM.NoOfChannels; Channel++)
+		if(SoftPWM.pin[Channel] == pin)		break;
+	
+	if(Channel == SoftPWM.NoOfChannels)
+	{
+		if(Channel == SOFT_PWM_CHANNELS)		return;
+		
+		DigitalPin(pin, Output);
+		SoftPWM.pin[Channel] = pin;
+		SoftPWM.NoOfChannels++;
+	}
+	SoftPWM.Duty[Channel] = Duty;
+}
+
+
+
+/*****************************************************************************************************************
+*	@SoftPWMUpdate()																																																*
+*	@brief				-	This function builds the schedule for the duties set with SoftPWMPin(). The running PWM switches *
+*									to it at the end of the current period, the first call starts the PWM.													*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	Duties are rounded as follows:-																																	*
+*									<>	A duty shorter than SOFT_PWM_MIN_INTERVAL is lengthened to SOFT_PWM_MIN_INTERVAL.						*
+*									<>	A duty which ends less than SOFT_PWM_MIN_INTERVAL before the period ends is always high.		*
+*									<>	A duty which ends less than SOFT_PWM_MIN_INTERVAL after a shorter duty ends with it.				*
+******************************************************************************************************************/
+void	SoftPWMUpdate(void)
+{
+	uint8_t Order[SOFT_PWM_CHANNELS];
+	uint8_t i, j, NoOfSteps = 1;
+	uint8_t Build;
+	uint32_t StepTime = 0;
+	__vo SoftPWMStep* pSteps;
+	Timer_Reg* pTimer;
+	
+	SoftPWM.Pending = 0;														//	From here on SoftPWMIT_H() doesn't switch, so Active is stable.
+	Build = SoftPWM.Running ? !SoftPWM.Active : SoftPWM.Active;
+	pSteps = SoftPWM.Schedule[Build];
+	
+	// Sort the channels by duty (insertion sort, there are only a few of them).
+	for(i = 0; i < SoftPWM.NoOfChannels; i++)
+	{
+		for(j = i; j > 0 && SoftPWM.Duty[ Order[j-1] ] > SoftPWM.Duty[i]; j--)
+			Order[j] = Order[j-1];
+		Order[j] = i;
+	}
+	
+	// Step 0 sets the channels which have a duty, and clears the ones which don't.
+	pSteps[0].Ports = 0;
+	for(i = 0; i < 6; i++)
+	{
+		pSteps[0].Mask[i] = 0;
+		pSteps[0].Value[i] = 0;
+		SoftPWM.pPort[i] = getPortAddr(i, SELECTED_BUS);
+	}
+	for(i = 0; i < SoftPWM.NoOfChannels; i++)
+	{
+		uint8_t PortName = getPortName(SoftPWM.pin[i]);
+		uint8_t PinMask = 1 << getPinNumber(SoftPWM.pin[i]);
+		
+		pSteps[0].Ports SET_BIT(PortName);
+		pSteps[0].Mask[PortName] |= PinMask;
+		if(SoftPWM.Duty[i])		pSteps[0].Value[PortName] |= PinMask;
+	}
+	
+	// Every later step clears the channels whose duty ends at its time.
+	for(i = 0; i < SoftPWM.NoOfChannels; i++)
+	{
+		uint8_t Channel = Order[i];
+		uint32_t Duty = SoftPWM.Duty[Channel];
+		uint8_t PortName = getPortName(SoftPWM.pin[Channel]);
+		__vo SoftPWMStep* pStep;
+		
+		if(Duty == 0)																											continue;
+		if(Duty < SOFT_PWM_MIN_INTERVAL)																	Duty = SOFT_PWM_MIN_INTERVAL;
+		if(Duty + SOFT_PWM_MIN_INTERVAL > SoftPWM.Period)									break;			//	Always high from here on.
+		
+		if(NoOfSteps == 1 || Duty - StepTime >= SOFT_PWM_MIN_INTERVAL)
+		{
+			pSteps[NoOfSteps-1].Interval = Duty - StepTime;
+			StepTime = Duty;
+			pStep = &pSteps[NoOfSteps++];
+			pStep->Ports = 0;
+			for(j = 0; j < 6; j++)		pStep->Mask[j] = pStep->Value[j] = 0;
+		}
+		else
+			pStep = &pSteps[NoOfSteps-1];
+		
+		pStep->Ports SET_BIT(PortName);
+		pStep->Mask[PortName] |= 1 << getPinNumber(SoftPWM.pin[Channel]);
+	}
+	pSteps[NoOfSteps-1].Interval = SoftPWM.Period - StepTime;
+	SoftPWM.NoOfSteps[Build] = NoOfSteps;
+	
+	if(SoftPWM.Running)
+	{
+		SoftPWM.Pending = 1;
+		return;
+	}
+	
+	// Start: load the interval of the first step while TAILD is clear, so the counter takes it at once, then set TAILD
+	// for the intervals written by SoftPWMIT_H(). The first step is applied, and the next interval written, before
+	// the timer is started, so the first period is as long as the others.
+	pTimer = TimerGetAddress(SoftPWM.Timer);
+	SoftPWM.StepIndex = 0;
+	SoftPWM.Running = 1;
+	pTimer->TAMR CLR_BIT(TIMER_TAMR_TAILD);
+	pTimer->TAILR = pSteps[0].Interval - 1;
+	pTimer->TAMR SET_BIT(TIMER_TAMR_TAILD);
+	SoftPWMIT_H();
+	TimerStart(SoftPWM.Timer);
+}
+
+
+
+/*****************************************************************************************************************
+*	@SoftPWMIT_H()																																																	*
+*	@brief				-	Interrupt handler helper for the software PWM timer. Call it from the handler of the timer.			*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The time-out which calls this function starts a step. The step's stores are made first, then the *
+*									interval of the following step is written to TAILR, for the timer to load on the next time-out.	*
+******************************************************************************************************************/
+void	SoftPWMIT_H(void)
+{
+	__vo SoftPWMStep* pStep = &SoftPWM.Schedule[SoftPWM.Active][SoftPWM.StepIndex];
+	uint8_t Ports = pStep->Ports;
+	uint8_t StepIndex = SoftPWM.StepIndex + 1;
+	
+	while(Ports)
+	{
+		uint8_t PortName = CTZ(Ports);
+		Ports &= Ports - 1;
+		SoftPWM.pPort[PortName]->GPIO_DATA_A[pStep->Mask[PortName]] = pStep->Value[PortName];
+	}
+	TimerClearInt(SoftPWM.Timer);
+	
+	if(StepIndex == SoftPWM.NoOfSteps[SoftPWM.Active])
+	{
+		StepIndex = 0;
+		if(SoftPWM.Pending)																//	Switch to the new schedule at the end of the period.
+		{
+			SoftPWM.Active ^= 1;
+			SoftPWM.Pending = 0;
+		}
+	}
+	SoftPWM.StepIndex = StepIndex;
+	TimerGetAddress(SoftPWM.Timer)->TAILR = SoftPWM.Schedule[SoftPWM.Active][StepIndex].Interval - 1;
+}
+
+
+
+/*****************************************************************************************************************
+*	@SoftPWMStop()																																																	*
+*	@brief				-	This function stops the software PWM and drives all its pins low																*
+* @return				-	Nothing (void).																																									*
+*																																																									*
+*	@Note					-	The channels and duties are kept. SoftPWMUpdate() starts the PWM again.													*
+******************************************************************************************************************/
+void	SoftPWMStop(void)
+{
+	uint8_t i;
+	
+	TimerStop(SoftPWM.Timer);
+	TimerClearInt(SoftPWM.Timer);
+	SoftPWM.Running = 0;
+	SoftPWM.Pending = 0;
+	
+	for(i = 0; i < SoftPWM.NoOfChannels; i++)
+		WriteToPin(SoftPWM.pin[i], PIN_RESET);
+}
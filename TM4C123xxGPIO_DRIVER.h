@@ -69,6 +69,73 @@
 #define	LowLevel					5
 
 
+/*****************************************************************************************************************
+	@GPIOBusSelect
+	Each bit of this variable corresponds to the GPIO port of that index. A bit set in an index implies that the
+	port is accessed over the AHB (Advanced High-Performance Bus) aperture, a bit cleared implies the APB aperture.
+	All driver APIs access the ports through the selected aperture. Use GPIO_SelectBus() to change it.
+	Ex: If bit 5 of this variable is set => GPIO Port F is accessed over AHB.
+******************************************************************************************************************/
+extern uint8_t GPIOBusSelect;
+
+
+/*****************************************************************************************************************
+	@GPIOPinHandlers
+	Interrupt handlers of the GPIO pins, registered by interruptpin() and called by GPIOPortIT_H().
+	Index of the handler for a pin = (port * 8) + pin number. Ex: PF4 => 5*8 + 4 = 44.
+******************************************************************************************************************/
+extern void (*GPIOPinHandlers[48])(void);
+
+
+/*****************************************************************************************************************
+	@GPIOEdge
+	An edge recorded by the edge capture (see EdgeCapturePin()). Edges are collected by GPIOPortIT_H() into a ring
+	of GPIO_EDGE_BUFFER_SIZE entries, and read in batches with GPIO_ReadEdges().
+	@GPIOEdgeOverflows counts the edges which were dropped because the ring was full.
+******************************************************************************************************************/
+typedef struct
+{
+	uint32_t	Timestamp;							//	Count of the capture timer (system clock cycles) when the edge was serviced
+	uint8_t		pin;										//	Pin name (PA0 ... PF7)
+	uint8_t		Level;									//	Level of the pin after the edge
+}GPIOEdge;
+
+#define GPIO_EDGE_BUFFER_SIZE		64		//	Must be a power of 2
+
+extern uint32_t GPIOEdgeOverflows;
+
+
+/*****************************************************************************************************************
+	@DebounceEvent
+	A press or release of a pin registered with DebouncePin(). The pins are sampled by DebounceIT_H() on every tick
+	of the debounce timer, and a pin changes its debounced state after DEBOUNCE_SAMPLES equal samples in a row.
+	Events are collected into a ring of DEBOUNCE_EVENT_BUFFER_SIZE entries, and read with GPIO_ReadButtonEvents().
+	@DebounceOverflows counts the events which were dropped because the ring was full.
+******************************************************************************************************************/
+typedef struct
+{
+	uint8_t		pin;										//	Pin name (PA0 ... PF7)
+	uint8_t		Pressed;								//	1 => pressed, 0 => released
+}DebounceEvent;
+
+#define DEBOUNCE_SAMPLES							4				//	Fixed by the 2-bit vertical counter
+#define DEBOUNCE_EVENT_BUFFER_SIZE		16			//	Must be a power of 2
+
+extern uint32_t DebounceOverflows;
+
+
+/*****************************************************************************************************************
+	Software PWM
+	Up to SOFT_PWM_CHANNELS pins of any GPIO ports are driven with a common period from the interrupt of a timer.
+	The duties are turned into a schedule of steps sorted by time: the first step sets all the channels, and every
+	later step clears the channels whose duty ends there, with one masked store per port. The timer interrupts once
+	per step, not once per channel. Duties which end less than SOFT_PWM_MIN_INTERVAL cycles apart are cleared in the
+	same step, so the interrupt always has time to finish before the next step.
+******************************************************************************************************************/
+#define SOFT_PWM_CHANNELS					16
+#define SOFT_PWM_MIN_INTERVAL			160			//	System clock cycles (10us at 16MHz)
+
+
 
 /******************************************************************************************************************
 *																					APIs Supported by this Driver																						*
@@ -88,10 +155,30 @@
 *	9. 	ToggleGPIOPin()				-		Toggle the state of a GPIO pin																										*
 *	10. ReadFromPin()					-		Read data from a GPIO pin																													*
 *	11. ReadFromPort()				-		Read data from a GPIO port																												*
+*	12. WriteToPortMasked()		-		Write digital values to selected pins of a GPIO port with a single store					*
+*	13. GPIO_SelectBus()			-		Select the bus (APB/AHB) through which a GPIO port is accessed										*
+*	14. GPIO_InitPort()				-		Initialize a group of pins of a GPIO port with the same configuration							*
+*	15. interruptpin()				-		Initialize an interrupt pin and register a handler for it													*
+*	16. GPIOPortIT_H()				-		Helper for GPIO Interrupt Handler function. Dispatches to the handlers of the pins *
+*	17. GPIO_EdgeCaptureInit()	-		Start the free-running timer which timestamps captured edges										*
+*	18. EdgeCapturePin()			-		Initialize an interrupt pin whose edges are timestamped and recorded							*
+*	19. GPIO_ReadEdges()			-		Read the recorded edges																														*
+*	20. GPIO_DebounceInit()		-		Start the periodic timer which samples the debounced pins													*
+*	21. DebouncePin()					-		Initialize an input pin which is debounced																				*
+*	22. DebounceIT_H()				-		Helper for the Interrupt Handler function of the debounce timer										*
+*	23. GPIO_ReadButtonEvents()	-		Read the press/release events of the debounced pins															*
+*	24. ReadDebouncedPin()		-		Read the debounced state (pressed/released) of a pin															*
+*	25. SoftPWMInit()					-		Set up the timer which runs the software PWM																			*
+*	26. SoftPWMPin()					-		Initialize a pin as a software PWM output, or change its duty											*
+*	27. SoftPWMUpdate()				-		Apply the duties set with SoftPWMPin() from the next period on										*
+*	28. SoftPWMIT_H()					-		Helper for the Interrupt Handler function of the software PWM timer								*
+*	29. SoftPWMStop()					-		Stop the software PWM and drive all its pins low																	*
 ******************************************************************************************************************/
 void	GPIO_ClockControl( uint8_t GPIO_Port, uint8_t Clk_En);
 void	GPIO_Init(	 uint8_t pin, uint8_t ioMode, uint8_t pinMode, uint8_t DriveStrength, uint8_t Trigger);
+void	GPIO_InitPort(uint8_t GPIO_PORT, uint8_t PinMask, uint8_t ioMode, uint8_t pinMode, uint8_t DriveStrength, uint8_t Trigger);
 void	GPIO_DeInit( uint8_t GPIO_PORT);
+void	GPIO_SelectBus(uint8_t GPIO_PORT, uint8_t Bus);
 
 void	DigitalPin(  uint8_t pin, uint8_t IOmode);
 void	AnalogPin(	 uint8_t pin, uint8_t IOmode);
@@ -99,17 +186,30 @@ void	InterruptPin(uint8_t pin, uint8_t triggerMode);
 
 void	WriteToPin( uint8_t pin, uint8_t Value);
 void	WriteToPort(uint8_t GPIO_PORT, uint8_t Values);
+void	WriteToPortMasked(uint8_t GPIO_PORT, uint8_t Mask, uint8_t Values);
 
 void	ToggleGPIOPin(uint8_t pin);
 
 uint8_t	ReadFromPin(uint8_t pin);
 uint8_t	ReadFromPort(uint8_t GPIO_PORT);
 
-
-/******************************************************************************************************************
-*																									Broken APIs																											*
-*		Below are the prototypes for functions/APIs which are not in a working state yet.															*
-******************************************************************************************************************/
 void	interruptpin(uint8_t pin, void (*isr_func)(void), uint8_t triggerMode);
+void	GPIOPortIT_H(uint8_t GPIO_PORT);
+
+void	GPIO_EdgeCaptureInit(uint8_t Timerx);
+void	EdgeCapturePin(uint8_t pin, uint8_t triggerMode);
+uint32_t	GPIO_ReadEdges(GPIOEdge* pEdges, uint32_t MaxEdges);
+
+void	GPIO_DebounceInit(uint8_t Timerx, uint32_t TickPeriod);
+void	DebouncePin(uint8_t pin, uint8_t IOmode);
+void	DebounceIT_H(void);
+uint32_t	GPIO_ReadButtonEvents(DebounceEvent* pEvents, uint32_t MaxEvents);
+uint8_t	ReadDebouncedPin(uint8_t pin);
+
+void	SoftPWMInit(uint8_t Timerx, uint32_t Period);
+void	SoftPWMPin(uint8_t pin, uint32_t Duty);
+void	SoftPWMUpdate(void);
+void	SoftPWMIT_H(void);
+void	SoftPWMStop(void);
 
 #endif
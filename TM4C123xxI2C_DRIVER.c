@@ -112,7 +112,7 @@ void I2CInit(uint8_t I2Cx, uint8_t SpeedMode, uint32_t ClkSpeed, uint8_t ACKCont
 	uint8_t I2C_SCL_PIN_NUM = getPinNumber(I2C_SCL_PIN);
 	uint8_t I2C_SDA_PIN_NUM = getPinNumber(I2C_SDA_PIN);
 	
-	GPIO_reg* pGPIO = getPortAddr(I2C_SCL_PIN, APB_BUS);
+	GPIO_reg* pGPIO = getPortAddr(I2C_SCL_PIN, SELECTED_BUS);
 	
 	GPIO_ClockControl(getPortName(I2C_SCL_PIN), ENABLE);			//	Step 2 of section 16.4
 	
@@ -192,11 +192,12 @@ void I2CInit(uint8_t I2Cx, uint8_t SpeedMode, uint32_t ClkSpeed, uint8_t ACKCont
 *	@Len						-	Length of the data (in bytes), i.e., the no. of 8 bit packets that are to be sent.						*
 * @return					-	Error Code (1 if transmission error has occured | 0 if no error)															*
 ******************************************************************************************************************/
-uint8_t I2CMasterSendData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* TxBuf, uint8_t Len)
+uint8_t I2CMasterSendData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* TxBuf, uint32_t Len)
 {
 	// Verify the steps from figure 16-10 (Pg. 1010)
 	I2C_reg* pI2Cx = I2CGetAddress(I2Cx);
 	
+	if(Len == 0)	return 0;														//	Nothing to send.
 	
 	pI2Cx->MSA &= 0xFFFFFF00;													//	Step 8 of section 16.4
 	pI2Cx->MSA |= ( SlaveAddress<<0 );
@@ -273,7 +274,7 @@ uint8_t I2CMasterSendByte(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t Data)
 *	@Len						-	Length of data( no of data "bytes") that is to be received.																		*
 * @return					-	Error Code( 1 if transmission error has occured )																							*
 ******************************************************************************************************************/
-uint8_t I2CMasterRecvData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* RxBuf, uint8_t Len)
+uint8_t I2CMasterRecvData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* RxBuf, uint32_t Len)
 {
 	I2C_reg* pI2Cx = I2CGetAddress(I2Cx);
 	
@@ -183,18 +183,18 @@ void I2CDeInit(uint8_t I2Cx);
 uint8_t I2CClockControl(uint8_t I2Cx,uint8_t	EnorDi);
 
 
-uint8_t I2CMasterSendData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* TxBuf, uint8_t Len);
+uint8_t I2CMasterSendData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* TxBuf, uint32_t Len);
 uint8_t I2CMasterSendByte(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t Data);
 
-uint8_t I2CMasterRecvData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* RxBuf, uint8_t Len);
+uint8_t I2CMasterRecvData(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* RxBuf, uint32_t Len);
 uint8_t I2CMasterRecvByte(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t* RxByte);
 
 
 void		I2CSetSlaveAddress(uint8_t I2Cx, uint8_t Address);
-uint8_t I2CSlaveSendData(uint8_t I2Cx, uint8_t* TxBuf, uint8_t Len);
+uint8_t I2CSlaveSendData(uint8_t I2Cx, uint8_t* TxBuf, uint32_t Len);
 uint8_t I2CSlaveSendByte(uint8_t I2Cx, uint8_t Data);
 
-uint8_t I2CSlaveRecvData(uint8_t I2Cx, uint8_t* RxBuf, uint8_t Len);
+uint8_t I2CSlaveRecvData(uint8_t I2Cx, uint8_t* RxBuf, uint32_t Len);
 uint8_t I2CSlaveRecvByte(uint8_t I2Cx);
 
 
@@ -0,0 +1,216 @@
+/******************************************************************************************************************
+*	@file			-	TM4C123xxLOG.c																																											*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains definition of the deferred (binary) logging APIs.																						*
+*	See TM4C123xxLOG.h for the list of APIs and the format of the records.																					*
+*																																																									*
+* @Note			-	All of the code present in the this file applies to TM4C123GH6PM microcontroller.										*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+
+
+#include "TM4C123xxLOG.h"
+
+
+// GLOBAL VARIABLES
+
+// Ring of records. LogHead is written only by LogWrite() (with interrupts masked), LogTail only by LogService() and
+// LogFlush(). Both run freely, the index into LogRing is taken with (LOG_RING_WORDS-1).
+static uint32_t LogRing[LOG_RING_WORDS];
+static __vo uint32_t LogHead;
+static __vo uint32_t LogTail;
+
+// @LogSending - No of words from LogTail which the uDMA controller is sending right now.
+static uint32_t LogSending;
+
+// @LogLost / @LogLostSent - Records dropped so far, and how many of them have been reported on the line.
+static __vo uint32_t LogLost;
+static uint32_t LogLostSent;
+
+// @LogUART - UART which the log is sent on.
+static uint8_t LogUART = UART0;
+
+
+static uint8_t LogPut(uint32_t Header, const uint32_t* Args, uint32_t Count);		// see definitions below
+static void LogReportLost(void);
+
+
+
+/******************************************************************************************************************
+*	@LogInit()																																																			*
+*	@brief				-	This function selects the UART which the log is sent on, and empties the ring.									*
+* @UARTx				-	Name of the UART Module. It must have been initialized with UARTInit()/UARTInitBaud().					*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	The log is sent with UARTSendDMA(), so the handler of the UART must call UARTDMA_H(). Nothing else	*
+*									may send on this UART with DMA.																																	*
+******************************************************************************************************************/
+void LogInit(uint8_t UARTx)
+{
+	LogUART = UARTx;
+	LogHead = 0;
+	LogTail = 0;
+	LogSending = 0;
+	LogLost = 0;
+	LogLostSent = 0;
+}
+
+
+
+/******************************************************************************************************************
+*	@LogWrite()																																																			*
+*	@brief				-	This function puts one record into the ring. It is called by LOG(), which builds the header.		*
+* @Header				-	Header word of the record (see LOG_HEADER()).																										*
+*	@Args					-	Arguments of the record.																																				*
+*	@Count				-	No of arguments (at most LOG_MAX_ARGS).																													*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	The record is dropped (and counted) if it doesn't fit in the ring. It can be called from interrupt	*
+*									handlers, interrupts are masked only while the words are copied.																*
+******************************************************************************************************************/
+void LogWrite(uint32_t Header, const uint32_t* Args, uint32_t Count)
+{
+	uint32_t Saved;
+	
+	IRQ_LOCK(Saved);
+	if( LogPut(Header, Args, Count) )
+		LogLost++;
+	IRQ_UNLOCK(Saved);
+}
+
+
+
+/******************************************************************************************************************
+*	@LogService()																																																		*
+*	@brief				-	This function hands the next part of the ring to the uDMA controller when the previous one has	*
+*									been sent. It returns at once, so it can be called as often as needed.													*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	A part ends at the end of the ring or at LogHead, and is at most LOG_PART_WORDS long. Records which	*
+*									have been dropped since the last call are reported by a record with the format ID LOG_LOST_ID.	*
+******************************************************************************************************************/
+void LogService(void)
+{
+	uint32_t Tail = LogTail;
+	uint32_t Words;
+	
+	if(LogSending)
+	{
+		if( UARTDMATxPending(LogUART) )
+			return;
+		Tail += LogSending;
+		LogTail = Tail;
+		LogSending = 0;
+	}
+	
+	LogReportLost();
+	
+	Words = LogHead - Tail;
+	if(Words == 0)
+		return;
+	if( Words > LOG_RING_WORDS - (Tail & (LOG_RING_WORDS-1)) )
+		Words = LOG_RING_WORDS - (Tail & (LOG_RING_WORDS-1));
+	if(Words > LOG_PART_WORDS)
+		Words = LOG_PART_WORDS;
+	
+	// UARTSendDMA() returns 1 until UARTDMA_H() has finished the previous transfer. The part is started on a later call.
+	if( UARTSendDMA(LogUART, (const uint8_t*)&LogRing[Tail & (LOG_RING_WORDS-1)], Words*4) == 0 )
+		LogSending = Words;
+}
+
+
+
+/******************************************************************************************************************
+*	@LogFlush()																																																			*
+*	@brief				-	This function sends everything which has been logged, and waits until the last byte has left the	*
+*									UART.																																														*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	The rest of the ring is sent with UARTSend() (polling), so it also works with interrupts masked, e.g.	*
+*									in a fault handler or before a reset. Records logged from interrupt handlers meanwhile are sent as	*
+*									well.																																														*
+*								-	A part which LogService() has handed to the uDMA controller is at most LOG_PART_WORDS long, so it	*
+*									completes without UARTDMA_H(), and waiting for it doesn't need interrupts either.								*
+******************************************************************************************************************/
+void LogFlush(void)
+{
+	uint32_t Tail;
+	uint32_t Words;
+	
+	if(LogSending)
+	{
+		while( UARTDMATxPending(LogUART) );
+		LogTail += LogSending;
+		LogSending = 0;
+	}
+	
+	LogReportLost();
+	
+	while( (Words = LogHead - (Tail = LogTail)) != 0 )
+	{
+		if( Words > LOG_RING_WORDS - (Tail & (LOG_RING_WORDS-1)) )
+			Words = LOG_RING_WORDS - (Tail & (LOG_RING_WORDS-1));
+		UARTSend(LogUART, (uint8_t*)&LogRing[Tail & (LOG_RING_WORDS-1)], Words*4);
+		LogTail = Tail + Words;
+	}
+	
+	WaitWhileUARTisBusy( UARTGetAddress(LogUART) );
+}
+
+
+
+/******************************************************************************************************************
+*	@LogDropped()																																																		*
+*	@brief				-	No of records which have been dropped because the ring was full (since LogInit()).							*
+******************************************************************************************************************/
+uint32_t LogDropped(void)
+{
+	return LogLost;
+}
+
+
+
+/******************************************************************************************************************
+* @LogPut()																																																				*
+* @brief	-	Copies one record into the ring. Interrupts must be masked.																						*
+* @return	-	0 if the record has been copied, 1 (and nothing is copied) if it doesn't fit.													*
+******************************************************************************************************************/
+static uint8_t LogPut(uint32_t Header, const uint32_t* Args, uint32_t Count)
+{
+	uint32_t Head = LogHead;
+	uint32_t i;
+	
+	if( LOG_RING_WORDS - (Head - LogTail) < Count + 1 )
+		return 1;
+	
+	LogRing[Head & (LOG_RING_WORDS-1)] = Header;
+	for(i = 0; i < Count; i++)
+		LogRing[ (Head + 1 + i) & (LOG_RING_WORDS-1) ] = Args[i];
+	LogHead = Head + Count + 1;
+	
+	return 0;
+}
+
+
+
+/******************************************************************************************************************
+* @LogReportLost()																																																*
+* @brief	-	Puts a record with the no of records dropped since the last report into the ring, if there is room.		*
+******************************************************************************************************************/
+static void LogReportLost(void)
+{
+	uint32_t Saved;
+	uint32_t Lost;
+	
+	if(LogLost == LogLostSent)
+		return;
+	
+	IRQ_LOCK(Saved);
+	Lost = LogLost - LogLostSent;
+	if( LogPut( ((uint32_t)LOG_SYNC<<24) | (1UL<<20) | LOG_LOST_ID, &Lost, 1 ) == 0 )
+		LogLostSent += Lost;
+	IRQ_UNLOCK(Saved);
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxLOG.h																																											*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains prototypes of the deferred (binary) logging APIs and the LOG() macro.												*
+*																																																									*
+*	How it works:-																																																	*
+*	<>	LOG("fmt", args...) doesn't format anything. It puts a header word (the ID of the format string) and the raw	*
+*			arguments into a RAM ring (LogRing) and returns. The format string itself is never read on the target.			*
+*	<>	LogService() sends the ring to an UART with the uDMA controller, straight from the ring, in the background.	*
+*	<>	tools/LogDecoder.c runs on the build machine. It reads the format strings from the ELF file of the firmware	*
+*			and turns the bytes received from the UART back into text.																									*
+*																																																									*
+*	Record on the ring / on the line (32-bit little-endian words):																									*
+*	<>	Header	:	LOG_SYNC (bits 31:24), no of arguments (bits 23:20), offset of the format string in the "logstr"	*
+*								section (bits 19:0).																																							*
+*	<>	Then one word per argument. Arguments are converted to uint32_t, so %d, %i, %u, %x, %X, %o, %c and %p (of a	*
+*			32-bit pointer) can be used. %s, floating point and 64-bit arguments can't be used.													*
+*																																																									*
+* @Note			-	Format strings are placed in the "logstr" section and identified by their offset from __start_logstr,	*
+*						which the GNU linker defines. Nothing on the target reads them; they only have to stay in the ELF file	*
+*						which is given to the decoder. LOG() needs a GNU compatible compiler and linker.											*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#ifndef TM4C123XXLOG_H
+#define TM4C123XXLOG_H
+
+#include "TM4C123xx.h"
+
+
+
+/*****************************************************************************************************************
+*															Miscellaneous macros, shorthands and Global variables																*
+******************************************************************************************************************/
+
+// Size of the ring in 32-bit words. Must be a power of 2. One record takes 1 + (no of arguments) words.
+#define LOG_RING_WORDS				512
+
+// Largest part of the ring handed to the uDMA controller at a time. It fits in one control structure, so a part
+// doesn't need UARTDMA_H() to finish, and LogFlush() can wait for it with interrupts masked.
+#define LOG_PART_WORDS				( DMA_MAX_TRANSFER/4 )
+
+#define LOG_MAX_ARGS					15							//	Arguments per record
+#define LOG_SYNC							0xA5						//	Top byte of every header, lets the decoder find records again
+#define LOG_LOST_ID						0xFFFFF					//	Format ID of the record which reports lost records (1 argument)
+
+#define LOG_HEADER(Format, Count)		( ((uint32_t)LOG_SYNC<<24) | ((uint32_t)(Count)<<20) | (uint32_t)((Format) - __start_logstr) )
+
+extern const char __start_logstr[];
+
+
+/*****************************************************************************************************************
+	@LOG
+	Records a format string and up to LOG_MAX_ARGS arguments. It takes tens of cycles, and can be used from interrupt
+	handlers. Records which don't fit in the ring are dropped and counted (see LogDropped()).
+	Pointers must be cast to uint32_t. Ex:	LOG("rx %u bytes, status %x\n", Len, Status);
+******************************************************************************************************************/
+#define LOG(Format, ...)																																											\
+	do																																																					\
+	{																																																						\
+		static const char LogFormat[] __attribute__((section("logstr"), used)) = Format;													\
+		const uint32_t LogArgs[] = { 0, ##__VA_ARGS__ };																													\
+		(void)sizeof( char[ (sizeof(LogArgs)/4 - 1 <= LOG_MAX_ARGS) ? 1 : -1 ] );																	\
+		LogWrite( LOG_HEADER(LogFormat, sizeof(LogArgs)/4 - 1), &LogArgs[1], sizeof(LogArgs)/4 - 1 );							\
+	}while(0)
+
+
+
+/*****************************************************************************************************************
+*																					APIs Supported by this Module																						*
+*																																																									*
+*	1.	LogInit()					-	Select the UART which the log is sent on, and empty the ring.														*
+*	2.	LogWrite()				-	Put one record into the ring (used by LOG()).																						*
+*	3.	LogService()			-	Send what has been logged. Call it from the main loop or a periodic interrupt.					*
+*	4.	LogFlush()				-	Send everything which has been logged and wait until it is out (e.g. before a reset).		*
+*	5.	LogDropped()			-	No of records which have been dropped because the ring was full.												*
+******************************************************************************************************************/
+void LogInit(uint8_t UARTx);
+void LogWrite(uint32_t Header, const uint32_t* Args, uint32_t Count);
+void LogService(void);
+void LogFlush(void);
+uint32_t LogDropped(void);
+
+#endif
@@ -0,0 +1,485 @@
+/******************************************************************************************************************
+*	@file			-	TM4C123xxMODBUS.c																																										*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains definition of the Modbus RTU slave APIs.																											*
+*	See TM4C123xxMODBUS.h for the list of APIs and the register map.																								*
+*																																																									*
+* @Note			-	All of the code present in the this file applies to TM4C123GH6PM microcontroller.										*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+
+
+#include "TM4C123xxMODBUS.h"
+
+
+// GLOBAL VARIABLES
+
+// @ModbusCRCTable - CRC16 of every byte value (polynomial 0xA001, reflected). One lookup per byte.
+static const uint16_t ModbusCRCTable[256] =
+{
+	0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+	0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+	0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+	0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+	0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+	0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+	0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+	0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+	0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+	0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+	0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+	0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+	0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+	0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+	0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+	0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+	0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+	0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+	0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+	0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+	0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+	0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+	0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+	0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+	0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+	0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+	0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+	0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+	0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+	0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+	0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+	0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+// Configuration (see ModbusInit()).
+static uint8_t ModbusUART;
+static uint8_t ModbusTimer;
+static uint8_t ModbusAddress;
+static const ModbusRegion* ModbusMap;
+static uint8_t ModbusMapSize;
+
+// Frame being received. Written only by ModbusUART_H() and ModbusTimer_H(). RxLen counts the bytes of the frame, also
+// those which are not stored (too long, or the frame is discarded).
+static uint8_t ModbusRxBuf[MODBUS_MAX_ADU];
+static uint32_t ModbusRxLen;
+static uint16_t ModbusRxCRC;
+static uint8_t ModbusRxDiscard;
+
+// @ModbusRxReady - Length of the frame waiting for ModbusService(), 0 if none. ModbusRxBuf belongs to ModbusService()
+// while it is not 0.
+static __vo uint32_t ModbusRxReady;
+
+// Reply being sent. ModbusTxBuf belongs to ModbusUART_H() while ModbusTxBusy is set.
+static uint8_t ModbusTxBuf[MODBUS_MAX_ADU];
+static uint32_t ModbusTxLen;
+static uint32_t ModbusTxPos;
+static __vo uint8_t ModbusTxBusy;
+
+static ModbusStats ModbusCounters;
+
+
+static uint32_t ModbusExecute(const uint8_t* Req, uint32_t Len, uint8_t* Rsp);		// see definitions below
+static const ModbusRegion* ModbusFind(uint8_t Table, uint32_t Address, uint32_t Quantity);
+static void ModbusFillTxFIFO(UART_Reg* pUART);
+
+
+
+/******************************************************************************************************************
+*	@ModbusInit()																																																		*
+*	@brief				-	This function starts the Modbus RTU slave on an UART module and a timer.												*
+* @UARTx				-	Name of the UART Module. It must have been initialized with UARTInitBaud(), 8 data bits (Modbus	*
+*									asks for even parity, or no parity and 2 stop bits) and the FIFOs enabled.											*
+*	@Timerx				-	Name of the Timer Module which times the end of a frame (t3.5).																	*
+*	@Address			-	Address of this slave (1 - 247).																																*
+*	@Baud					-	Baud rate of the UART, used for the t3.5 gap (1750us above 19200 bauds, as Modbus asks).				*
+*	@Map					-	Register map. It must stay valid while the slave runs.																					*
+*	@MapSize			-	No of regions in Map.																																						*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	The handler of the UART must call ModbusUART_H(), and the handler of the timer ModbusTimer_H().	*
+*									Both interrupts must have the same priority, so that one handler never interrupts the other.		*
+******************************************************************************************************************/
+void ModbusInit(uint8_t UARTx, uint8_t Timerx, uint8_t Address, uint32_t Baud, const ModbusRegion* Map, uint8_t MapSize)
+{
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint8_t IRQNumber = UARTIRQNumber[UARTx - UART0];
+	uint32_t Gap;
+	
+	ModbusUART = UARTx;
+	ModbusTimer = Timerx;
+	ModbusAddress = Address;
+	ModbusMap = Map;
+	ModbusMapSize = MapSize;
+	ModbusRxLen = 0;
+	ModbusRxCRC = 0xFFFF;
+	ModbusRxDiscard = 0;
+	ModbusRxReady = 0;
+	ModbusTxBusy = 0;
+	
+	// The Rx time-out comes 32 bit periods after the last byte. The timer waits for the rest of t3.5 (3.5 frames of
+	// 11 bits, or 1750us above 19200 bauds).
+	if(Baud > 19200)
+		Gap = (SYS_CLK/1000000)*1750 - (uint32_t)( (uint64_t)SYS_CLK*32/Baud );
+	else
+		Gap = (uint32_t)( (uint64_t)SYS_CLK*13/(2*Baud) );
+	TimerInit(Timerx, OneShotTimer, CountDown, Gap);
+	TimerIntControl(Timerx, ENABLE);
+	
+	pUART->IM &= ~( (1<<UART_IM_TX) | (1<<UART_IM_RX) | (1<<UART_IM_RT) );
+	UARTSetFIFOLevels(UARTx, FIFOLevel_1_4, MODBUS_RX_LEVEL);
+	pUART->CTL |= (1<<UART_CTL_TXE) | (1<<UART_CTL_RXE);
+	pUART->ICR = (1<<UART_ICR_TX) | (1<<UART_ICR_RX) | (1<<UART_ICR_RT) | UART_RIS_ERRORS;
+	pUART->IM |= (1<<UART_IM_RX) | (1<<UART_IM_RT);
+	NVIC->EN[IRQNumber/32] = 1 << (IRQNumber%32);
+}
+
+
+
+/******************************************************************************************************************
+*	@ModbusService()																																																*
+*	@brief				-	This function serves the request which has been received, if any, and starts sending the reply.	*
+*									It returns at once, so it can be called as often as needed.																			*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	The handlers of the register map are called from here, not from an interrupt handler. Requests	*
+*									which come before the reply of the previous one is in the Tx FIFO are dropped.									*
+******************************************************************************************************************/
+void ModbusService(void)
+{
+	UART_Reg* pUART;
+	uint32_t Len = ModbusRxReady;
+	uint32_t RspLen;
+	
+	if(Len == 0 || ModbusTxBusy)
+		return;
+	
+	RspLen = ModbusExecute(ModbusRxBuf, Len, ModbusTxBuf);
+	if(ModbusRxBuf[0] == MODBUS_BROADCAST)
+		RspLen = 0;																				//	No reply to a broadcast.
+	else if(ModbusTxBuf[1] & 0x80)
+		ModbusCounters.Exceptions++;											//	Only the exception replies which are sent.
+	ModbusRxReady = 0;																	//	ModbusRxBuf is free again.
+	
+	if(RspLen == 0)
+		return;
+	
+	ModbusTxLen = RspLen;
+	ModbusTxPos = 0;
+	ModbusTxBusy = 1;
+	
+	pUART = UARTGetAddress(ModbusUART);
+	pUART->IM CLR_BIT( UART_IM_TX );
+	ModbusFillTxFIFO(pUART);
+	if(ModbusTxBusy)
+		pUART->IM SET_BIT( UART_IM_TX );			//	The rest goes when the Tx FIFO drains to its level.
+}
+
+
+
+/******************************************************************************************************************
+*	@ModbusUART_H()																																																	*
+*	@brief				-	Interrupt handler helper. Call it from the handler of the UART given to ModbusInit().						*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	At the Rx trigger level, MODBUS_RX_TRIGGER-1 bytes are taken, so at least one stays in the			*
+*									FIFO and the Rx time-out still comes after the last byte. On the time-out the FIFO is emptied		*
+*									and the timer is started for the rest of the t3.5 gap.																					*
+******************************************************************************************************************/
+void ModbusUART_H(void)
+{
+	UART_Reg* pUART = UARTGetAddress(ModbusUART);
+	uint32_t Status = pUART->MIS;
+	
+	pUART->ICR = Status;
+	
+	if( Status & ( (1<<UART_MIS_RX) | (1<<UART_MIS_RT) ) )
+	{
+		uint32_t Left = (Status & (1<<UART_MIS_RT)) ? MODBUS_MAX_ADU : MODBUS_RX_TRIGGER - 1;
+		uint32_t Len = ModbusRxLen;
+		uint16_t CRC = ModbusRxCRC;
+		
+		while( Left-- && !GET_BIT(pUART->FR, UART_FR_RXFE) )
+		{
+			uint32_t Data = pUART->DR;
+			
+			if(Len == 0 && ModbusRxReady)
+				ModbusRxDiscard = 1;												//	The previous request hasn't been served yet.
+			if(Data & UART_DR_ERRORS)
+				ModbusRxDiscard = 1;
+			if(Len < MODBUS_MAX_ADU)
+			{
+				ModbusRxBuf[Len] = (uint8_t)Data;
+				CRC = (CRC >> 8) ^ ModbusCRCTable[ (CRC ^ Data) & 0xFF ];
+			}
+			Len++;
+		}
+		ModbusRxLen = Len;
+		ModbusRxCRC = CRC;
+		
+		if( Status & (1<<UART_MIS_RT) )
+		{
+			Timer_Reg* pTimer = TimerGetAddress(ModbusTimer);
+			
+			pTimer->CTL CLR_BIT(TIMER_CTL_TAEN);
+			pTimer->TAV = pTimer->TAILR;														//	Restart from the full period.
+			pTimer->CTL SET_BIT(TIMER_CTL_TAEN);
+		}
+	}
+	
+	if( Status & (1<<UART_MIS_TX) )
+		ModbusFillTxFIFO(pUART);
+}
+
+
+
+/******************************************************************************************************************
+*	@ModbusTimer_H()																																																*
+*	@brief				-	Interrupt handler helper. Call it from the handler of the timer given to ModbusInit().					*
+* @return				-	Nothing(void).																																									*
+*																																																									*
+*	@Note					-	The line has been quiet for t3.5, unless bytes have come while the timer ran. Then the frame		*
+*									goes on, and the next Rx time-out starts the timer again.																				*
+******************************************************************************************************************/
+void ModbusTimer_H(void)
+{
+	UART_Reg* pUART = UARTGetAddress(ModbusUART);
+	uint32_t Len = ModbusRxLen;
+	
+	TimerClearInt(ModbusTimer);
+	
+	if( !GET_BIT(pUART->FR, UART_FR_RXFE) || Len == 0 )
+		return;
+	
+	if(ModbusRxDiscard || Len > MODBUS_MAX_ADU)
+		ModbusCounters.Dropped++;
+	else if(Len < 4 || ModbusRxCRC != 0)							//	The CRC of a frame with its own CRC is 0.
+		ModbusCounters.CRCErrors++;
+	else if(ModbusRxBuf[0] == ModbusAddress || ModbusRxBuf[0] == MODBUS_BROADCAST)
+	{
+		ModbusCounters.Frames++;
+		ModbusRxReady = Len;
+	}
+	
+	ModbusRxLen = 0;
+	ModbusRxCRC = 0xFFFF;
+	ModbusRxDiscard = 0;
+}
+
+
+
+/******************************************************************************************************************
+*	@ModbusCRC16()																																																	*
+*	@brief				-	CRC16 of a buffer as Modbus RTU computes it (the low byte is sent first).												*
+******************************************************************************************************************/
+uint16_t ModbusCRC16(const uint8_t* Data, uint32_t Len)
+{
+	uint16_t CRC = 0xFFFF;
+	
+	while(Len--)
+		CRC = (CRC >> 8) ^ ModbusCRCTable[ (CRC ^ *Data++) & 0xFF ];
+	
+	return CRC;
+}
+
+
+
+/******************************************************************************************************************
+*	@ModbusGetStats()																																																*
+*	@brief				-	Copies the counters of the slave (since ModbusInit()) into *pStats.															*
+******************************************************************************************************************/
+void ModbusGetStats(ModbusStats* pStats)
+{
+	*pStats = ModbusCounters;
+}
+
+
+
+/*---------------------------------------------- HELPER FUNCTIONS -----------------------------------------------*/
+
+
+
+/******************************************************************************************************************
+* @ModbusFind()																																																		*
+* @brief	-	Finds the region of a table which holds Quantity items from Address.																	*
+* @return	-	The region, or NULL if no region holds all of them.																										*
+******************************************************************************************************************/
+static const ModbusRegion* ModbusFind(uint8_t Table, uint32_t Address, uint32_t Quantity)
+{
+	uint8_t i;
+	
+	for(i = 0; i < ModbusMapSize; i++)
+	{
+		const ModbusRegion* pRegion = &ModbusMap[i];
+		
+		if( pRegion->Table == Table && Address >= pRegion->Start && Address + Quantity <= (uint32_t)pRegion->Start + pRegion->Count )
+			return pRegion;
+	}
+	return NULL;
+}
+
+
+
+/******************************************************************************************************************
+* @ModbusExecute()																																																*
+* @brief	-	Serves one request (a frame with a valid CRC) and builds the reply, or an exception reply.						*
+* @return	-	Length of the reply with its CRC.																																			*
+******************************************************************************************************************/
+static uint32_t ModbusExecute(const uint8_t* Req, uint32_t Len, uint8_t* Rsp)
+{
+	uint8_t Function = Req[1];
+	uint32_t Address = (Req[2] << 8) | Req[3];
+	uint32_t Quantity = (Req[4] << 8) | Req[5];
+	const ModbusRegion* pRegion;
+	uint32_t RspLen = 2;
+	uint8_t Exception = 0;
+	uint32_t i;
+	uint16_t Value;
+	uint16_t CRC;
+	
+	Rsp[0] = Req[0];
+	Rsp[1] = Function;
+	Len -= 2;																					//	Without the CRC
+	
+	switch(Function)
+	{
+		case 0x01:
+		case 0x02:																			//	Read Coils / Discrete Inputs
+			if(Len != 6 || Quantity < 1 || Quantity > 2000)
+			{
+				Exception = MODBUS_EX_ILLEGAL_VALUE;
+				break;
+			}
+			pRegion = ModbusFind( (Function == 0x01) ? MODBUS_COILS : MODBUS_DISCRETE_INPUTS, Address, Quantity );
+			if(pRegion == NULL)
+			{
+				Exception = MODBUS_EX_ILLEGAL_ADDRESS;
+				break;
+			}
+			Rsp[2] = (uint8_t)( (Quantity + 7) / 8 );
+			for(i = 0; i < Rsp[2]; i++)
+				Rsp[3 + i] = 0;
+			for(i = 0; i < Quantity; i++)
+			{
+				Value = 0;
+				Exception = pRegion->Read(Address + i, &Value);
+				if(Exception)		break;												//	Value may not have been written.
+				if(Value)
+					Rsp[3 + i/8] |= 1 << (i%8);
+			}
+			RspLen = 3 + Rsp[2];
+			break;
+		
+		case 0x03:
+		case 0x04:																			//	Read Holding / Input Registers
+			if(Len != 6 || Quantity < 1 || Quantity > 125)
+			{
+				Exception = MODBUS_EX_ILLEGAL_VALUE;
+				break;
+			}
+			pRegion = ModbusFind( (Function == 0x03) ? MODBUS_HOLDING_REGISTERS : MODBUS_INPUT_REGISTERS, Address, Quantity );
+			if(pRegion == NULL)
+			{
+				Exception = MODBUS_EX_ILLEGAL_ADDRESS;
+				break;
+			}
+			Rsp[2] = (uint8_t)(2 * Quantity);
+			for(i = 0; i < Quantity; i++)
+			{
+				Value = 0;
+				Exception = pRegion->Read(Address + i, &Value);
+				if(Exception)		break;
+				Rsp[3 + 2*i] = (uint8_t)(Value >> 8);
+				Rsp[4 + 2*i] = (uint8_t)Value;
+			}
+			RspLen = 3 + Rsp[2];
+			break;
+		
+		case 0x05:
+		case 0x06:																			//	Write Single Coil / Register (Quantity is the value)
+			if( Len != 6 || (Function == 0x05 && Quantity != 0xFF00 && Quantity != 0x0000) )
+			{
+				Exception = MODBUS_EX_ILLEGAL_VALUE;
+				break;
+			}
+			pRegion = ModbusFind( (Function == 0x05) ? MODBUS_COILS : MODBUS_HOLDING_REGISTERS, Address, 1 );
+			if(pRegion == NULL || pRegion->Write == NULL)
+			{
+				Exception = MODBUS_EX_ILLEGAL_ADDRESS;
+				break;
+			}
+			Exception = pRegion->Write( Address, (Function == 0x05) ? (Quantity != 0) : Quantity );
+			for(i = 2; i < 6; i++)
+				Rsp[i] = Req[i];														//	The reply echoes the request.
+			RspLen = 6;
+			break;
+		
+		case 0x0F:
+		case 0x10:																			//	Write Multiple Coils / Registers
+			if( Len < 7 || Len != 7u + Req[6] || Quantity < 1 ||
+					(Function == 0x0F && (Quantity > 1968 || Req[6] != (Quantity + 7) / 8)) ||
+					(Function == 0x10 && (Quantity > 123 || Req[6] != 2 * Quantity)) )
+			{
+				Exception = MODBUS_EX_ILLEGAL_VALUE;
+				break;
+			}
+			pRegion = ModbusFind( (Function == 0x0F) ? MODBUS_COILS : MODBUS_HOLDING_REGISTERS, Address, Quantity );
+			if(pRegion == NULL || pRegion->Write == NULL)
+			{
+				Exception = MODBUS_EX_ILLEGAL_ADDRESS;
+				break;
+			}
+			for(i = 0; i < Quantity && !Exception; i++)
+			{
+				if(Function == 0x0F)
+					Value = (Req[7 + i/8] >> (i%8)) & 1;
+				else
+					Value = (Req[7 + 2*i] << 8) | Req[8 + 2*i];
+				Exception = pRegion->Write(Address + i, Value);
+			}
+			for(i = 2; i < 6; i++)
+				Rsp[i] = Req[i];
+			RspLen = 6;
+			break;
+		
+		default:
+			Exception = MODBUS_EX_ILLEGAL_FUNCTION;
+	}
+	
+	if(Exception)
+	{
+		Rsp[1] = Function | 0x80;
+		Rsp[2] = Exception;
+		RspLen = 3;
+	}
+	
+	CRC = ModbusCRC16(Rsp, RspLen);
+	Rsp[RspLen++] = (uint8_t)CRC;
+	Rsp[RspLen++] = (uint8_t)(CRC >> 8);
+	
+	return RspLen;
+}
+
+
+
+/******************************************************************************************************************
+* @ModbusFillTxFIFO()																																															*
+* @brief	-	Moves bytes of the reply into the Tx FIFO until it is full or the reply is in. Then the Tx interrupt	*
+*						is masked and ModbusTxBuf is free.																																		*
+******************************************************************************************************************/
+static void ModbusFillTxFIFO(UART_Reg* pUART)
+{
+	uint32_t Pos = ModbusTxPos;
+	
+	while( Pos != ModbusTxLen && !GET_BIT(pUART->FR, UART_FR_TXFF) )
+		pUART->DR = ModbusTxBuf[Pos++];
+	ModbusTxPos = Pos;
+	
+	if(Pos == ModbusTxLen)
+	{
+		pUART->IM CLR_BIT( UART_IM_TX );
+		ModbusTxBusy = 0;
+	}
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxMODBUS.h																																										*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains prototypes of the Modbus RTU slave APIs, and the register map which they serve.							*
+*																																																									*
+*	How it works:-																																																	*
+*	<>	Bytes are taken out of the Rx FIFO by ModbusUART_H() at the Rx trigger level (MODBUS_RX_LEVEL), and the CRC	*
+*			is updated on the way, so there is one interrupt per MODBUS_RX_TRIGGER-1 bytes instead of one per byte.			*
+*	<>	One byte is always left in the FIFO at the trigger level, so the Rx time-out interrupt (UART_IM_RT) comes		*
+*			32 bit periods after the last byte of a frame. It starts a one-shot timer for the rest of the t3.5 gap.			*
+*	<>	If no byte has come when the timer runs out (ModbusTimer_H()), the frame is complete. A frame with a valid	*
+*			CRC and our address (or 0, broadcast) is handed to ModbusService(), which calls the handlers of the					*
+*			register map and sends the reply from the Tx FIFO interrupt.																								*
+*																																																									*
+*	@Note			-	Supported functions: 01/02 Read Coils/Discrete Inputs, 03/04 Read Holding/Input Registers,					*
+*						05/06 Write Single Coil/Register, 15/16 Write Multiple Coils/Registers. Others get exception 01.			*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#ifndef TM4C123XXMODBUS_H
+#define TM4C123XXMODBUS_H
+
+#include "TM4C123xx.h"
+
+
+
+/*****************************************************************************************************************
+*															Miscellaneous macros, shorthands and Global variables																*
+******************************************************************************************************************/
+
+#define MODBUS_MAX_ADU				256							//	Largest RTU frame: address, PDU (253 bytes) and CRC
+#define MODBUS_BROADCAST			0
+
+// Rx FIFO level of ModbusUART_H(). MODBUS_RX_TRIGGER - 1 bytes are taken out per Rx interrupt.
+#define MODBUS_RX_LEVEL				FIFOLevel_3_4
+#define MODBUS_RX_TRIGGER			12
+
+// @ModbusTable
+#define MODBUS_COILS							0				//	Read/write bits				(functions 01, 05, 15)
+#define MODBUS_DISCRETE_INPUTS		1				//	Read-only bits				(function 02)
+#define MODBUS_HOLDING_REGISTERS	2				//	Read/write registers	(functions 03, 06, 16)
+#define MODBUS_INPUT_REGISTERS		3				//	Read-only registers		(function 04)
+
+// @ModbusException - Returned by the handlers of the register map. 0 => no exception.
+#define MODBUS_EX_ILLEGAL_FUNCTION		0x01
+#define MODBUS_EX_ILLEGAL_ADDRESS			0x02
+#define MODBUS_EX_ILLEGAL_VALUE				0x03
+#define MODBUS_EX_DEVICE_FAILURE			0x04
+
+
+/******************************************************************************************************************
+	@ModbusRegion
+	One region of the register map: Count coils/inputs/registers of one table from address Start. A request must lie
+	within a single region. Read() and Write() are called once per item (bits are passed as 0/1) from ModbusService(),
+	and return 0 or a @ModbusException. Write may be NULL for a read-only region.
+******************************************************************************************************************/
+typedef struct
+{
+	uint8_t		Table;												//	@ModbusTable
+	uint16_t	Start;
+	uint16_t	Count;
+	uint8_t		(*Read)(uint16_t Address, uint16_t* pValue);
+	uint8_t		(*Write)(uint16_t Address, uint16_t Value);
+}ModbusRegion;
+
+
+/******************************************************************************************************************
+	@ModbusStats
+	Counters of the Modbus RTU slave, read with ModbusGetStats().
+******************************************************************************************************************/
+typedef struct
+{
+	uint32_t Frames;											//	Valid frames addressed to this slave (or broadcast)
+	uint32_t CRCErrors;										//	Frames with a wrong CRC or shorter than 4 bytes
+	uint32_t Dropped;											//	Frames with line errors, too long, or received while busy
+	uint32_t Exceptions;									//	Exception replies sent (broadcasts get no reply)
+}ModbusStats;
+
+
+
+/*****************************************************************************************************************
+*																					APIs Supported by this Module																						*
+*																																																									*
+*	1.	ModbusInit()				-	Start the slave on an UART and a timer, with its address and register map.						*
+*	2.	ModbusService()			-	Serve a received request and start the reply. Call it from the main loop.							*
+*	3.	ModbusUART_H()			-	Handler helper. Call it from the handler of the UART.																	*
+*	4.	ModbusTimer_H()			-	Handler helper. Call it from the handler of the timer.																*
+*	5.	ModbusCRC16()				-	CRC of a buffer (table-driven, polynomial 0xA001, initial value 0xFFFF).							*
+*	6.	ModbusGetStats()		-	Read the counters.																																		*
+******************************************************************************************************************/
+void ModbusInit(uint8_t UARTx, uint8_t Timerx, uint8_t Address, uint32_t Baud, const ModbusRegion* Map, uint8_t MapSize);
+void ModbusService(void);
+void ModbusUART_H(void);
+void ModbusTimer_H(void);
+uint16_t ModbusCRC16(const uint8_t* Data, uint32_t Len);
+void ModbusGetStats(ModbusStats* pStats);
+
+#endif
@@ -0,0 +1,2188 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxSIM.c																																											*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains the host-side register model used when the drivers are built with TM4C123XX_HOST_SIM.				*
+*	See TM4C123xxSIM.h for an overview of how the model works.																											*
+*																																																									*
+*	Modelled behaviour:-																																														*
+*	<>	SYSCTL	:	PRxxx registers follow RCGCxxx. Setting a bit in SRxxx resets the module. Accesses to a module		*
+*								whose clock is gated off are counted as bus faults (read as zero, writes ignored).								*
+*	<>	NVIC		:	EN/DIS and PEND/UNPEND behave as set/clear register pairs.																				*
+*	<>	GPIO		:	Address-masked data window, direction, pull-ups, edge/level interrupt status and W1C ICR. Both the *
+*								APB and the AHB aperture reach the same port; only the one selected in GPIOHBCTL works.						*
+*	<>	UART		:	16-deep Tx/Rx FIFOs which drain/fill at the programmed baud rate, FR flags, IFLS trigger levels,	*
+*								receive time-out, error bits, loopback, RTS/CTS flow control, 9-bit address filtering, RIS/MIS		*
+*								and W1C ICR.																																											*
+*	<>	SSI			:	8-deep Tx/Rx FIFOs clocked at the programmed bit rate, SR flags, loopback, RIS/MIS and ICR.				*
+*	<>	I2C			:	Master transfers with BUSY timing, address NACK, MDR receive data, MRIS/MMIS and W1C MICR.				*
+*	<>	Timers	:	Timer A of every 16/32 and 32/64 bit timer counting up or down, one-shot/periodic time-out, ICR.	*
+*								TAILD: a new TAILR is used from the next time-out, and enabling the timer keeps the count.				*
+*	<>	uDMA		:	Control table in host memory (see SimBusAddress()), basic, auto, ping-pong and memory/peripheral	*
+*								scatter-gather modes, priority/useburst/request mask, single and burst requests from the UARTs,		*
+*								DMACHIS and bus errors. Completion interrupts go to the UART which owns the channel, or to the uDMA	*
+*								software interrupt. Data is moved without taking any bus cycles.																	*
+*																																																									*
+* @Note			-	The prescalers of the timers and the slave side of SSI/I2C are not modelled.												*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#ifdef TM4C123XX_HOST_SIM
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+
+#include "TM4C123xxSIM.h"
+
+#if !defined(__linux__) || !defined(__x86_64__)
+#error "TM4C123XX_HOST_SIM needs an x86-64 Linux host."
+#endif
+
+
+
+/*****************************************************************************************************************
+*																			Miscellaneous macros and aliases																						*
+******************************************************************************************************************/
+#define SIM_PAGE						0x1000U
+#define SIM_PERIPH_SIZE			0x00100000U										//	0x40000000 - 0x400FFFFF
+#define SIM_CORE_SIZE				0x1000U												//	0xE000E000 - 0xE000EFFF
+#define SIM_FLASH_SIZE			0x1000U												//	0x00000000 - 0x00000FFF
+#define SIM_TRAP_SIZE				(SIM_PERIPH_SIZE + SIM_CORE_SIZE)
+
+#define SIM_EFLAGS_TF				0x100U												//	Trap Flag (single step)
+#define SIM_PF_WRITE				0x2U													//	Page fault error code: access was a write
+#define SIM_MAX_PENDING			4															//	Trapped pages a single instruction may touch
+#define SIM_MAX_DISPATCH		1024													//	Handler calls per SimDispatchInterrupts()
+#define SIM_DMA_MAX_SERVICE	4096													//	Channel services per SimDMAStep()
+#define SIM_DMA_SLICE				32														//	Cycles per step of SimAdvance() while a channel is enabled
+#define SIM_BUS_WINDOW			0x00100000U										//	Size of one window of host memory on the bus
+#define SIM_BUS_WINDOWS			512														//	0x20000000 - 0x3FFFFFFF
+
+#define SIM_LOG_SIZE				4096													//	Bytes/frames kept from Tx lines
+#define SIM_LINE_SIZE				1024													//	Bytes/frames waiting on Rx lines
+
+#define SIM_GPIO_UNLOCK			0x4C4F434BU
+#define SIM_UART_ADDRESS		(1U<<12)											//	Frame on an UART line with the 9th bit set (address byte)
+
+// Module types
+#define SIM_NONE						0
+#define SIM_SYSCTL					1
+#define SIM_NVIC						2
+#define SIM_GPIO						3
+#define SIM_SSI							4
+#define SIM_I2C							5
+#define SIM_UART						6
+#define SIM_TIMER						7
+#define SIM_DMA							8
+
+// Register access inside the model. The model always works on the writable alias, never on the trapped view.
+#define REG(base, type, field)		( *SimReg( (base) + offsetof(type, field) ) )
+#define OFFSET(type, field)				( (uint32_t)offsetof(type, field) )
+
+
+
+/*****************************************************************************************************************
+*																					Model state																															*
+******************************************************************************************************************/
+typedef struct
+{
+	uint8_t		Out;														//	Output latch
+	uint8_t		In;															//	Levels driven on the pins from outside
+	uint8_t		Driven;													//	Pins which are driven from outside (others follow PUR/PDR)
+	uint8_t		RIS;														//	Edge-detected interrupt status
+	uint8_t		Unlocked;
+}SimGPIO;
+
+typedef struct
+{
+	uint8_t		Tx[16];
+	uint8_t		TxHead, TxCount, Shifting, TxData, TxAddress;
+	uint64_t	TxLeft;													//	Cycles left for the frame in the Tx shift register
+	uint16_t	Rx[16];													//	Received data along with the error bits (layout of DR)
+	uint8_t		RxHead, RxCount, PendingOE, RSR;
+	uint64_t	RxLeft;													//	Cycles left for the frame in the Rx shift register
+	uint64_t	RxIdle;													//	Cycles since the last frame was received (receive time-out)
+	uint16_t	Line[SIM_LINE_SIZE];						//	Frames waiting on the Rx line
+	uint32_t	LineHead, LineCount;
+	uint8_t		Log[SIM_LOG_SIZE];							//	Frames which have been shifted out
+	uint32_t	LogHead, LogCount;
+	uint32_t	RIS;
+	uint8_t		CTSOff;													//	CTS input de-asserted by the other side (see SimUARTSetCTS())
+	uint8_t		Matched;												//	Last address byte matched the 9-bit self address
+	uint32_t	LineBaud;												//	Rate of the other side (see SimUARTSetLineBaud()), 0 = same as the UART
+	uint64_t	LineAt;													//	Cycles of the frame on the line which have passed (LineBaud != 0)
+}SimUART;
+
+typedef struct
+{
+	uint16_t	Tx[8];
+	uint8_t		TxHead, TxCount, Shifting;
+	uint16_t	TxData;
+	uint64_t	TxLeft;
+	uint16_t	Rx[8];
+	uint8_t		RxHead, RxCount;
+	uint64_t	RxIdle;
+	uint16_t	Line[SIM_LINE_SIZE];
+	uint32_t	LineHead, LineCount;
+	uint16_t	Log[SIM_LOG_SIZE];
+	uint32_t	LogHead, LogCount;
+	uint32_t	RIS;														//	Latched ROR and RT bits. TX and RX follow the FIFO levels.
+}SimSSI;
+
+typedef struct
+{
+	uint8_t		Busy, Cmd, Error, AdrAck, BusBusy;
+	uint64_t	Left;
+	uint32_t	MRIS;
+	uint8_t		Nack[16];												//	One bit per 7-bit slave address
+	uint8_t		Line[SIM_LINE_SIZE];
+	uint32_t	LineHead, LineCount;
+	uint8_t		Log[SIM_LOG_SIZE];
+	uint32_t	LogHead, LogCount;
+}SimI2C;
+
+typedef struct
+{
+	uint64_t	Count;
+	uint32_t	RIS;
+}SimTimer;
+
+typedef struct
+{
+	uint8_t		Master, Err, Busy;
+	uint32_t	UseBurst, ReqMask, Enable, Alt, Prio;
+	uint32_t	SwReq;													//	Software requests not served yet
+	uint32_t	Running;												//	Auto/memory scatter-gather channels which run until they complete
+	uint32_t	ChIS;
+}SimDMA;
+
+typedef struct
+{
+	uint8_t*	Page;
+	uint32_t	Address;
+	uint32_t	Old;
+	uint8_t		Write;
+	uint8_t		Ignore;
+}SimAccess;
+
+
+uint8_t* SimFlashRegion		= NULL;
+uint8_t* SimPeriphRegion	= NULL;
+uint8_t* SimCoreRegion		= NULL;
+
+uint32_t SimCyclesPerAccess = 4;
+
+static uint8_t*	SimAlias = NULL;										//	Writable view of the trapped regions, used by the model.
+
+static SimGPIO	GPIOState[6];
+static SimUART	UARTState[8];
+static SimSSI		SSIState[4];
+static SimI2C		I2CState[4];
+static SimTimer	TimerState[12];
+static SimDMA		DMAState;
+
+static uintptr_t	BusWindow[SIM_BUS_WINDOWS];				//	Host address >> 20 of every window on the bus
+static uint32_t		BusWindowCount = 0;
+
+static uint32_t	NVICEnabled[5];
+static uint32_t	NVICPending[5];
+static uint32_t	NVICActive[5];
+static void			(*ISRTable[SIM_IRQ_COUNT])(void);
+
+static SimStats	Stats;
+static uint32_t	ReadCount[SIM_TRAP_SIZE/4];
+static uint32_t	WriteCount[SIM_TRAP_SIZE/4];
+
+static SimAccess	Pending[SIM_MAX_PENDING];
+static __vo uint8_t		PendingCount = 0;
+
+static __vo uint8_t		Measuring = 0;
+static __vo uint64_t	Instructions = 0;
+static uint64_t				MeasureBias = 0;
+
+static const uint32_t GPIOBaseAPB[6] = { GPIOAP_BASE_ADDRESS, GPIOBP_BASE_ADDRESS, GPIOCP_BASE_ADDRESS,
+																				 GPIODP_BASE_ADDRESS, GPIOEP_BASE_ADDRESS, GPIOFP_BASE_ADDRESS };
+static const uint32_t GPIOBaseAHB[6] = { GPIOAH_BASE_ADDRESS, GPIOBH_BASE_ADDRESS, GPIOCH_BASE_ADDRESS,
+																				 GPIODH_BASE_ADDRESS, GPIOEH_BASE_ADDRESS, GPIOFH_BASE_ADDRESS };
+static const uint32_t TimerBase[12]  = { Timer0_BASE_ADDRESS,  Timer1_BASE_ADDRESS,  Timer2_BASE_ADDRESS,
+																				 Timer3_BASE_ADDRESS,  Timer4_BASE_ADDRESS,  Timer5_BASE_ADDRESS,
+																				 Timer0W_BASE_ADDRESS, Timer1W_BASE_ADDRESS, Timer2W_BASE_ADDRESS,
+																				 Timer3W_BASE_ADDRESS, Timer4W_BASE_ADDRESS, Timer5W_BASE_ADDRESS };
+
+/*	Interrupt numbers of the modules. Timers have Timer A at the given number and Timer B at the next one. */
+static const uint8_t GPIOIRQ[6]		= { 0, 1, 2, 3, 4, 30 };
+static const uint8_t UARTIRQ[8]		= { 5, 6, 33, 59, 60, 61, 62, 63 };
+static const uint8_t SSIIRQ[4]		= { 7, 34, 57, 58 };
+static const uint8_t I2CIRQ[4]		= { 8, 37, 68, 69 };
+static const uint8_t TimerIRQ[12]	= { 19, 21, 23, 35, 70, 92, 94, 96, 98, 100, 102, 104 };
+
+/*	UART FIFO trigger levels selected by the IFLS fields (1/8, 1/4, 1/2, 3/4, 7/8 of 16 entries). */
+static const uint8_t UARTFifoLevel[8] = { 2, 4, 8, 12, 14, 8, 8, 8 };
+
+/*	uDMA channels (Rx, Tx) of the UARTs and the DMACHMAPn encoding which selects them. */
+static const uint8_t UARTDMARx[8]		= { 8, 22, 12, 16, 18, 6, 10, 20 };
+static const uint8_t UARTDMATx[8]		= { 9, 23, 13, 17, 19, 7, 11, 21 };
+static const uint8_t UARTDMAEnc[8]	= { 0, 0, 1, 2, 2, 2, 2, 2 };
+
+/*	Rx pins of the UARTs, driven by the Rx line while it runs at its own rate. */
+static const uint8_t UARTRxPin[8]		= { PA0, PB0, PD6, PC6, PC4, PE4, PD4, PE0 };
+
+static void SimDMAStep(void);																			//	see uDMA Model below
+static void SimUpdateLines(void);																	//	see Interrupts below
+
+
+
+/*****************************************************************************************************************
+*																					Functions for internal use																							*
+******************************************************************************************************************/
+
+/*	Offset of a hardware address inside the trapped regions. AHB GPIO apertures resolve to the APB page because
+*		both of them are backed by the same memory. */
+static uint32_t SimOffset(uint32_t addr)
+{
+	uint8_t port;
+
+	if(addr >= CORE_PERIPHERAL_BASE_ADDR)
+		return SIM_PERIPH_SIZE + (addr - CORE_PERIPHERAL_BASE_ADDR);
+
+	for(port = 0; port < 6; port++)
+		if( (addr & ~(SIM_PAGE-1)) == GPIOBaseAHB[port] )
+			return (GPIOBaseAPB[port] - PERIPHERAL_BASE_ADDR) + (addr & (SIM_PAGE-1));
+
+	return addr - PERIPHERAL_BASE_ADDR;
+}
+
+static __vo uint32_t* SimReg(uint32_t addr)
+{
+	return (__vo uint32_t*)( SimAlias + SimOffset(addr) );
+}
+
+static uint32_t SimViewOffset(uint32_t addr)
+{
+	if(addr >= CORE_PERIPHERAL_BASE_ADDR)
+		return SIM_PERIPH_SIZE + (addr - CORE_PERIPHERAL_BASE_ADDR);
+	return addr - PERIPHERAL_BASE_ADDR;
+}
+
+static uint32_t UARTBase(uint8_t n)	{	return UART0_BASE_ADDRESS + n*SIM_PAGE;	}
+static uint32_t SSIBase(uint8_t n)	{	return SSI0_BASE_ADDRESS + n*SIM_PAGE;	}
+static uint32_t I2CBase(uint8_t n)	{	return I2C0_BASE_ADDRESS + n*SIM_PAGE;	}
+
+
+
+/*****************************************************************************************************************
+* @SimIdentify()																																																	*
+* @brief		-	Find the module which owns a register.																															*
+* @addr			-	Hardware address of the register.																																		*
+* @pIndex		-	Returns the index of the module (port number, UART number etc.).																		*
+* @pAHB			-	Returns 1 if a GPIO port was accessed over its AHB aperture.																				*
+* @return		-	Module type (SIM_xxx).																																							*
+******************************************************************************************************************/
+static uint8_t SimIdentify(uint32_t addr, uint8_t* pIndex, uint8_t* pAHB)
+{
+	uint32_t page = addr & ~(SIM_PAGE-1);
+	uint8_t i;
+
+	*pIndex = 0;
+	*pAHB = 0;
+
+	if(page == SYSTEM_CONTROL_BASE_ADDR)				return SIM_SYSCTL;
+	if(page == CORE_PERIPHERAL_BASE_ADDR)				return SIM_NVIC;
+	if(page == DMA_BASE_ADDR)										return SIM_DMA;
+
+	for(i = 0; i < 6; i++)
+	{
+		if(page == GPIOBaseAPB[i])	{	*pIndex = i;								return SIM_GPIO;	}
+		if(page == GPIOBaseAHB[i])	{	*pIndex = i;	*pAHB = 1;		return SIM_GPIO;	}
+	}
+	for(i = 0; i < 12; i++)
+		if(page == TimerBase[i])		{	*pIndex = i;								return SIM_TIMER;	}
+
+	if(page >= SSI0_BASE_ADDRESS	&& page <= SSI3_BASE_ADDRESS)		{	*pIndex = (page - SSI0_BASE_ADDRESS)/SIM_PAGE;		return SIM_SSI;		}
+	if(page >= UART0_BASE_ADDRESS	&& page <= UART7_BASE_ADDRESS)	{	*pIndex = (page - UART0_BASE_ADDRESS)/SIM_PAGE;		return SIM_UART;	}
+	if(page >= I2C0_BASE_ADDRESS	&& page <= I2C3_BASE_ADDRESS)		{	*pIndex = (page - I2C0_BASE_ADDRESS)/SIM_PAGE;		return SIM_I2C;		}
+
+	return SIM_NONE;
+}
+
+
+
+/*	Returns 1 if the run mode clock of the module is enabled. */
+static uint8_t SimIsClocked(uint8_t type, uint8_t idx)
+{
+	switch(type)
+	{
+		case SIM_GPIO:		return GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, RCGCGPIO), idx );
+		case SIM_SSI:			return GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, RCGCSSI), idx );
+		case SIM_I2C:			return GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, RCGCI2C), idx );
+		case SIM_UART:		return GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, RCGCUART), idx );
+		case SIM_TIMER:		if(idx < 6)		return GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, RCGCTIMER), idx );
+											else					return GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, RCGCWTIMER), (idx-6) );
+		case SIM_DMA:			return GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, RCGCDMA), 0 );
+		default:					return 1;
+	}
+}
+
+
+
+/*------------------------------------------------ GPIO Model ---------------------------------------------------*/
+
+/*	Level of every pin of a port as seen on the pads. */
+static uint8_t SimGPIOPins(uint8_t port)
+{
+	uint32_t base = GPIOBaseAPB[port];
+	SimGPIO* g = &GPIOState[port];
+	uint8_t dir = REG(base, GPIO_reg, GPIO_DIR);
+	uint8_t pulled = REG(base, GPIO_reg, GPIO_PUR) & ~REG(base, GPIO_reg, GPIO_PDR);
+	uint8_t input = (g->In & g->Driven) | (pulled & ~g->Driven);
+
+	return (g->Out & dir) | (input & ~dir);
+}
+
+/*	Interrupt status of level-sensitive pins. */
+static uint8_t SimGPIOLevelRIS(uint8_t port)
+{
+	uint32_t base = GPIOBaseAPB[port];
+	uint8_t is = REG(base, GPIO_reg, GPIO_IS);
+	uint8_t iev = REG(base, GPIO_reg, GPIO_IEV);
+
+	return is & ~( SimGPIOPins(port) ^ iev );
+}
+
+/*	Latch edge interrupts for pins which changed from OldPins to the current level. */
+static void SimGPIOEdges(uint8_t port, uint8_t OldPins)
+{
+	uint32_t base = GPIOBaseAPB[port];
+	uint8_t NewPins = SimGPIOPins(port);
+	uint8_t edge = (OldPins ^ NewPins) & ~REG(base, GPIO_reg, GPIO_IS);
+	uint8_t ibe = REG(base, GPIO_reg, GPIO_IBE);
+	uint8_t iev = REG(base, GPIO_reg, GPIO_IEV);
+
+	GPIOState[port].RIS |= ( edge & ibe ) | ( edge & ~ibe & ~(NewPins ^ iev) );
+}
+
+static void SimGPIORefresh(uint8_t port, uint32_t offset, uint8_t destructive)
+{
+	uint32_t base = GPIOBaseAPB[port];
+	uint8_t ris = GPIOState[port].RIS | SimGPIOLevelRIS(port);
+
+	(void)destructive;
+
+	if(offset < OFFSET(GPIO_reg, GPIO_DIR))
+		*SimReg(base + offset) = SimGPIOPins(port) & ( (offset>>2) & 0xFF );
+	else if(offset == OFFSET(GPIO_reg, GPIO_RIS))
+		REG(base, GPIO_reg, GPIO_RIS) = ris;
+	else if(offset == OFFSET(GPIO_reg, GPIO_MIS))
+		REG(base, GPIO_reg, GPIO_MIS) = ris & REG(base, GPIO_reg, GPIO_IM);
+	else if(offset == OFFSET(GPIO_reg, GPIO_ICR))
+		REG(base, GPIO_reg, GPIO_ICR) = 0;
+	else if(offset == OFFSET(GPIO_reg, GPIO_LOCK))
+		REG(base, GPIO_reg, GPIO_LOCK) = GPIOState[port].Unlocked ? 0 : 1;
+}
+
+static void SimGPIOCommit(uint8_t port, uint32_t offset, uint32_t old)
+{
+	uint32_t base = GPIOBaseAPB[port];
+	uint32_t val = *SimReg(base + offset);
+	uint8_t pins = SimGPIOPins(port);
+
+	(void)old;
+
+	if(offset < OFFSET(GPIO_reg, GPIO_DIR))
+	{
+		uint8_t mask = (offset>>2) & 0xFF;													//	Address bits [9:2] select the bits to change.
+		GPIOState[port].Out = ( GPIOState[port].Out & ~mask ) | ( val & mask );
+		SimGPIOEdges(port, pins);
+	}
+	else if(offset == OFFSET(GPIO_reg, GPIO_ICR))
+	{
+		GPIOState[port].RIS &= ~val;
+		REG(base, GPIO_reg, GPIO_ICR) = 0;
+	}
+	else if(offset == OFFSET(GPIO_reg, GPIO_LOCK))
+		GPIOState[port].Unlocked = (val == SIM_GPIO_UNLOCK);
+	else if(offset == OFFSET(GPIO_reg, GPIO_DIR) || offset == OFFSET(GPIO_reg, GPIO_PUR) || offset == OFFSET(GPIO_reg, GPIO_PDR))
+		SimGPIOEdges(port, pins);
+}
+
+
+
+/*------------------------------------------------ UART Model ---------------------------------------------------*/
+
+static uint8_t SimUARTDepth(uint32_t base)
+{
+	return GET_BIT( REG(base, UART_Reg, LCRH), UART_LCRH_FEN ) ? 16 : 1;
+}
+
+static uint8_t SimUARTTxTrigger(uint32_t base)
+{
+	if( !GET_BIT( REG(base, UART_Reg, LCRH), UART_LCRH_FEN ) )		return 0;
+	return UARTFifoLevel[ REG(base, UART_Reg, IFLS) & 0x7 ];
+}
+
+static uint8_t SimUARTRxTrigger(uint32_t base)
+{
+	if( !GET_BIT( REG(base, UART_Reg, LCRH), UART_LCRH_FEN ) )		return 1;
+	return UARTFifoLevel[ (REG(base, UART_Reg, IFLS) >> 3) & 0x7 ];
+}
+
+static uint8_t SimUARTFrameBits(uint32_t base)
+{
+	uint32_t lcrh = REG(base, UART_Reg, LCRH);
+	return 1 + ( 5 + ((lcrh>>UART_LCRH_WLEN) & 0x3) ) + GET_BIT(lcrh, UART_LCRH_PEN) + ( GET_BIT(lcrh, UART_LCRH_STP2) ? 2 : 1 );
+}
+
+/*	Cycles taken by one frame: ClkDiv * (IBRD + FBRD/64) cycles per bit. */
+static uint64_t SimUARTFrameCycles(uint32_t base)
+{
+	uint64_t ClkDiv = GET_BIT( REG(base, UART_Reg, CTL), UART_CTL_HSE ) ? 8 : 16;
+	uint64_t Div64 = (REG(base, UART_Reg, IBRD) & 0xFFFF)*64 + (REG(base, UART_Reg, FBRD) & 0x3F);
+	uint64_t Cycles = ( ClkDiv * Div64 * SimUARTFrameBits(base) ) / 64;
+
+	return Cycles ? Cycles : 1;
+}
+
+/*	A frame has been shifted in on the Rx line (or looped back). */
+static void SimUARTReceive(uint8_t n, uint16_t frame)
+{
+	uint32_t base = UARTBase(n);
+	SimUART* u = &UARTState[n];
+	uint32_t addr = REG(base, UART_Reg, _9BITADDR);
+
+	if( GET_BIT(addr, UART_9BITADDR_9BITEN) )
+	{
+		if(frame & SIM_UART_ADDRESS)
+		{
+			u->Matched = ( (frame ^ addr) & REG(base, UART_Reg, _9BITAMASK) & 0xFF ) == 0;
+			if(u->Matched)		u->RIS |= 1<<UART_RIS_9BIT;
+		}
+		if(!u->Matched)		return;																		//	Addressed to another node.
+	}
+	frame &= ~SIM_UART_ADDRESS;
+
+	if( u->RxCount >= SimUARTDepth(base) )
+	{
+		u->PendingOE = 1;																						//	Data is lost, OE is reported with the next character.
+		u->RSR |= 1<<UART_RSR_OE;
+		u->RIS |= 1<<UART_RIS_OE;
+		return;
+	}
+	if(u->PendingOE)
+	{
+		frame |= 1<<UART_DR_OE;
+		u->PendingOE = 0;
+	}
+	u->Rx[ (u->RxHead + u->RxCount) & 0xF ] = frame;
+	u->RxCount++;
+	u->RxIdle = 0;
+
+	if( GET_BIT(frame, UART_DR_FE) )		u->RIS |= 1<<UART_RIS_FE;
+	if( GET_BIT(frame, UART_DR_PE) )		u->RIS |= 1<<UART_RIS_PE;
+	if( GET_BIT(frame, UART_DR_BE) )		u->RIS |= 1<<UART_RIS_BE;
+	if( u->RxCount >= SimUARTRxTrigger(base) )	u->RIS |= 1<<UART_RIS_RX;
+}
+
+/*	RTS output. With RTSEN it is de-asserted while the Rx FIFO is at or above the trigger level, else it follows CTL.RTS.
+*		The Rx line only honours it while RTSEN is set, like a sender whose CTS input is wired to it.
+*/
+static uint8_t SimUARTRTS(uint8_t n)
+{
+	uint32_t base = UARTBase(n);
+	uint32_t ctl = REG(base, UART_Reg, CTL);
+
+	if( GET_BIT(ctl, UART_CTL_RTSEN) )
+		return UARTState[n].RxCount < SimUARTRxTrigger(base);
+	return GET_BIT(ctl, UART_CTL_RTS);
+}
+
+/*	Rx line driven by a sender with its own rate (SimUARTSetLineBaud()). The frames are played bit by bit on the Rx pin,
+*	so that they can be timed through GPIO. At the end of a frame, the UART receives it if the pin is routed to it
+*	(AFSEL) and the receiver is on; with a framing error if the programmed rate is off by more than 4%. RTS is ignored.
+*	Returns the cycles at the end of the step during which the line was idle.
+*/
+static uint64_t SimUARTPlayLine(uint8_t n, uint64_t Cycles)
+{
+	uint32_t base = UARTBase(n);
+	uint32_t ctl = REG(base, UART_Reg, CTL);
+	SimUART* u = &UARTState[n];
+	uint8_t bits = SimUARTFrameBits(base);
+	uint8_t DataBits = 5 + ( (REG(base, UART_Reg, LCRH) >> UART_LCRH_WLEN) & 0x3 );
+	uint64_t LineFrame = ( (uint64_t)bits * SYS_CLK ) / u->LineBaud;
+	uint64_t UARTFrame = SimUARTFrameCycles(base);
+	uint8_t port = getPortName(UARTRxPin[n]);
+	uint8_t mask = 1 << getPinNumber(UARTRxPin[n]);
+	uint8_t pins = SimGPIOPins(port);
+	uint64_t idle = Cycles;
+	uint32_t bit;
+
+	while(u->LineCount)
+	{
+		if(LineFrame - u->LineAt > Cycles)
+		{
+			u->LineAt += Cycles;
+			idle = 0;
+			break;
+		}
+		Cycles -= LineFrame - u->LineAt;
+		idle = Cycles;
+		u->LineAt = 0;
+
+		if( GET_BIT(ctl, UART_CTL_UARTEN) && GET_BIT(ctl, UART_CTL_RXE) && (REG(GPIOBaseAPB[port], GPIO_reg, GPIO_AFSEL) & mask) )
+		{
+			uint64_t diff = (UARTFrame > LineFrame) ? UARTFrame - LineFrame : LineFrame - UARTFrame;
+			SimUARTReceive(n, u->Line[u->LineHead] | ( (diff*25 > LineFrame) ? (1<<UART_DR_FE) : 0 ));
+		}
+		u->LineHead = (u->LineHead + 1) % SIM_LINE_SIZE;
+		u->LineCount--;
+	}
+
+	//	Start bit low, data bits LSB first, then high (parity is not played).
+	GPIOState[port].Driven |= mask;
+	GPIOState[port].In |= mask;
+	if(u->LineCount)
+	{
+		bit = (uint32_t)( (u->LineAt * u->LineBaud) / SYS_CLK );
+		if( bit == 0 || (bit <= DataBits && !GET_BIT(u->Line[u->LineHead], (bit-1))) )
+			GPIOState[port].In &= ~mask;
+	}
+	SimGPIOEdges(port, pins);
+
+	return idle;
+}
+
+static void SimUARTStep(uint8_t n, uint64_t Cycles)
+{
+	uint32_t base = UARTBase(n);
+	uint32_t ctl = REG(base, UART_Reg, CTL);
+	SimUART* u = &UARTState[n];
+	uint64_t frame = SimUARTFrameCycles(base);
+	uint64_t t;
+	uint64_t idle = Cycles;
+
+	if(u->LineBaud)
+		idle = SimUARTPlayLine(n, Cycles);														//	The other side sends whether the UART listens or not.
+
+	if( !GET_BIT(ctl, UART_CTL_UARTEN) )	return;
+
+	//	Transmitter
+	t = Cycles;
+	while( GET_BIT(ctl, UART_CTL_TXE) )
+	{
+		if(!u->Shifting)
+		{
+			uint8_t trigger = SimUARTTxTrigger(base);
+			if(u->TxCount == 0)		break;
+			if( GET_BIT(ctl, UART_CTL_CTSEN) && u->CTSOff )		break;					//	Wait for CTS before starting a byte.
+
+			u->TxData = u->Tx[u->TxHead];																	//	Move the next byte into the shift register.
+			u->TxAddress = GET_BIT( REG(base, UART_Reg, _9BITADDR), UART_9BITADDR_9BITEN )		//	Stick parity 1 in 9-bit mode.
+								&& ( REG(base, UART_Reg, LCRH) & ((1<<UART_LCRH_PEN) | (1<<UART_LCRH_SPS) | (1<<UART_LCRH_EPS)) )
+										== ((1<<UART_LCRH_PEN) | (1<<UART_LCRH_SPS));
+			u->TxHead = (u->TxHead + 1) & 0xF;
+			u->TxCount--;
+			u->Shifting = 1;
+			u->TxLeft = frame;
+
+			if( !GET_BIT(ctl, UART_CTL_EOT) && (u->TxCount + 1) > trigger && u->TxCount <= trigger )
+				u->RIS |= 1<<UART_RIS_TX;																		//	Tx FIFO level has passed the trigger level.
+		}
+		if(u->TxLeft > t)
+		{
+			u->TxLeft -= t;
+			break;
+		}
+		t -= u->TxLeft;
+		u->Shifting = 0;
+
+		if( GET_BIT(ctl, UART_CTL_LBE) )
+			SimUARTReceive(n, u->TxData | (u->TxAddress ? SIM_UART_ADDRESS : 0));
+		else
+		{
+			u->Log[ (u->LogHead + u->LogCount) % SIM_LOG_SIZE ] = u->TxData;
+			if(u->LogCount < SIM_LOG_SIZE)		u->LogCount++;
+			else															u->LogHead = (u->LogHead + 1) % SIM_LOG_SIZE;
+		}
+		if( GET_BIT(ctl, UART_CTL_EOT) && u->TxCount == 0 )
+			u->RIS |= 1<<UART_RIS_TX;																			//	End of transmission.
+	}
+
+	//	Receiver
+	t = u->LineBaud ? idle : Cycles;
+	if( GET_BIT(ctl, UART_CTL_RXE) )
+	{
+		while(u->LineCount && !u->LineBaud)
+		{
+			if(u->RxLeft == 0)
+			{
+				if( GET_BIT(ctl, UART_CTL_RTSEN) && !SimUARTRTS(n) )		break;			//	The other side holds the next frame.
+				u->RxLeft = frame;
+			}
+			if(u->RxLeft > t)
+			{
+				u->RxLeft -= t;
+				t = 0;
+				break;
+			}
+			t -= u->RxLeft;
+			u->RxLeft = 0;
+			SimUARTReceive(n, u->Line[u->LineHead]);
+			u->LineHead = (u->LineHead + 1) % SIM_LINE_SIZE;
+			u->LineCount--;
+		}
+		if(u->RxCount)
+		{
+			u->RxIdle += t;
+			if( u->RxIdle >= 32*(frame/SimUARTFrameBits(base)) )				//	No data for 32 bit periods.
+				u->RIS |= 1<<UART_RIS_RT;
+		}
+	}
+}
+
+static void SimUARTRefresh(uint8_t n, uint32_t offset, uint8_t destructive)
+{
+	uint32_t base = UARTBase(n);
+	SimUART* u = &UARTState[n];
+
+	if(offset == OFFSET(UART_Reg, DR) && destructive)
+	{
+		if(u->RxCount)
+		{
+			uint16_t frame = u->Rx[u->RxHead];
+			u->RxHead = (u->RxHead + 1) & 0xF;
+			u->RxCount--;
+
+			REG(base, UART_Reg, DR) = frame;
+			u->RSR = ( u->RSR & (1<<UART_RSR_OE) ) | ( (frame>>8) & 0x7 );
+
+			if( u->RxCount < SimUARTRxTrigger(base) )		u->RIS &= ~(1<<UART_RIS_RX);
+			if( u->RxCount == 0 )												u->RIS &= ~(1<<UART_RIS_RT);
+		}
+		else
+			REG(base, UART_Reg, DR) = 0;
+	}
+	else if(offset == OFFSET(UART_Reg, RSR_ECR))
+		REG(base, UART_Reg, RSR_ECR) = u->RSR;
+	else if(offset == OFFSET(UART_Reg, FR))
+	{
+		uint8_t depth = SimUARTDepth(base);
+		uint32_t fr = u->CTSOff ? 0 : 1<<UART_FR_CTS;
+
+		if(u->Shifting || u->TxCount)			fr |= 1<<UART_FR_BUSY;
+		if(u->RxCount == 0)								fr |= 1<<UART_FR_RXFE;
+		if(u->TxCount >= depth)						fr |= 1<<UART_FR_TXFF;
+		if(u->RxCount >= depth)						fr |= 1<<UART_FR_RXFF;
+		if(u->TxCount == 0)								fr |= 1<<UART_FR_TXFE;
+		REG(base, UART_Reg, FR) = fr;
+	}
+	else if(offset == OFFSET(UART_Reg, RIS))
+		REG(base, UART_Reg, RIS) = u->RIS;
+	else if(offset == OFFSET(UART_Reg, MIS))
+		REG(base, UART_Reg, MIS) = u->RIS & REG(base, UART_Reg, IM);
+	else if(offset == OFFSET(UART_Reg, ICR))
+		REG(base, UART_Reg, ICR) = 0;
+	else if(offset == OFFSET(UART_Reg, PP))
+		REG(base, UART_Reg, PP) = (1<<UART_PP_SC) | (1<<UART_PP_NB);
+}
+
+static void SimUARTCommit(uint8_t n, uint32_t offset, uint32_t old)
+{
+	uint32_t base = UARTBase(n);
+	uint32_t val = *SimReg(base + offset);
+	SimUART* u = &UARTState[n];
+
+	(void)old;
+
+	if(offset == OFFSET(UART_Reg, DR))
+	{
+		if( u->TxCount < SimUARTDepth(base) )
+		{
+			u->Tx[ (u->TxHead + u->TxCount) & 0xF ] = (uint8_t)val;
+			u->TxCount++;
+		}
+		if( u->TxCount > SimUARTTxTrigger(base) )
+			u->RIS &= ~(1<<UART_RIS_TX);
+		SimUARTStep(n, 0);																							//	Start shifting if the transmitter is idle.
+	}
+	else if(offset == OFFSET(UART_Reg, RSR_ECR))
+		u->RSR = 0;
+	else if(offset == OFFSET(UART_Reg, ICR))
+	{
+		u->RIS &= ~val;
+		REG(base, UART_Reg, ICR) = 0;
+	}
+	else if(offset == OFFSET(UART_Reg, CTL))
+		SimUARTStep(n, 0);
+	else if(offset == OFFSET(UART_Reg, DMACTL))
+		SimDMAStep();																										//	The FIFOs may be requesting already.
+}
+
+
+
+/*------------------------------------------------- SSI Model ---------------------------------------------------*/
+
+static uint64_t SimSSIFrameCycles(uint32_t base)
+{
+	uint64_t cpsr = REG(base, ssi_reg, SSI_CPSR) & 0xFE;
+	uint64_t scr = ( REG(base, ssi_reg, SSI_CR[0]) >> SSI_CR0_SCR ) & 0xFF;
+	uint64_t bits = ( REG(base, ssi_reg, SSI_CR[0]) & 0xF ) + 1;
+
+	return (cpsr < 2 ? 2 : cpsr) * (1 + scr) * bits;
+}
+
+static void SimSSIStep(uint8_t n, uint64_t Cycles)
+{
+	uint32_t base = SSIBase(n);
+	SimSSI* s = &SSIState[n];
+	uint64_t frame = SimSSIFrameCycles(base);
+	uint16_t mask = (uint16_t)( (1U << ((REG(base, ssi_reg, SSI_CR[0]) & 0xF) + 1)) - 1 );
+	uint64_t t = Cycles;
+
+	if( !GET_BIT( REG(base, ssi_reg, SSI_CR[1]), SSI_CR1_SSE ) )		return;
+
+	for(;;)
+	{
+		uint16_t rx;
+
+		if(!s->Shifting)
+		{
+			if(s->TxCount == 0)		break;
+			s->TxData = s->Tx[s->TxHead];
+			s->TxHead = (s->TxHead + 1) & 0x7;
+			s->TxCount--;
+			s->Shifting = 1;
+			s->TxLeft = frame;
+		}
+		if(s->TxLeft > t)
+		{
+			s->TxLeft -= t;
+			t = 0;
+			break;
+		}
+		t -= s->TxLeft;
+		s->Shifting = 0;
+
+		s->Log[ (s->LogHead + s->LogCount) % SIM_LOG_SIZE ] = s->TxData & mask;
+		if(s->LogCount < SIM_LOG_SIZE)		s->LogCount++;
+		else															s->LogHead = (s->LogHead + 1) % SIM_LOG_SIZE;
+
+		if( GET_BIT( REG(base, ssi_reg, SSI_CR[1]), SSI_CR1_LBM ) )
+			rx = s->TxData;
+		else if(s->LineCount)
+		{
+			rx = s->Line[s->LineHead];
+			s->LineHead = (s->LineHead + 1) % SIM_LINE_SIZE;
+			s->LineCount--;
+		}
+		else
+			rx = 0;
+
+		if(s->RxCount < 8)
+		{
+			s->Rx[ (s->RxHead + s->RxCount) & 0x7 ] = rx & mask;
+			s->RxCount++;
+		}
+		else
+			s->RIS |= 1<<SSI_RIS_ROR;
+		s->RxIdle = 0;
+	}
+
+	if(s->RxCount)
+	{
+		s->RxIdle += t;
+		if( s->RxIdle >= 32*(frame/((REG(base, ssi_reg, SSI_CR[0]) & 0xF) + 1)) )
+			s->RIS |= 1<<SSI_RIS_RT;
+	}
+}
+
+static void SimSSIRefresh(uint8_t n, uint32_t offset, uint8_t destructive)
+{
+	uint32_t base = SSIBase(n);
+	SimSSI* s = &SSIState[n];
+	uint32_t ris = s->RIS | (s->TxCount <= 4 ? 1<<SSI_RIS_TX : 0) | (s->RxCount >= 4 ? 1<<SSI_RIS_RX : 0);
+
+	if(offset == OFFSET(ssi_reg, SSI_DR) && destructive)
+	{
+		if(s->RxCount)
+		{
+			REG(base, ssi_reg, SSI_DR) = s->Rx[s->RxHead];
+			s->RxHead = (s->RxHead + 1) & 0x7;
+			s->RxCount--;
+			if(s->RxCount == 0)		s->RIS &= ~(1<<SSI_RIS_RT);
+		}
+		else
+			REG(base, ssi_reg, SSI_DR) = 0;
+	}
+	else if(offset == OFFSET(ssi_reg, SSI_SR))
+	{
+		uint32_t sr = 0;
+		if(s->TxCount == 0)								sr |= 1<<SSI_SR_TFE;
+		if(s->TxCount < 8)								sr |= 1<<SSI_SR_TNF;
+		if(s->RxCount > 0)								sr |= 1<<SSI_SR_RNE;
+		if(s->RxCount == 8)								sr |= 1<<SSI_SR_RFF;
+		if(s->Shifting || s->TxCount)			sr |= 1<<SSI_SR_BSY;
+		REG(base, ssi_reg, SSI_SR) = sr;
+	}
+	else if(offset == OFFSET(ssi_reg, SSI_RIS))
+		REG(base, ssi_reg, SSI_RIS) = ris;
+	else if(offset == OFFSET(ssi_reg, SSI_MIS))
+		REG(base, ssi_reg, SSI_MIS) = ris & REG(base, ssi_reg, SSI_IM);
+	else if(offset == OFFSET(ssi_reg, SSI_ICR))
+		REG(base, ssi_reg, SSI_ICR) = 0;
+}
+
+static void SimSSICommit(uint8_t n, uint32_t offset, uint32_t old)
+{
+	uint32_t base = SSIBase(n);
+	uint32_t val = *SimReg(base + offset);
+	SimSSI* s = &SSIState[n];
+
+	(void)old;
+
+	if(offset == OFFSET(ssi_reg, SSI_DR))
+	{
+		if(s->TxCount < 8)
+		{
+			s->Tx[ (s->TxHead + s->TxCount) & 0x7 ] = (uint16_t)val;
+			s->TxCount++;
+		}
+		SimSSIStep(n, 0);
+	}
+	else if(offset == OFFSET(ssi_reg, SSI_ICR))
+	{
+		s->RIS &= ~( val & ((1<<SSI_ICR_RORIC) | (1<<SSI_ICR_RTIC)) );
+		REG(base, ssi_reg, SSI_ICR) = 0;
+	}
+	else if(offset == OFFSET(ssi_reg, SSI_CR[1]))
+		SimSSIStep(n, 0);
+}
+
+
+
+/*------------------------------------------------- I2C Model ---------------------------------------------------*/
+
+static void SimI2CStep(uint8_t n, uint64_t Cycles)
+{
+	uint32_t base = I2CBase(n);
+	SimI2C* c = &I2CState[n];
+
+	if(!c->Busy)		return;
+	if(c->Left > Cycles)
+	{
+		c->Left -= Cycles;
+		return;
+	}
+
+	c->Busy = 0;
+	c->Left = 0;
+
+	if( GET_BIT(c->Cmd, I2C_MCS_START) )
+	{
+		uint8_t addr = ( REG(base, I2C_reg, MSA) >> 1 ) & 0x7F;
+		c->BusBusy = 1;
+		if( GET_BIT(c->Nack[addr>>3], addr & 0x7) )
+		{
+			c->Error = 1;
+			c->AdrAck = 1;
+		}
+	}
+	if(!c->Error)
+	{
+		if( REG(base, I2C_reg, MSA) & 0x1 )																//	Master receive
+		{
+			if(c->LineCount)
+			{
+				REG(base, I2C_reg, MDR) = c->Line[c->LineHead];
+				c->LineHead = (c->LineHead + 1) % SIM_LINE_SIZE;
+				c->LineCount--;
+			}
+			else
+				REG(base, I2C_reg, MDR) = 0xFF;															//	Nobody drives SDA.
+		}
+		else																															//	Master transmit
+		{
+			c->Log[ (c->LogHead + c->LogCount) % SIM_LOG_SIZE ] = (uint8_t)REG(base, I2C_reg, MDR);
+			if(c->LogCount < SIM_LOG_SIZE)		c->LogCount++;
+			else															c->LogHead = (c->LogHead + 1) % SIM_LOG_SIZE;
+		}
+	}
+	if( GET_BIT(c->Cmd, I2C_MCS_STOP) )
+		c->BusBusy = 0;
+
+	c->MRIS |= 1<<I2C_MRIS_RIS;
+}
+
+static void SimI2CRefresh(uint8_t n, uint32_t offset, uint8_t destructive)
+{
+	uint32_t base = I2CBase(n);
+	SimI2C* c = &I2CState[n];
+
+	(void)destructive;
+
+	if(offset == OFFSET(I2C_reg, MCS))
+	{
+		uint32_t mcs = 0;
+		if(c->Busy)												mcs |= 1<<I2C_MCS_BUSY;
+		if(c->Error)											mcs |= 1<<I2C_MCS_ERROR;
+		if(c->AdrAck)											mcs |= 1<<I2C_MCS_ADRACK;
+		if(!c->Busy && !c->BusBusy)				mcs |= 1<<I2C_MCS_IDLE;
+		if(c->BusBusy)										mcs |= 1<<I2C_MCS_BUSBUSY;
+		REG(base, I2C_reg, MCS) = mcs;
+	}
+	else if(offset == OFFSET(I2C_reg, MRIS))
+		REG(base, I2C_reg, MRIS) = c->MRIS;
+	else if(offset == OFFSET(I2C_reg, MMIS))
+		REG(base, I2C_reg, MMIS) = c->MRIS & REG(base, I2C_reg, MIMR);
+	else if(offset == OFFSET(I2C_reg, MICR))
+		REG(base, I2C_reg, MICR) = 0;
+}
+
+static void SimI2CCommit(uint8_t n, uint32_t offset, uint32_t old)
+{
+	uint32_t base = I2CBase(n);
+	uint32_t val = *SimReg(base + offset);
+	SimI2C* c = &I2CState[n];
+
+	(void)old;
+
+	if(offset == OFFSET(I2C_reg, MCS))
+	{
+		if( !GET_BIT( REG(base, I2C_reg, MCR), I2C_MCR_MFE ) || c->Busy )		return;
+
+		if( GET_BIT(val, I2C_MCS_RUN) )
+		{
+			//	SCL period = 2 * (1 + TPR) * (SCL_LP + SCL_HP) with SCL_LP = 6 and SCL_HP = 4. 9 clocks per byte.
+			uint64_t bytes = GET_BIT(val, I2C_MCS_START) ? 2 : 1;
+			c->Cmd = val;
+			c->Busy = 1;
+			c->Error = 0;
+			c->AdrAck = 0;
+			c->Left = bytes * 9 * 20 * ( 1 + (REG(base, I2C_reg, MTPR) & 0x7F) );
+		}
+		else if( GET_BIT(val, I2C_MCS_STOP) )
+		{
+			c->BusBusy = 0;
+			c->Error = 0;
+		}
+	}
+	else if(offset == OFFSET(I2C_reg, MICR))
+	{
+		c->MRIS &= ~val;
+		REG(base, I2C_reg, MICR) = 0;
+	}
+}
+
+
+
+/*------------------------------------------------ Timer Model --------------------------------------------------*/
+
+/*	Width of the Timer A counter. Concatenated mode (CFG = 0) joins Timer A and Timer B. */
+static uint64_t SimTimerLimit(uint8_t n)
+{
+	uint32_t base = TimerBase[n];
+	uint8_t concat = (REG(base, Timer_Reg, CFG) & 0x7) == 0;
+	uint64_t ilr = REG(base, Timer_Reg, TAILR);
+
+	if(n >= 6)	return concat ? ( ((uint64_t)REG(base, Timer_Reg, TBILR) << 32) | ilr ) : ilr;
+	else				return concat ? ilr : (ilr & 0xFFFF);
+}
+
+static void SimTimerStep(uint8_t n, uint64_t Cycles)
+{
+	uint32_t base = TimerBase[n];
+	SimTimer* tm = &TimerState[n];
+	uint32_t tamr = REG(base, Timer_Reg, TAMR);
+	uint64_t limit = SimTimerLimit(n);
+	unsigned __int128 period = (unsigned __int128)limit + 1;
+	uint8_t up = GET_BIT(tamr, 4);																		//	TACDIR
+	uint64_t elapsed;
+
+	if( !GET_BIT( REG(base, Timer_Reg, CTL), 0 ) || Cycles == 0 )			return;
+
+	//	Cycles until the next time-out.
+	elapsed = up ? ( tm->Count >= limit ? 0 : limit - tm->Count ) : tm->Count;
+	if(Cycles <= elapsed)
+	{
+		tm->Count = up ? tm->Count + Cycles : tm->Count - Cycles;
+		return;
+	}
+
+	tm->RIS |= 1<<0;																									//	TATORIS
+	if( (tamr & 0x3) == 0x1 )																					//	One-shot: stop at the time-out.
+	{
+		REG(base, Timer_Reg, CTL) CLR_BIT(0);
+		tm->Count = up ? limit : 0;
+		return;
+	}
+	Cycles -= elapsed + 1;
+	Cycles = (uint64_t)( Cycles % period );
+	tm->Count = up ? Cycles : limit - Cycles;
+}
+
+static void SimTimerRefresh(uint8_t n, uint32_t offset, uint8_t destructive)
+{
+	uint32_t base = TimerBase[n];
+	SimTimer* tm = &TimerState[n];
+	uint8_t concat = (REG(base, Timer_Reg, CFG) & 0x7) == 0;
+
+	(void)destructive;
+
+	if(offset == OFFSET(Timer_Reg, TAV) || offset == OFFSET(Timer_Reg, TAR))
+		*SimReg(base + offset) = (uint32_t)tm->Count;
+	else if( (offset == OFFSET(Timer_Reg, TBV) || offset == OFFSET(Timer_Reg, TBR)) && concat && n >= 6 )
+		*SimReg(base + offset) = (uint32_t)(tm->Count >> 32);
+	else if(offset == OFFSET(Timer_Reg, RIS))
+		REG(base, Timer_Reg, RIS) = tm->RIS;
+	else if(offset == OFFSET(Timer_Reg, MIS))
+		REG(base, Timer_Reg, MIS) = tm->RIS & REG(base, Timer_Reg, IMR);
+	else if(offset == OFFSET(Timer_Reg, ICR))
+		REG(base, Timer_Reg, ICR) = 0;
+}
+
+static void SimTimerCommit(uint8_t n, uint32_t offset, uint32_t old)
+{
+	uint32_t base = TimerBase[n];
+	uint32_t val = *SimReg(base + offset);
+	SimTimer* tm = &TimerState[n];
+	uint8_t up = GET_BIT( REG(base, Timer_Reg, TAMR), 4 );
+	uint8_t tald = GET_BIT( REG(base, Timer_Reg, TAMR), 8 );						//	TAILD
+
+	if(offset == OFFSET(Timer_Reg, CTL))
+	{
+		if( GET_BIT(val, 0) && !GET_BIT(old, 0) && !tald )							//	Timer A enabled: start from the load value.
+			tm->Count = up ? 0 : SimTimerLimit(n);
+	}
+	else if(offset == OFFSET(Timer_Reg, TAILR) || offset == OFFSET(Timer_Reg, TBILR))
+	{
+		if( !GET_BIT( REG(base, Timer_Reg, CTL), 0 ) && !up && !tald )
+			tm->Count = SimTimerLimit(n);
+	}
+	else if(offset == OFFSET(Timer_Reg, TAV))
+		tm->Count = ( tm->Count & ~0xFFFFFFFFULL ) | val;
+	else if(offset == OFFSET(Timer_Reg, TBV) && n >= 6)
+		tm->Count = ( tm->Count & 0xFFFFFFFFULL ) | ( (uint64_t)val << 32 );
+	else if(offset == OFFSET(Timer_Reg, ICR))
+	{
+		tm->RIS &= ~val;
+		REG(base, Timer_Reg, ICR) = 0;
+	}
+}
+
+
+
+/*------------------------------------------------- uDMA Model --------------------------------------------------*/
+
+static void SimRefresh(uint8_t type, uint8_t idx, uint32_t offset, uint8_t destructive);
+static void SimCommit(uint8_t type, uint8_t idx, uint32_t offset, uint32_t old);
+
+/*	Host memory behind a bus address outside the register regions. NULL if nothing is mapped there. */
+static uint8_t* SimBusToHost(uint32_t addr, uint32_t Size)
+{
+	uint32_t slot;
+
+	if(addr < SIM_FLASH_SIZE && addr + Size <= SIM_FLASH_SIZE)
+		return SimFlashRegion + addr;
+
+	if(addr < SRAM_BASE_ADDR)		return NULL;
+	slot = (addr - SRAM_BASE_ADDR) / SIM_BUS_WINDOW;
+	if(slot >= BusWindowCount)	return NULL;
+
+	return (uint8_t*)( BusWindow[slot] * SIM_BUS_WINDOW ) + ( (addr - SRAM_BASE_ADDR) % SIM_BUS_WINDOW );
+}
+
+/*	Register behind a bus address. Returns 0 if the address is not in a register region. */
+static uint8_t SimBusIsRegister(uint32_t addr)
+{
+	return	( addr >= PERIPHERAL_BASE_ADDR && addr - PERIPHERAL_BASE_ADDR < SIM_PERIPH_SIZE )	||
+					( addr >= CORE_PERIPHERAL_BASE_ADDR && addr - CORE_PERIPHERAL_BASE_ADDR < SIM_CORE_SIZE );
+}
+
+/*	Accesses made by the controller. Registers see them like accesses of the CPU, but they are not counted in the
+*		statistics. Returns 0 on a bus error (nothing mapped, or the clock of the module is off). */
+static uint8_t SimBusRead(uint32_t addr, uint8_t Size, uint32_t* pValue)
+{
+	uint8_t* p;
+
+	*pValue = 0;
+	if( SimBusIsRegister(addr) )
+	{
+		uint32_t reg = addr & ~0x3U;
+		uint8_t type, idx, ahb;
+
+		type = SimIdentify(reg, &idx, &ahb);
+		if( !SimIsClocked(type, idx) )		return 0;
+		SimRefresh(type, idx, reg & (SIM_PAGE-1), 1);
+		memcpy(pValue, (uint8_t*)SimReg(reg) + (addr & 0x3), Size);
+		return 1;
+	}
+
+	p = SimBusToHost(addr, Size);
+	if(p == NULL)		return 0;
+	memcpy(pValue, p, Size);
+	return 1;
+}
+
+static uint8_t SimBusWrite(uint32_t addr, uint8_t Size, uint32_t Value)
+{
+	uint8_t* p;
+
+	if( SimBusIsRegister(addr) )
+	{
+		uint32_t reg = addr & ~0x3U;
+		uint8_t type, idx, ahb;
+		uint32_t old;
+
+		type = SimIdentify(reg, &idx, &ahb);
+		if( !SimIsClocked(type, idx) )		return 0;
+		SimRefresh(type, idx, reg & (SIM_PAGE-1), 0);
+		old = *SimReg(reg);
+		memcpy((uint8_t*)SimReg(reg) + (addr & 0x3), &Value, Size);
+		SimCommit(type, idx, reg & (SIM_PAGE-1), old);
+		return 1;
+	}
+
+	p = SimBusToHost(addr, Size);
+	if(p == NULL)		return 0;
+	memcpy(p, &Value, Size);
+	return 1;
+}
+
+/*	UART which owns a channel with the current DMACHMAPn encoding, -1 if none. pTx returns 1 for a Tx channel. */
+static int8_t SimDMAUART(uint8_t ch, uint8_t* pTx)
+{
+	uint32_t map = *SimReg( DMA_BASE_ADDR + OFFSET(DMA_Reg, CHMAP) + (ch/8)*4 );
+	uint8_t enc = ( map >> ((ch%8)*4) ) & 0xF;
+	uint8_t n;
+
+	for(n = 0; n < 8; n++)
+	{
+		if(enc != UARTDMAEnc[n])		continue;
+		if(ch == UARTDMARx[n])			{	*pTx = 0;		return n;	}
+		if(ch == UARTDMATx[n])			{	*pTx = 1;		return n;	}
+	}
+	return -1;
+}
+
+/*	Request on a channel: 0 => none, 1 => single, 2 => burst. */
+static uint8_t SimDMARequest(uint8_t ch)
+{
+	uint32_t bit = 1U << ch;
+	uint8_t single, burst, Tx;
+	uint32_t base;
+	SimUART* u;
+	int8_t n;
+
+	if( !(DMAState.Enable & bit) )										return 0;
+	if( (DMAState.SwReq | DMAState.Running) & bit )		return 2;
+	if( DMAState.ReqMask & bit )											return 0;
+
+	n = SimDMAUART(ch, &Tx);
+	if(n < 0)		return 0;
+
+	base = UARTBase(n);
+	u = &UARTState[n];
+	if( !SimIsClocked(SIM_UART, n) || !GET_BIT( REG(base, UART_Reg, CTL), UART_CTL_UARTEN ) )		return 0;
+	if( !GET_BIT( REG(base, UART_Reg, DMACTL), (Tx ? UART_DMACTL_TXDMAE : UART_DMACTL_RXDMAE) ) )	return 0;
+
+	if(Tx)
+	{
+		single = u->TxCount < SimUARTDepth(base);
+		burst = u->TxCount <= SimUARTTxTrigger(base);
+	}
+	else
+	{
+		single = u->RxCount > 0;
+		burst = u->RxCount >= SimUARTRxTrigger(base);
+	}
+
+	if(burst)																				return 2;
+	if( single && !(DMAState.UseBurst & bit) )			return 1;
+	return 0;
+}
+
+/*	The channel is done: disable it and report it in DMACHIS. */
+static void SimDMAComplete(uint32_t bit)
+{
+	DMAState.Enable &= ~bit;
+	DMAState.Running &= ~bit;
+	DMAState.ChIS |= bit;
+}
+
+/*	Run one arbitration of a channel: move up to 2^ARBSIZE items (or all of them for auto/memory scatter-gather
+*		transfers) and update the control word in the control table, the way the controller does. */
+static void SimDMAService(uint8_t ch, uint8_t req)
+{
+	uint32_t bit = 1U << ch;
+	uint8_t alt = (DMAState.Alt & bit) ? 1 : 0;
+	uint32_t entry = REG(DMA_BASE_ADDR, DMA_Reg, CTLBASE) + (alt ? 0x200 : 0) + ch*16;
+	DMAControl* e = (DMAControl*)SimBusToHost(entry, sizeof(DMAControl));
+	uint32_t ctl, n, arb, count, value;
+	uint8_t mode, size, sinc, dinc;
+
+	DMAState.SwReq &= ~bit;
+	if(e == NULL)
+	{
+		DMAState.Err = 1;
+		DMAState.Enable &= ~bit;
+		DMAState.Running &= ~bit;
+		return;
+	}
+
+	ctl = e->Control;
+	mode = ctl & 0x7;
+	if(mode == DMA_Mode_Stop)
+	{
+		SimDMAComplete(bit);
+		return;
+	}
+
+	n = ( (ctl >> DMA_CHCTL_XFERSIZE) & 0x3FF ) + 1;
+	arb = 1U << ( (ctl >> DMA_CHCTL_ARBSIZE) & 0xF );
+	size = 1 << ( (ctl >> DMA_CHCTL_DSTSIZE) & 0x3 );
+	sinc = (ctl >> DMA_CHCTL_SRCINC) & 0x3;
+	dinc = (ctl >> DMA_CHCTL_DSTINC) & 0x3;
+
+	switch(mode)
+	{
+		case DMA_Mode_Auto:
+		case DMA_Mode_MemSG:
+		case DMA_Mode_MemSGAlt:		count = n;
+															DMAState.Running |= bit;
+															break;
+		case DMA_Mode_PeriphSG:		count = (n < arb) ? n : arb;
+															break;
+		default:									count = (req == 2) ? ( (n < arb) ? n : arb ) : 1;
+															break;
+	}
+
+	while(count--)
+	{
+		uint32_t src = e->SrcEnd - ( sinc == DMA_Inc_None ? 0 : (n-1) << sinc );
+		uint32_t dst = e->DstEnd - ( dinc == DMA_Inc_None ? 0 : (n-1) << dinc );
+
+		if(mode == DMA_Mode_MemSG || mode == DMA_Mode_PeriphSG)
+			dst = e->DstEnd - ( ((n-1) % 4) << 2 );																//	Every task lands on the alternate structure.
+
+		if( !SimBusRead(src, size, &value) || !SimBusWrite(dst, size, value) )
+		{
+			DMAState.Err = 1;
+			DMAState.Enable &= ~bit;
+			DMAState.Running &= ~bit;
+			return;
+		}
+		n--;
+
+		if( (mode == DMA_Mode_MemSG || mode == DMA_Mode_PeriphSG) && n % 4 == 0 )
+			break;																											//	A task has been copied into the alternate structure.
+	}
+
+	if(n)
+	{
+		e->Control = ( ctl & ~(0x3FFU << DMA_CHCTL_XFERSIZE) ) | ( (n-1) << DMA_CHCTL_XFERSIZE );
+		if(mode == DMA_Mode_MemSG || mode == DMA_Mode_PeriphSG)
+			DMAState.Alt |= bit;
+		return;
+	}
+
+	e->Control = ctl & ~( (0x3FFU << DMA_CHCTL_XFERSIZE) | 0x7 );							//	Mode becomes Stop.
+
+	switch(mode)
+	{
+		case DMA_Mode_Basic:
+		case DMA_Mode_Auto:				SimDMAComplete(bit);
+															break;
+
+		case DMA_Mode_PingPong:		DMAState.ChIS |= bit;
+															DMAState.Alt ^= bit;
+															e = (DMAControl*)SimBusToHost(entry ^ 0x200, sizeof(DMAControl));
+															if( e == NULL || (e->Control & 0x7) == DMA_Mode_Stop )
+															{
+																DMAState.Enable &= ~bit;									//	The other half has not been set up again.
+																DMAState.Running &= ~bit;
+															}
+															break;
+
+		case DMA_Mode_MemSG:
+		case DMA_Mode_PeriphSG:		DMAState.Alt |= bit;												//	Run the last task.
+															break;
+
+		case DMA_Mode_MemSGAlt:
+		case DMA_Mode_PeriphSGAlt:	DMAState.Alt &= ~bit;											//	Fetch the next task.
+																break;
+	}
+}
+
+/*****************************************************************************************************************
+* @SimDMAStep()																																																		*
+* @brief		-	Serve the channels which are requesting, highest priority (PRIOSET, then lowest channel number) first,	*
+*							until no enabled channel is requesting. Called whenever the FIFOs or the channels may have changed.	*
+******************************************************************************************************************/
+static void SimDMAStep(void)
+{
+	uint32_t i;
+
+	if( DMAState.Busy || !DMAState.Master || !DMAState.Enable || !SimIsClocked(SIM_DMA, 0) )		return;
+	DMAState.Busy = 1;																								//	Accesses made below come back here.
+
+	for(i = 0; i < SIM_DMA_MAX_SERVICE; i++)
+	{
+		int8_t Next = -1;
+		uint8_t NextReq = 0, ch, req;
+
+		for(ch = 0; ch < 32; ch++)
+		{
+			req = SimDMARequest(ch);
+			if(!req)		continue;
+			if( Next < 0 || ( ((DMAState.Prio >> ch) & 1) && !((DMAState.Prio >> Next) & 1) ) )
+			{
+				Next = ch;
+				NextReq = req;
+			}
+		}
+		if(Next < 0)		break;
+		SimDMAService(Next, NextReq);
+	}
+
+	DMAState.Busy = 0;
+}
+
+static void SimDMARefresh(uint32_t offset)
+{
+	uint32_t base = DMA_BASE_ADDR;
+
+	if(offset == OFFSET(DMA_Reg, STAT))
+		REG(base, DMA_Reg, STAT) = (DMAState.Master << DMA_STAT_MASTEN) | (31U << DMA_STAT_DMACHANS);
+	else if(offset == OFFSET(DMA_Reg, ALTBASE))
+		REG(base, DMA_Reg, ALTBASE) = REG(base, DMA_Reg, CTLBASE) + 0x200;
+	else if(offset == OFFSET(DMA_Reg, USEBURSTSET))		REG(base, DMA_Reg, USEBURSTSET)	= DMAState.UseBurst;
+	else if(offset == OFFSET(DMA_Reg, REQMASKSET))		REG(base, DMA_Reg, REQMASKSET)	= DMAState.ReqMask;
+	else if(offset == OFFSET(DMA_Reg, ENASET))				REG(base, DMA_Reg, ENASET)			= DMAState.Enable;
+	else if(offset == OFFSET(DMA_Reg, ALTSET))				REG(base, DMA_Reg, ALTSET)			= DMAState.Alt;
+	else if(offset == OFFSET(DMA_Reg, PRIOSET))				REG(base, DMA_Reg, PRIOSET)			= DMAState.Prio;
+	else if(offset == OFFSET(DMA_Reg, ERRCLR))				REG(base, DMA_Reg, ERRCLR)			= DMAState.Err;
+	else if(offset == OFFSET(DMA_Reg, CHIS))					REG(base, DMA_Reg, CHIS)				= DMAState.ChIS;
+	else if(offset == OFFSET(DMA_Reg, CFG)		|| offset == OFFSET(DMA_Reg, SWREQ)
+			 || offset == OFFSET(DMA_Reg, USEBURSTCLR)	|| offset == OFFSET(DMA_Reg, REQMASKCLR)
+			 || offset == OFFSET(DMA_Reg, ENACLR)				|| offset == OFFSET(DMA_Reg, ALTCLR)
+			 || offset == OFFSET(DMA_Reg, PRIOCLR) )
+		*SimReg(base + offset) = 0;																			//	Write-only registers.
+}
+
+static void SimDMACommit(uint32_t offset)
+{
+	uint32_t base = DMA_BASE_ADDR;
+	uint32_t val = *SimReg(base + offset);
+
+	if(offset == OFFSET(DMA_Reg, CFG))								DMAState.Master = GET_BIT(val, DMA_CFG_MASTEN);
+	else if(offset == OFFSET(DMA_Reg, CTLBASE))				REG(base, DMA_Reg, CTLBASE) = val & ~0x3FFU;
+	else if(offset == OFFSET(DMA_Reg, SWREQ))					DMAState.SwReq			|= val;
+	else if(offset == OFFSET(DMA_Reg, USEBURSTSET))		DMAState.UseBurst		|= val;
+	else if(offset == OFFSET(DMA_Reg, USEBURSTCLR))		DMAState.UseBurst		&= ~val;
+	else if(offset == OFFSET(DMA_Reg, REQMASKSET))		DMAState.ReqMask		|= val;
+	else if(offset == OFFSET(DMA_Reg, REQMASKCLR))		DMAState.ReqMask		&= ~val;
+	else if(offset == OFFSET(DMA_Reg, ENASET))				DMAState.Enable			|= val;
+	else if(offset == OFFSET(DMA_Reg, ALTSET))				DMAState.Alt				|= val;
+	else if(offset == OFFSET(DMA_Reg, ALTCLR))				DMAState.Alt				&= ~val;
+	else if(offset == OFFSET(DMA_Reg, PRIOSET))				DMAState.Prio				|= val;
+	else if(offset == OFFSET(DMA_Reg, PRIOCLR))				DMAState.Prio				&= ~val;
+	else if(offset == OFFSET(DMA_Reg, CHIS))					DMAState.ChIS				&= ~val;
+	else if(offset == OFFSET(DMA_Reg, ERRCLR))
+	{
+		if( GET_BIT(val, DMA_ERRCLR_ERRCLR) )		DMAState.Err = 0;
+	}
+	else if(offset == OFFSET(DMA_Reg, ENACLR))
+	{
+		DMAState.Enable		&= ~val;
+		DMAState.Running	&= ~val;
+		DMAState.SwReq		&= ~val;
+	}
+
+	SimDMAStep();
+}
+
+
+
+/*---------------------------------------------- SYSCTL / NVIC Model --------------------------------------------*/
+
+static void SimResetModule(uint8_t type, uint8_t idx);
+
+static void SimSysCtlRefresh(uint32_t offset)
+{
+	uint32_t base = SYSTEM_CONTROL_BASE_ADDR;
+
+	if(offset == OFFSET(SYSCTL_reg, PRGPIO))			REG(base, SYSCTL_reg, PRGPIO)		= REG(base, SYSCTL_reg, RCGCGPIO);
+	if(offset == OFFSET(SYSCTL_reg, PRTIMER))			REG(base, SYSCTL_reg, PRTIMER)	= REG(base, SYSCTL_reg, RCGCTIMER);
+	if(offset == OFFSET(SYSCTL_reg, PRWTIMER))		REG(base, SYSCTL_reg, PRWTIMER)	= REG(base, SYSCTL_reg, RCGCWTIMER);
+	if(offset == OFFSET(SYSCTL_reg, PRUART))			REG(base, SYSCTL_reg, PRUART)		= REG(base, SYSCTL_reg, RCGCUART);
+	if(offset == OFFSET(SYSCTL_reg, PRSSI))				REG(base, SYSCTL_reg, PRSSI)		= REG(base, SYSCTL_reg, RCGCSSI);
+	if(offset == OFFSET(SYSCTL_reg, PRI2C))				REG(base, SYSCTL_reg, PRI2C)		= REG(base, SYSCTL_reg, RCGCI2C);
+	if(offset == OFFSET(SYSCTL_reg, PRDMA))				REG(base, SYSCTL_reg, PRDMA)		= REG(base, SYSCTL_reg, RCGCDMA);
+}
+
+static void SimSysCtlCommit(uint32_t offset, uint32_t old)
+{
+	uint32_t val = *SimReg(SYSTEM_CONTROL_BASE_ADDR + offset);
+	uint32_t set = val & ~old;																				//	Reset is applied when a bit is set.
+	uint8_t i;
+
+	for(i = 0; i < 12; i++)
+	{
+		if( !GET_BIT(set, i) )		continue;
+		if(offset == OFFSET(SYSCTL_reg, SRGPIO)		&& i < 6)		SimResetModule(SIM_GPIO, i);
+		if(offset == OFFSET(SYSCTL_reg, SRSSI)		&& i < 4)		SimResetModule(SIM_SSI, i);
+		if(offset == OFFSET(SYSCTL_reg, SRI2C)		&& i < 4)		SimResetModule(SIM_I2C, i);
+		if(offset == OFFSET(SYSCTL_reg, SRUART)		&& i < 8)		SimResetModule(SIM_UART, i);
+		if(offset == OFFSET(SYSCTL_reg, SRTIMER)	&& i < 6)		SimResetModule(SIM_TIMER, i);
+		if(offset == OFFSET(SYSCTL_reg, SRWTIMER)	&& i < 6)		SimResetModule(SIM_TIMER, i+6);
+		if(offset == OFFSET(SYSCTL_reg, SRDMA)		&& i < 1)		SimResetModule(SIM_DMA, i);
+	}
+}
+
+/*	NVIC register pairs: EN/DIS, PEND/UNPEND at 0x80 apart, five registers each. */
+static void SimNVICRefresh(uint32_t offset)
+{
+	uint32_t nvic = NVIC_BASE_ADDR - CORE_PERIPHERAL_BASE_ADDR;
+	uint32_t i;
+
+	if(offset < nvic || offset >= nvic + OFFSET(NVIC_reg, PRI))		return;
+	offset -= nvic;
+	i = (offset & 0x7F) / 4;
+	if(i >= 5)		return;
+
+	if(offset < OFFSET(NVIC_reg, PEND))
+		*SimReg(NVIC_BASE_ADDR + offset) = NVICEnabled[i];
+	else if(offset < OFFSET(NVIC_reg, ACTIVE))
+	{
+		SimUpdateLines();																					//	A line which is requesting is pending, enabled or not
+		*SimReg(NVIC_BASE_ADDR + offset) = NVICPending[i];
+	}
+	else
+		*SimReg(NVIC_BASE_ADDR + offset) = NVICActive[i];
+}
+
+static void SimNVICCommit(uint32_t offset)
+{
+	uint32_t nvic = NVIC_BASE_ADDR - CORE_PERIPHERAL_BASE_ADDR;
+	uint32_t val = *SimReg(CORE_PERIPHERAL_BASE_ADDR + offset);
+	uint32_t i;
+
+	if(offset == nvic + OFFSET(NVIC_reg, SWTRIG))
+	{
+		if( (val & 0xFF) < SIM_IRQ_COUNT )		NVICPending[(val & 0xFF)/32] |= 1U << (val & 0x1F);
+		return;
+	}
+	if(offset < nvic || offset >= nvic + OFFSET(NVIC_reg, ACTIVE))		return;
+	offset -= nvic;
+	i = (offset & 0x7F) / 4;
+	if(i >= 5)		return;
+
+	if(offset < OFFSET(NVIC_reg, DIS))					NVICEnabled[i] |= val;
+	else if(offset < OFFSET(NVIC_reg, PEND))		NVICEnabled[i] &= ~val;
+	else if(offset < OFFSET(NVIC_reg, UNPEND))	NVICPending[i] |= val;
+	else																				NVICPending[i] &= ~val;
+}
+
+
+
+/*****************************************************************************************************************
+* @SimResetModule()																																																*
+* @brief		-	Put the registers and the state of one module back to their reset values.														*
+* @type			-	Module type (SIM_xxx).																																							*
+* @idx			-	Index of the module.																																								*
+******************************************************************************************************************/
+static void SimResetModule(uint8_t type, uint8_t idx)
+{
+	uint32_t base;
+
+	switch(type)
+	{
+		case SIM_GPIO:	base = GPIOBaseAPB[idx];
+										memset((void*)SimReg(base), 0, SIM_PAGE);
+										memset(&GPIOState[idx], 0, sizeof(SimGPIO));
+										REG(base, GPIO_reg, GPIO_DR2R)	= 0xFF;
+										REG(base, GPIO_reg, GPIO_LOCK)	= 1;
+										REG(base, GPIO_reg, GPIO_CR)		= (idx == GPIO_PORT_D) ? 0x7F : (idx == GPIO_PORT_F) ? 0xFE : 0xFF;
+										if(idx == GPIO_PORT_C)																	//	PC[3:0] come out of reset as JTAG.
+										{
+											REG(base, GPIO_reg, GPIO_AFSEL)	= 0x0F;
+											REG(base, GPIO_reg, GPIO_DEN)		= 0x0F;
+											REG(base, GPIO_reg, GPIO_PUR)		= 0x0F;
+											REG(base, GPIO_reg, GPIO_PCTL)	= 0x1111;
+										}
+										break;
+
+		case SIM_UART:	base = UARTBase(idx);
+										memset((void*)SimReg(base), 0, SIM_PAGE);
+										memset(&UARTState[idx], 0, sizeof(SimUART));
+										REG(base, UART_Reg, CTL)	= (1<<UART_CTL_TXE) | (1<<UART_CTL_RXE);
+										REG(base, UART_Reg, IFLS)	= 0x12;
+										REG(base, UART_Reg, _9BITAMASK)	= 0xFF;
+										break;
+
+		case SIM_SSI:		base = SSIBase(idx);
+										memset((void*)SimReg(base), 0, SIM_PAGE);
+										memset(&SSIState[idx], 0, sizeof(SimSSI));
+										break;
+
+		case SIM_I2C:		base = I2CBase(idx);
+										memset((void*)SimReg(base), 0, SIM_PAGE);
+										{
+											uint8_t Nack[16];																		//	Attached slaves survive a module reset.
+											memcpy(Nack, I2CState[idx].Nack, sizeof(Nack));
+											memset(&I2CState[idx], 0, sizeof(SimI2C));
+											memcpy(I2CState[idx].Nack, Nack, sizeof(Nack));
+										}
+										break;
+
+		case SIM_TIMER:	base = TimerBase[idx];
+										memset((void*)SimReg(base), 0, SIM_PAGE);
+										memset(&TimerState[idx], 0, sizeof(SimTimer));
+										REG(base, Timer_Reg, TAILR) = 0xFFFFFFFF;
+										REG(base, Timer_Reg, TBILR) = (idx >= 6) ? 0xFFFFFFFF : 0xFFFF;
+										TimerState[idx].Count = SimTimerLimit(idx);
+										break;
+
+		case SIM_DMA:		memset((void*)SimReg(DMA_BASE_ADDR), 0, SIM_PAGE);
+										memset(&DMAState, 0, sizeof(SimDMA));
+										REG(DMA_BASE_ADDR, DMA_Reg, PeriphID0)	= 0x30;
+										REG(DMA_BASE_ADDR, DMA_Reg, PeriphID1)	= 0xB2;
+										REG(DMA_BASE_ADDR, DMA_Reg, PeriphID2)	= 0x0B;
+										REG(DMA_BASE_ADDR, DMA_Reg, PeriphID4)	= 0x04;
+										REG(DMA_BASE_ADDR, DMA_Reg, PCellID0)		= 0x0D;
+										REG(DMA_BASE_ADDR, DMA_Reg, PCellID1)		= 0xF0;
+										REG(DMA_BASE_ADDR, DMA_Reg, PCellID2)		= 0x05;
+										REG(DMA_BASE_ADDR, DMA_Reg, PCellID3)		= 0xB1;
+										break;
+	}
+}
+
+
+
+/*****************************************************************************************************************
+* @SimRefresh() / @SimCommit()																																										*
+* @brief				-	Called before (Refresh) and after (Commit) every trapped register access.												*
+*									Refresh writes the current value of computed registers into memory before they are read.				*
+*									Commit applies the side effects of a write.																											*
+* @destructive	-	1 if the access is a read which has side effects (FIFO pop etc.).																*
+******************************************************************************************************************/
+static void SimRefresh(uint8_t type, uint8_t idx, uint32_t offset, uint8_t destructive)
+{
+	switch(type)
+	{
+		case SIM_SYSCTL:	SimSysCtlRefresh(offset);										break;
+		case SIM_NVIC:		SimNVICRefresh(offset);											break;
+		case SIM_GPIO:		SimGPIORefresh(idx, offset, destructive);		break;
+		case SIM_UART:		SimUARTRefresh(idx, offset, destructive);		break;
+		case SIM_SSI:			SimSSIRefresh(idx, offset, destructive);		break;
+		case SIM_I2C:			SimI2CRefresh(idx, offset, destructive);		break;
+		case SIM_TIMER:		SimTimerRefresh(idx, offset, destructive);	break;
+		case SIM_DMA:			SimDMARefresh(offset);											break;
+	}
+}
+
+static void SimCommit(uint8_t type, uint8_t idx, uint32_t offset, uint32_t old)
+{
+	switch(type)
+	{
+		case SIM_SYSCTL:	SimSysCtlCommit(offset, old);								break;
+		case SIM_NVIC:		SimNVICCommit(offset);											break;
+		case SIM_GPIO:		SimGPIOCommit(idx, offset, old);						break;
+		case SIM_UART:		SimUARTCommit(idx, offset, old);						break;
+		case SIM_SSI:			SimSSICommit(idx, offset, old);							break;
+		case SIM_I2C:			SimI2CCommit(idx, offset, old);							break;
+		case SIM_TIMER:		SimTimerCommit(idx, offset, old);						break;
+		case SIM_DMA:			SimDMACommit(offset);												break;
+	}
+}
+
+
+
+/*****************************************************************************************************************
+* @SimFault()																																																			*
+* @brief		-	SIGSEGV handler. Runs before a driver instruction touches a register. The register is counted and		*
+*							refreshed, its page is opened, and the Trap Flag is set so that SimStep() runs right after the			*
+*							instruction has completed.																																					*
+******************************************************************************************************************/
+static void SimFault(int sig, siginfo_t* info, void* context)
+{
+	ucontext_t* uc = (ucontext_t*)context;
+	uint8_t* fault = (uint8_t*)info->si_addr;
+	SimAccess* a;
+	uint32_t offset, addr, page;
+	uint8_t type, idx, ahb;
+
+	(void)sig;
+
+	if( SimPeriphRegion == NULL || fault < SimPeriphRegion || fault >= SimPeriphRegion + SIM_TRAP_SIZE
+			|| PendingCount >= SIM_MAX_PENDING )
+	{
+		signal(SIGSEGV, SIG_DFL);																				//	Not a register access: let it crash.
+		return;
+	}
+
+	offset = (uint32_t)(fault - SimPeriphRegion) & ~0x3U;
+	addr = (offset < SIM_PERIPH_SIZE) ? PERIPHERAL_BASE_ADDR + offset
+																		: CORE_PERIPHERAL_BASE_ADDR + (offset - SIM_PERIPH_SIZE);
+	page = addr & ~(SIM_PAGE-1);
+
+	a = &Pending[PendingCount++];
+	a->Page = SimPeriphRegion + (offset & ~(SIM_PAGE-1));
+	a->Address = addr;
+	a->Write = ( uc->uc_mcontext.gregs[REG_ERR] & SIM_PF_WRITE ) ? 1 : 0;
+	a->Ignore = 0;
+
+	if(a->Write)		{	Stats.Writes++;		WriteCount[offset/4]++;		}
+	else						{	Stats.Reads++;		ReadCount[offset/4]++;		}
+
+	SimAdvance(SimCyclesPerAccess);
+
+	type = SimIdentify(addr, &idx, &ahb);
+	if( !SimIsClocked(type, idx)
+			|| ( type == SIM_GPIO && ahb != GET_BIT( REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, GPIOHBCTL), idx ) ) )
+	{
+		Stats.BusFaults++;																							//	The access would fault on the target. RAZ/WI here.
+		a->Ignore = 1;
+		a->Old = *SimReg(addr);
+		*SimReg(addr) = 0;
+	}
+	else
+	{
+		SimRefresh(type, idx, addr - page, !a->Write);
+		a->Old = *SimReg(addr);
+	}
+
+	mprotect(a->Page, SIM_PAGE, PROT_READ | PROT_WRITE);
+	uc->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+
+
+
+/*****************************************************************************************************************
+* @SimStep()																																																			*
+* @brief		-	SIGTRAP handler. Runs after every single-stepped instruction. Applies the side effects of trapped		*
+*							writes, closes the pages again, and counts instructions between SimMeasureBegin/End().							*
+******************************************************************************************************************/
+static void SimStep(int sig, siginfo_t* info, void* context)
+{
+	ucontext_t* uc = (ucontext_t*)context;
+	uint8_t i;
+
+	(void)sig;
+	(void)info;
+
+	for(i = 0; i < PendingCount; i++)
+	{
+		SimAccess* a = &Pending[i];
+		uint8_t type, idx, ahb;
+
+		if(a->Ignore)
+			*SimReg(a->Address) = a->Old;
+		else if(a->Write)
+		{
+			type = SimIdentify(a->Address, &idx, &ahb);
+			SimCommit(type, idx, a->Address & (SIM_PAGE-1), a->Old);
+		}
+		mprotect(a->Page, SIM_PAGE, PROT_NONE);
+	}
+	PendingCount = 0;
+
+	if(Measuring)		Instructions++;
+	else						uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)SIM_EFLAGS_TF;
+}
+
+
+
+/*****************************************************************************************************************
+*																					APIs Supported by this Model																						*
+******************************************************************************************************************/
+
+/*****************************************************************************************************************
+* @SimInit()																																																			*
+* @brief		-	Map the register regions, install the access trap and put all modules in their reset state.					*
+* @return		-	Nothing. The program is terminated if the host doesn't provide what the model needs.								*
+*																																																									*
+* @Note			-	The trapped regions are backed by a memory file which is mapped twice: once without permission			*
+*							for the drivers, and once writable for the model. The AHB pages of the GPIO ports are mapped onto		*
+*							the same file pages as their APB pages.																															*
+******************************************************************************************************************/
+void SimInit(void)
+{
+	struct sigaction sa;
+	uint8_t port;
+	int fd;
+
+	if(SimPeriphRegion != NULL)		return;
+
+	fd = memfd_create("tm4c123xx-sim", 0);
+	if( fd < 0 || ftruncate(fd, SIM_TRAP_SIZE) != 0 )
+	{
+		perror("SimInit");
+		exit(1);
+	}
+
+	SimAlias				= mmap(NULL, SIM_TRAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	SimPeriphRegion	= mmap(NULL, SIM_TRAP_SIZE, PROT_NONE, MAP_SHARED, fd, 0);
+	SimFlashRegion	= mmap(NULL, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if( SimAlias == MAP_FAILED || SimPeriphRegion == MAP_FAILED || SimFlashRegion == MAP_FAILED )
+	{
+		perror("SimInit");
+		exit(1);
+	}
+	SimCoreRegion = SimPeriphRegion + SIM_PERIPH_SIZE;
+
+	for(port = 0; port < 6; port++)
+		if( mmap( SimPeriphRegion + (GPIOBaseAHB[port] - PERIPHERAL_BASE_ADDR), SIM_PAGE, PROT_NONE, MAP_SHARED | MAP_FIXED,
+							fd, GPIOBaseAPB[port] - PERIPHERAL_BASE_ADDR ) == MAP_FAILED )
+		{
+			perror("SimInit");
+			exit(1);
+		}
+	close(fd);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_flags = SA_SIGINFO;
+	sigemptyset(&sa.sa_mask);
+	sa.sa_sigaction = SimFault;
+	sigaction(SIGSEGV, &sa, NULL);
+	sa.sa_sigaction = SimStep;
+	sigaction(SIGTRAP, &sa, NULL);
+
+	GPIO_MapPorts();
+	SimReset();
+
+	SimMeasureBegin();																								//	Calibrate the cost of the measurement itself.
+	MeasureBias = SimMeasureEnd();
+}
+
+
+
+/*****************************************************************************************************************
+* @SimReset()																																																			*
+* @brief		-	Put every modelled module back in its reset state, detach all handlers and clear the counters.			*
+******************************************************************************************************************/
+void SimReset(void)
+{
+	uint8_t i;
+
+	memset(SimAlias, 0, SIM_TRAP_SIZE);
+	memset(SimFlashRegion, 0, SIM_FLASH_SIZE);
+	memset(I2CState, 0, sizeof(I2CState));
+
+	for(i = 0; i < 6; i++)		SimResetModule(SIM_GPIO, i);
+	for(i = 0; i < 8; i++)		SimResetModule(SIM_UART, i);
+	for(i = 0; i < 4; i++)		SimResetModule(SIM_SSI, i);
+	for(i = 0; i < 4; i++)		SimResetModule(SIM_I2C, i);
+	for(i = 0; i < 12; i++)		SimResetModule(SIM_TIMER, i);
+	SimResetModule(SIM_DMA, 0);
+
+	REG(SYSTEM_CONTROL_BASE_ADDR, SYSCTL_reg, GPIOHBCTL) = 0x7E00;			//	All ports on the APB aperture.
+
+	memset(NVICEnabled, 0, sizeof(NVICEnabled));
+	memset(NVICPending, 0, sizeof(NVICPending));
+	memset(NVICActive, 0, sizeof(NVICActive));
+	memset(ISRTable, 0, sizeof(ISRTable));
+
+	SimResetStats();
+}
+
+
+
+/*****************************************************************************************************************
+* @SimAdvance()																																																		*
+* @brief		-	Let time pass for all clocked modules.																															*
+* @Cycles		-	No of system clock cycles.																																					*
+******************************************************************************************************************/
+void SimAdvance(uint64_t Cycles)
+{
+	uint64_t Slice;
+	uint8_t i;
+
+	Stats.Cycles += Cycles;
+
+	do
+	{
+		//	While a channel is enabled, time passes in small slices so that it can keep up with the FIFOs.
+		Slice = Cycles;
+		if( DMAState.Enable && DMAState.Master && SimIsClocked(SIM_DMA, 0) && Slice > SIM_DMA_SLICE )
+			Slice = SIM_DMA_SLICE;
+
+		for(i = 0; i < 8; i++)
+			if( SimIsClocked(SIM_UART, i) )		SimUARTStep(i, Slice);
+		for(i = 0; i < 4; i++)
+			if( SimIsClocked(SIM_SSI, i) )		SimSSIStep(i, Slice);
+		for(i = 0; i < 4; i++)
+			if( SimIsClocked(SIM_I2C, i) )		SimI2CStep(i, Slice);
+		for(i = 0; i < 12; i++)
+			if( SimIsClocked(SIM_TIMER, i) )	SimTimerStep(i, Slice);
+
+		SimDMAStep();
+		Cycles -= Slice;
+	}while(Cycles);
+}
+
+
+
+/*****************************************************************************************************************
+* @SimBusAddress()																																																*
+* @brief		-	Address of host memory (or of a register) as seen by the uDMA controller. BUS_ADDR() uses it.				*
+*							Registers and the flash region keep their hardware addresses. Other host memory is given 1 MB windows	*
+*							from 0x20000000 upwards, in pairs, so that a buffer which crosses into the next megabyte stays			*
+*							contiguous on the bus.																																							*
+* @p				-	Host pointer.																																												*
+* @return		-	Bus address. The program is terminated when the windows run out.																		*
+******************************************************************************************************************/
+uint32_t SimBusAddress(const __vo void* p)
+{
+	const uint8_t* q = (const uint8_t*)p;
+	uintptr_t Window = (uintptr_t)q / SIM_BUS_WINDOW;
+	uint32_t slot;
+
+	if(SimPeriphRegion != NULL && q >= SimPeriphRegion && q < SimPeriphRegion + SIM_PERIPH_SIZE)
+		return PERIPHERAL_BASE_ADDR + (uint32_t)(q - SimPeriphRegion);
+	if(SimCoreRegion != NULL && q >= SimCoreRegion && q < SimCoreRegion + SIM_CORE_SIZE)
+		return CORE_PERIPHERAL_BASE_ADDR + (uint32_t)(q - SimCoreRegion);
+	if(SimFlashRegion != NULL && q >= SimFlashRegion && q < SimFlashRegion + SIM_FLASH_SIZE)
+		return FLASH_BASE_ADDR + (uint32_t)(q - SimFlashRegion);
+
+	for(slot = 0; slot + 1 < BusWindowCount; slot++)
+		if(BusWindow[slot] == Window && BusWindow[slot+1] == Window + 1)		break;
+
+	if(slot + 1 >= BusWindowCount)
+	{
+		if(BusWindowCount + 2 > SIM_BUS_WINDOWS)
+		{
+			fprintf(stderr, "SimBusAddress: out of bus windows\n");
+			exit(1);
+		}
+		slot = BusWindowCount;
+		BusWindow[slot] = Window;
+		BusWindow[slot+1] = Window + 1;
+		BusWindowCount += 2;
+	}
+
+	return SRAM_BASE_ADDR + slot*SIM_BUS_WINDOW + (uint32_t)( (uintptr_t)q % SIM_BUS_WINDOW );
+}
+
+/*	Host pointer behind a bus address, for checking descriptors. NULL if nothing is mapped there. */
+void* SimBusPointer(uint32_t BusAddress)
+{
+	if( SimBusIsRegister(BusAddress) )
+		return (BusAddress >= CORE_PERIPHERAL_BASE_ADDR) ? SimCoreRegion + (BusAddress - CORE_PERIPHERAL_BASE_ADDR)
+																										 : SimPeriphRegion + (BusAddress - PERIPHERAL_BASE_ADDR);
+	return SimBusToHost(BusAddress, 1);
+}
+
+
+
+/*------------------------------------------------- Measurement -------------------------------------------------*/
+
+void SimResetStats(void)
+{
+	memset(&Stats, 0, sizeof(Stats));
+	memset(ReadCount, 0, sizeof(ReadCount));
+	memset(WriteCount, 0, sizeof(WriteCount));
+}
+
+void SimGetStats(SimStats* pStats)
+{
+	*pStats = Stats;
+}
+
+uint32_t SimRegReads(uint32_t RegAddress)
+{
+	return ReadCount[ SimViewOffset(RegAddress)/4 ];
+}
+
+uint32_t SimRegWrites(uint32_t RegAddress)
+{
+	return WriteCount[ SimViewOffset(RegAddress)/4 ];
+}
+
+
+
+/*****************************************************************************************************************
+* @SimMeasureBegin() / @SimMeasureEnd()																																						*
+* @brief		-	Count the instructions executed between the two calls by single-stepping them.											*
+* @return		-	(End) No of instructions, excluding the cost of the two calls themselves.														*
+*																																																									*
+* @Note			-	Measurements can not be nested. Register traps taken in between are not counted as instructions.		*
+******************************************************************************************************************/
+void SimMeasureBegin(void)
+{
+	Instructions = 0;
+	Measuring = 1;
+	__asm__ volatile(	"sub $128, %%rsp\n\t"																//	Step over the red zone.
+										"pushfq\n\t"
+										"orq $0x100, (%%rsp)\n\t"
+										"popfq\n\t"
+										"add $128, %%rsp"
+										::: "memory", "cc" );
+}
+
+uint64_t SimMeasureEnd(void)
+{
+	uint64_t Count;
+
+	Measuring = 0;
+	Count = Instructions;
+
+	return (Count > MeasureBias) ? Count - MeasureBias : 0;
+}
+
+
+
+/*------------------------------------------------ External Pins ------------------------------------------------*/
+
+void SimSetPinLevel(uint8_t pin, uint8_t Level)
+{
+	uint8_t port = getPortName(pin);
+	uint8_t bit = 1 << getPinNumber(pin);
+	uint8_t pins = SimGPIOPins(port);
+
+	GPIOState[port].Driven |= bit;
+	if(Level)		GPIOState[port].In |= bit;
+	else				GPIOState[port].In &= ~bit;
+
+	SimGPIOEdges(port, pins);
+}
+
+uint8_t SimGetPinLevel(uint8_t pin)
+{
+	return GET_BIT( SimGPIOPins(getPortName(pin)), getPinNumber(pin) );
+}
+
+
+
+/*----------------------------------------------------- UART ----------------------------------------------------*/
+
+void SimUARTInject(uint8_t UARTx, const uint8_t* Data, uint32_t Len)
+{
+	SimUART* u = &UARTState[UARTx - UART0];
+
+	while(Len-- && u->LineCount < SIM_LINE_SIZE)
+	{
+		u->Line[ (u->LineHead + u->LineCount) % SIM_LINE_SIZE ] = *Data++;
+		u->LineCount++;
+	}
+}
+
+/*	@ErrorBits - Any of (1<<UART_DR_FE), (1<<UART_DR_PE), (1<<UART_DR_BE), shifted down by 8. */
+void SimUARTInjectError(uint8_t UARTx, uint8_t Data, uint8_t ErrorBits)
+{
+	SimUART* u = &UARTState[UARTx - UART0];
+
+	if(u->LineCount < SIM_LINE_SIZE)
+	{
+		u->Line[ (u->LineHead + u->LineCount) % SIM_LINE_SIZE ] = Data | ( (uint16_t)(ErrorBits & 0x7) << 8 );
+		u->LineCount++;
+	}
+}
+
+/*	Puts an address byte (9th bit set) on the Rx line. It only differs from a data byte while 9-bit mode is enabled. */
+void SimUARTInjectAddress(uint8_t UARTx, uint8_t Address)
+{
+	SimUART* u = &UARTState[UARTx - UART0];
+
+	if(u->LineCount < SIM_LINE_SIZE)
+	{
+		u->Line[ (u->LineHead + u->LineCount) % SIM_LINE_SIZE ] = Address | SIM_UART_ADDRESS;
+		u->LineCount++;
+	}
+}
+
+/*	@Asserted - 1 lets the transmitter send (reset state), 0 makes it stop after the byte being shifted out. Only
+*							used while UART_CTL_CTSEN is set.
+*/
+void SimUARTSetCTS(uint8_t UARTx, uint8_t Asserted)
+{
+	UARTState[UARTx - UART0].CTSOff = !Asserted;
+}
+
+uint8_t SimUARTGetRTS(uint8_t UARTx)
+{
+	return SimUARTRTS(UARTx - UART0);
+}
+
+/*	@Baud - Rate at which the other side sends from now on, 0 to follow the rate programmed into the UART (default). */
+void SimUARTSetLineBaud(uint8_t UARTx, uint32_t Baud)
+{
+	UARTState[UARTx - UART0].LineBaud = Baud;
+	UARTState[UARTx - UART0].LineAt = 0;
+}
+
+uint32_t SimUARTTakeTx(uint8_t UARTx, uint8_t* Buf, uint32_t MaxLen)
+{
+	SimUART* u = &UARTState[UARTx - UART0];
+	uint32_t n = 0;
+
+	while(n < MaxLen && u->LogCount)
+	{
+		Buf[n++] = u->Log[u->LogHead];
+		u->LogHead = (u->LogHead + 1) % SIM_LOG_SIZE;
+		u->LogCount--;
+	}
+	return n;
+}
+
+
+
+/*------------------------------------------------------ SSI ----------------------------------------------------*/
+
+void SimSSIInject(uint8_t SSIx, const uint16_t* Data, uint32_t Len)
+{
+	SimSSI* s = &SSIState[SSIx - SSI0];
+
+	while(Len-- && s->LineCount < SIM_LINE_SIZE)
+	{
+		s->Line[ (s->LineHead + s->LineCount) % SIM_LINE_SIZE ] = *Data++;
+		s->LineCount++;
+	}
+}
+
+uint32_t SimSSITakeTx(uint8_t SSIx, uint16_t* Buf, uint32_t MaxLen)
+{
+	SimSSI* s = &SSIState[SSIx - SSI0];
+	uint32_t n = 0;
+
+	while(n < MaxLen && s->LogCount)
+	{
+		Buf[n++] = s->Log[s->LogHead];
+		s->LogHead = (s->LogHead + 1) % SIM_LOG_SIZE;
+		s->LogCount--;
+	}
+	return n;
+}
+
+
+
+/*------------------------------------------------------ I2C ----------------------------------------------------*/
+
+void SimI2CInject(uint8_t I2Cx, const uint8_t* Data, uint32_t Len)
+{
+	SimI2C* c = &I2CState[I2Cx - I2C0];
+
+	while(Len-- && c->LineCount < SIM_LINE_SIZE)
+	{
+		c->Line[ (c->LineHead + c->LineCount) % SIM_LINE_SIZE ] = *Data++;
+		c->LineCount++;
+	}
+}
+
+uint32_t SimI2CTakeTx(uint8_t I2Cx, uint8_t* Buf, uint32_t MaxLen)
+{
+	SimI2C* c = &I2CState[I2Cx - I2C0];
+	uint32_t n = 0;
+
+	while(n < MaxLen && c->LogCount)
+	{
+		Buf[n++] = c->Log[c->LogHead];
+		c->LogHead = (c->LogHead + 1) % SIM_LOG_SIZE;
+		c->LogCount--;
+	}
+	return n;
+}
+
+void SimI2CSetNack(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t Nack)
+{
+	SimI2C* c = &I2CState[I2Cx - I2C0];
+
+	SlaveAddress &= 0x7F;
+	if(Nack)		c->Nack[SlaveAddress>>3] SET_BIT( (SlaveAddress & 0x7) );
+	else				c->Nack[SlaveAddress>>3] CLR_BIT( (SlaveAddress & 0x7) );
+}
+
+
+
+/*-------------------------------------------------- Interrupts -------------------------------------------------*/
+
+void SimAttachISR(uint8_t IRQn, void (*Handler)(void))
+{
+	if(IRQn < SIM_IRQ_COUNT)		ISRTable[IRQn] = Handler;
+}
+
+/*	Pend the interrupt lines of all modules which are requesting an interrupt. */
+static void SimUpdateLines(void)
+{
+	uint8_t i;
+
+	#define SIM_PEND(irq)		( NVICPending[(irq)/32] |= 1U << ((irq) & 0x1F) )
+
+	for(i = 0; i < 6; i++)
+	{
+		uint32_t base = GPIOBaseAPB[i];
+		if( (GPIOState[i].RIS | SimGPIOLevelRIS(i)) & REG(base, GPIO_reg, GPIO_IM) )		SIM_PEND(GPIOIRQ[i]);
+	}
+	for(i = 0; i < 8; i++)
+		if( UARTState[i].RIS & REG(UARTBase(i), UART_Reg, IM) )												SIM_PEND(UARTIRQ[i]);
+	for(i = 0; i < 4; i++)
+	{
+		SimSSI* s = &SSIState[i];
+		uint32_t ris = s->RIS | (s->TxCount <= 4 ? 1<<SSI_RIS_TX : 0) | (s->RxCount >= 4 ? 1<<SSI_RIS_RX : 0);
+		if( ris & REG(SSIBase(i), ssi_reg, SSI_IM) )																		SIM_PEND(SSIIRQ[i]);
+	}
+	for(i = 0; i < 4; i++)
+		if( I2CState[i].MRIS & REG(I2CBase(i), I2C_reg, MIMR) )												SIM_PEND(I2CIRQ[i]);
+	for(i = 0; i < 12; i++)
+	{
+		uint32_t mis = TimerState[i].RIS & REG(TimerBase[i], Timer_Reg, IMR);
+		if(mis & 0x001F)			SIM_PEND(TimerIRQ[i]);
+		if(mis & 0x0F00)			SIM_PEND(TimerIRQ[i] + 1);
+	}
+	for(i = 0; i < 32; i++)
+	{
+		uint8_t Tx;
+		int8_t n = SimDMAUART(i, &Tx);
+
+		if( !((DMAState.ChIS >> i) & 1) )		continue;
+		if(n >= 0)		SIM_PEND(UARTIRQ[n]);
+		else					SIM_PEND(SIM_IRQ_UDMA);
+	}
+	if(DMAState.Err)								SIM_PEND(SIM_IRQ_UDMAERR);
+
+	#undef SIM_PEND
+}
+
+
+
+/*****************************************************************************************************************
+* @SimDispatchInterrupts()																																												*
+* @brief		-	Call the handlers of all NVIC-enabled interrupts which are pending, highest priority (lowest PRI		*
+*							value) first. A handler which doesn't clear its source is called again.															*
+* @return		-	No of handler calls made.																																						*
+******************************************************************************************************************/
+uint32_t SimDispatchInterrupts(void)
+{
+	uint32_t Calls = 0;
+
+	while(Calls < SIM_MAX_DISPATCH)
+	{
+		uint8_t* pri = (uint8_t*)SimReg( NVIC_BASE_ADDR + OFFSET(NVIC_reg, PRI) );
+		int16_t Next = -1;
+		uint8_t irq;
+
+		SimUpdateLines();
+		for(irq = 0; irq < SIM_IRQ_COUNT; irq++)
+		{
+			uint32_t bit = 1U << (irq & 0x1F);
+			if( !(NVICEnabled[irq/32] & NVICPending[irq/32] & bit) || ISRTable[irq] == NULL )		continue;
+			if( Next < 0 || pri[irq] < pri[Next] )		Next = irq;
+		}
+		if(Next < 0)		break;
+
+		NVICPending[Next/32] &= ~(1U << (Next & 0x1F));
+		NVICActive[Next/32]	 |=  (1U << (Next & 0x1F));
+		ISRTable[Next]();
+		NVICActive[Next/32]	 &= ~(1U << (Next & 0x1F));
+		Calls++;
+	}
+	return Calls;
+}
+
+#endif
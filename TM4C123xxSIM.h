@@ -0,0 +1,163 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxSIM.h																																											*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains prototypes of the host-side register model. When the drivers are compiled with								*
+*	TM4C123XX_HOST_SIM defined, every module access pointer in TM4C123xx.h resolves into memory owned by this model	*
+*	instead of the fixed hardware address. This way the complete driver stack can be run, tested and measured on a	*
+*	Linux build machine before anything is flashed.																																	*
+*																																																									*
+*	How it works:-																																																	*
+*	<>	The peripheral and core peripheral regions are mapped without any access permission. Every register access	*
+*			made by a driver traps into the model. The model counts the access, brings the register up to date (status	*
+*			flags, FIFOs, W1C registers, address-masked GPIO data etc.), and then lets the instruction complete.				*
+*	<>	Time is counted in system clock cycles. Every register access advances the clock by SimCyclesPerAccess, and	*
+*			SimAdvance() lets time pass explicitly. Busy flags clear and FIFOs drain as the clock advances.							*
+*	<>	Interrupts are not delivered asynchronously. SimDispatchInterrupts() calls the handlers attached with				*
+*			SimAttachISR() for all NVIC-enabled lines which have a pending request.																			*
+*	<>	SimMeasureBegin() and SimMeasureEnd() count the instructions executed in between by single-stepping them.		*
+*	<>	The uDMA controller reads its control table and buffers from host memory. Pointers are handed to it through	*
+*			BUS_ADDR(), which gives every host buffer an address in the SRAM region of the bus (see SimBusAddress()).		*
+*																																																									*
+*	Build	:	gcc -DTM4C123XX_HOST_SIM <application>.c *.c -lm																												*
+*					SimInit() must be called before any driver API is used.																									*
+*																																																									*
+* @Note			-	The model needs Linux on an x86-64 host. Nothing in this file is used by the target build.					*
+*						When debugging a host build with gdb, use "handle SIGSEGV SIGTRAP nostop noprint pass".								*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#ifndef TM4C123XXSIM_H
+#define TM4C123XXSIM_H
+
+#include "TM4C123xx.h"
+
+
+
+/*****************************************************************************************************************
+*															Miscellaneous macros, shorthands and Global variables																*
+******************************************************************************************************************/
+
+// Interrupt numbers (vector number - 16) used by SimAttachISR()
+#define SIM_IRQ_GPIOA					0
+#define SIM_IRQ_GPIOB					1
+#define SIM_IRQ_GPIOC					2
+#define SIM_IRQ_GPIOD					3
+#define SIM_IRQ_GPIOE					4
+#define SIM_IRQ_UART0					5
+#define SIM_IRQ_UART1					6
+#define SIM_IRQ_SSI0					7
+#define SIM_IRQ_I2C0					8
+#define SIM_IRQ_TIMER0A				19
+#define SIM_IRQ_GPIOF					30
+#define SIM_IRQ_UART2					33
+#define SIM_IRQ_SSI1					34
+#define SIM_IRQ_I2C1					37
+#define SIM_IRQ_UDMA					46
+#define SIM_IRQ_UDMAERR				47
+#define SIM_IRQ_SSI2					57
+#define SIM_IRQ_SSI3					58
+#define SIM_IRQ_UART3					59
+#define SIM_IRQ_UART4					60
+#define SIM_IRQ_UART5					61
+#define SIM_IRQ_UART6					62
+#define SIM_IRQ_UART7					63
+#define SIM_IRQ_I2C2					68
+#define SIM_IRQ_I2C3					69
+#define SIM_IRQ_WTIMER0A			94
+
+#define SIM_IRQ_COUNT					139
+
+
+/*****************************************************************************************************************
+	@SimStats
+	Counters collected by the model. Use SimResetStats() before the code under measurement, and SimGetStats() after.
+******************************************************************************************************************/
+typedef struct
+{
+	uint64_t Cycles;											//	System clock cycles elapsed
+	uint32_t Reads;												//	Register reads
+	uint32_t Writes;											//	Register writes
+	uint32_t BusFaults;										//	Accesses to an un-clocked module or to the unselected GPIO aperture
+}SimStats;
+
+
+/*****************************************************************************************************************
+	@SimCyclesPerAccess
+	Number of system clock cycles by which the model clock advances on every register access. Default is 4.
+******************************************************************************************************************/
+extern uint32_t SimCyclesPerAccess;
+
+
+
+/*****************************************************************************************************************
+*																					APIs Supported by this Model																						*
+*																																																									*
+*	SimInit()							-	Map the register regions and install the access trap. Call once, before the drivers.		*
+*	SimReset()						-	Put every modelled register back in its reset state and clear the counters.							*
+*	SimAdvance()					-	Let the given number of system clock cycles pass.																				*
+*	SimBusAddress()				-	Address of host memory as seen by the uDMA controller (used by BUS_ADDR()).							*
+*	SimBusPointer()				-	Host memory behind an address which the uDMA controller uses (e.g. from a control structure).	*
+*																																																									*
+*	SimResetStats()				-	Clear all access counters.																															*
+*	SimGetStats()					-	Read the access counters.																																*
+*	SimRegReads()					-	No of reads of one register (hardware address).																					*
+*	SimRegWrites()				-	No of writes to one register (hardware address).																				*
+*	SimMeasureBegin()			-	Start counting executed instructions.																										*
+*	SimMeasureEnd()				-	Stop counting and return the no of instructions executed since SimMeasureBegin().				*
+*																																																									*
+*	SimSetPinLevel()			-	Drive an input pin from outside.																												*
+*	SimGetPinLevel()			-	Get the level of a pin as seen from outside.																						*
+*																																																									*
+*	SimUARTInject()				-	Put bytes on the Rx line of an UART module.																							*
+*	SimUARTInjectError()	-	Put a byte with framing/parity/break error on the Rx line of an UART module.						*
+*	SimUARTInjectAddress()	-	Put an address byte (9-bit mode) on the Rx line of an UART module.										*
+*	SimUARTTakeTx()				-	Collect the bytes which have been shifted out on the Tx line of an UART module.					*
+*	SimUARTSetCTS()				-	Assert/de-assert the CTS input of an UART module.																				*
+*	SimUARTGetRTS()				-	Get the RTS output of an UART module.																										*
+*	SimUARTSetLineBaud()	-	Make the other side send at its own rate, bit by bit on the Rx pin.											*
+*	SimSSIInject()				-	Queue frames to be shifted in on the Rx line of an SSI module.													*
+*	SimSSITakeTx()				-	Collect the frames which have been shifted out by an SSI module.												*
+*	SimI2CInject()				-	Queue bytes which the slave returns to an I2C master receive.														*
+*	SimI2CTakeTx()				-	Collect the bytes which have been sent by an I2C master.																*
+*	SimI2CSetNack()				-	Make a slave address not acknowledge.																										*
+*																																																									*
+*	SimAttachISR()				-	Attach an interrupt handler to an interrupt number.																			*
+*	SimDispatchInterrupts()	-	Run the handlers of all enabled interrupts which are pending.													*
+******************************************************************************************************************/
+void SimInit(void);
+void SimReset(void);
+void SimAdvance(uint64_t Cycles);
+uint32_t SimBusAddress(const __vo void* p);
+void* SimBusPointer(uint32_t BusAddress);
+
+void SimResetStats(void);
+void SimGetStats(SimStats* pStats);
+uint32_t SimRegReads(uint32_t RegAddress);
+uint32_t SimRegWrites(uint32_t RegAddress);
+void SimMeasureBegin(void);
+uint64_t SimMeasureEnd(void);
+
+void SimSetPinLevel(uint8_t pin, uint8_t Level);
+uint8_t SimGetPinLevel(uint8_t pin);
+
+void SimUARTInject(uint8_t UARTx, const uint8_t* Data, uint32_t Len);
+void SimUARTInjectError(uint8_t UARTx, uint8_t Data, uint8_t ErrorBits);
+void SimUARTInjectAddress(uint8_t UARTx, uint8_t Address);
+uint32_t SimUARTTakeTx(uint8_t UARTx, uint8_t* Buf, uint32_t MaxLen);
+void SimUARTSetCTS(uint8_t UARTx, uint8_t Asserted);
+uint8_t SimUARTGetRTS(uint8_t UARTx);
+void SimUARTSetLineBaud(uint8_t UARTx, uint32_t Baud);
+
+void SimSSIInject(uint8_t SSIx, const uint16_t* Data, uint32_t Len);
+uint32_t SimSSITakeTx(uint8_t SSIx, uint16_t* Buf, uint32_t MaxLen);
+
+void SimI2CInject(uint8_t I2Cx, const uint8_t* Data, uint32_t Len);
+uint32_t SimI2CTakeTx(uint8_t I2Cx, uint8_t* Buf, uint32_t MaxLen);
+void SimI2CSetNack(uint8_t I2Cx, uint8_t SlaveAddress, uint8_t Nack);
+
+void SimAttachISR(uint8_t IRQn, void (*Handler)(void));
+uint32_t SimDispatchInterrupts(void);
+
+#endif
@@ -10,14 +10,13 @@
 ******************************************************************************************************************/
 
 #include "TM4C123xxSSI_DRIVER.h"
-#include <math.h>
 
 
 __vo uint16_t* SSIIntrTxBuf[4] = {NULL,NULL,NULL,NULL};
 __vo uint16_t* SSIIntrRxBuf[4] = {NULL,NULL,NULL,NULL};
 
-__vo uint8_t SSIIntrTxCount[4] = {0,0,0,0};
-__vo uint8_t SSIIntrRxCount[4] = {0,0,0,0};
+__vo uint32_t SSIIntrTxCount[4] = {0,0,0,0};
+__vo uint32_t SSIIntrRxCount[4] = {0,0,0,0};
 
 
 
@@ -121,7 +120,7 @@ void SSIInit(uint8_t SSIx, uint8_t DeviceMode, uint8_t ClockSource, uint8_t Cloc
 	{
 		case SSI0:	// Configure pins for SSI0 (Alternate Function # 2)
 		
-								pGPIO = GPIO_A_P;																//	GPIO_A has the pins for SSI0
+								pGPIO = getPortAddr(GPIO_PORT_A, SELECTED_BUS);	//	GPIO_A has the pins for SSI0
 								ssi_pins = 0x3C;																//	PA2,3,4,5 are used for SSI0
 		
 								GPIO_ClockControl(GPIO_PORT_A, ENABLE);					//	Step 2 of Section 15.4
@@ -135,7 +134,7 @@ void SSIInit(uint8_t SSIx, uint8_t DeviceMode, uint8_t ClockSource, uint8_t Cloc
 		//-------------------------------------------------------------------------------------------------------------
 		case SSI1:	// Configure pins for SSI1 (Alternate Function # 2)
 		
-								pGPIO = GPIO_F_P;																//	GPIO_F has the pins for SSI1
+								pGPIO = getPortAddr(GPIO_PORT_F, SELECTED_BUS);	//	GPIO_F has the pins for SSI1
 								ssi_pins = 0x0F;																//	PF0,1,2,3 are used for SSI2
 		
 								GPIO_ClockControl(GPIO_PORT_F, ENABLE);					//	Step 2 of Section 15.4
@@ -149,7 +148,7 @@ void SSIInit(uint8_t SSIx, uint8_t DeviceMode, uint8_t ClockSource, uint8_t Cloc
 		//-------------------------------------------------------------------------------------------------------------
 		case SSI2:	// Configure pins for SSI2 (Alternate Function # 2)
 		
-								pGPIO = GPIO_B_P;																//	GPIO_B has the pins for SSI2
+								pGPIO = getPortAddr(GPIO_PORT_B, SELECTED_BUS);	//	GPIO_B has the pins for SSI2
 								ssi_pins = 0xF0;																//	PB4,5,6,7 are used for SSI2
 		
 								GPIO_ClockControl(GPIO_PORT_B, ENABLE);					//	Step 2 of Section 15.4
@@ -163,7 +162,7 @@ void SSIInit(uint8_t SSIx, uint8_t DeviceMode, uint8_t ClockSource, uint8_t Cloc
 		//-------------------------------------------------------------------------------------------------------------
 		case SSI3:	// Configure pins for SSI3 (Alternate Function # 1)
 		
-								pGPIO = GPIO_D_P;																//	GPIO_D has the pins for SSI3
+								pGPIO = getPortAddr(GPIO_PORT_D, SELECTED_BUS);	//	GPIO_D has the pins for SSI3
 								ssi_pins = 0x0F;																//	PD0,1,2,3 are used for SSI3
 		
 								GPIO_ClockControl(GPIO_PORT_D, ENABLE);					//	Step 2 of Section 15.4
@@ -296,14 +295,14 @@ void SPIStart(uint8_t SSIx,uint8_t DeviceMode, uint8_t InterruptsNeedToBeEnabled
 *									Also, it might generate bus faults if the clock is disabled.																		*
 *	@Note2				-	In case of incorrect data length, the function does not proceed further and breaks out.					*
 ******************************************************************************************************************/
-void SSISendData(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len)
+void SSISendData(uint8_t SSIx, uint16_t* DataBuf, uint32_t Len)
 {
 	ssi_reg* pSSI = SSIGetAddress(SSIx);
 
-	if(Len <= 0)	return;											//	Break out of the function in case of incorrect length.
+	if(Len == 0)	return;											//	Break out of the function in case of incorrect length.
 	else
 	{
-		uint8_t n = ceil( Len/16.0 );						//	Tx count (no of 16 bit data packets that are to be sent)
+		uint32_t n = (Len + 15)/16;						//	Tx count (no of 16 bit data packets that are to be sent)
 		do
 		{
 			WaitWhileSSIControllerIsBusy(pSSI);
@@ -348,15 +347,15 @@ void SSISend(uint8_t SSIx, uint16_t Data)
 *									Also, it might generate bus faults if the clock is disabled.																		*
 *	@Note2				-	In case of incorrect data length, the function does not proceed further and breaks out.					*
 ******************************************************************************************************************/
-void SSIRecvData(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len)
+void SSIRecvData(uint8_t SSIx, uint16_t* DataBuf, uint32_t Len)
 {
 	ssi_reg* pSSI = SSIGetAddress(SSIx);
 	
-	if(Len <= 0)	return;											//	Break out of the function in case of incorrect data length
+	if(Len == 0)	return;											//	Break out of the function in case of incorrect data length
 	else
 	{
 		
-		uint8_t n = ceil( Len/16.0 );						// Rx count (no of 16 bit data packets that are to be received)
+		uint32_t n = (Len + 15)/16;						// Rx count (no of 16 bit data packets that are to be received)
 		do
 		{
 			WaitWhileSSIControllerIsBusy(pSSI);
@@ -411,7 +410,7 @@ void SSIRecv(uint8_t SSIx, uint16_t* DataBuf)
 *	@Len					-	Data Size, or the length of Data bits which need to be sent.																		*
 * @return				-	None.																																														*
 ******************************************************************************************************************/
-void SSISendWithIntr(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len)
+void SSISendWithIntr(uint8_t SSIx, uint16_t* DataBuf, uint32_t Len)
 {
 	ssi_reg* pSSI = SSIGetAddress(SSIx);
 	
@@ -420,7 +419,7 @@ void SSISendWithIntr(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len)
 	pSSI->SSI_CR[1] SET_BIT( SSI_CR1_SSE );						//	Re-Enable SSI operation.
 
 	SSIIntrTxBuf[SSIx-6] = DataBuf;									//	Save the data pointer to the appropriate buffer variable.
-	SSIIntrTxCount[SSIx-6] = ceil( Len/16.0 );			//	Tx count (no of 16-bit data packets that are to be sent)
+	SSIIntrTxCount[SSIx-6] = (Len + 15)/16;			//	Tx count (no of 16-bit data packets that are to be sent)
 }
 
 
@@ -433,7 +432,7 @@ void SSISendWithIntr(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len)
 *	@Len					-	Length of Data (in bits) which need to be received.																							*
 * @return				-	None.																																														*
 ******************************************************************************************************************/
-void SSIRecvWithIntr(uint8_t SSIx, __vo uint16_t *DataBuf, uint8_t Len)
+void SSIRecvWithIntr(uint8_t SSIx, __vo uint16_t *DataBuf, uint32_t Len)
 {
 	ssi_reg* pSSI = SSIGetAddress(SSIx);
 	
@@ -442,7 +441,7 @@ void SSIRecvWithIntr(uint8_t SSIx, __vo uint16_t *DataBuf, uint8_t Len)
 	pSSI->SSI_CR[1] SET_BIT( SSI_CR1_SSE );						//	Re-Enable SSI operation.
 	
 	SSIIntrRxBuf[SSIx-6] = DataBuf;									//	Save the data pointer to the appropriate buffer variable.
-	SSIIntrRxCount[SSIx-6] = ceil( Len/16.0 );			//	Rx count (no of 16-bit data packets that are to be sent)
+	SSIIntrRxCount[SSIx-6] = (Len + 15)/16;			//	Rx count (no of 16-bit data packets that are to be sent)
 }
 
 
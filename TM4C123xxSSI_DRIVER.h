@@ -120,8 +120,8 @@
 extern __vo uint16_t* SSIIntrTxBuf[4];
 extern __vo uint16_t* SSIIntrRxBuf[4];
 
-extern __vo uint8_t SSIIntrTxCount[4];
-extern __vo uint8_t SSIIntrRxCount[4];
+extern __vo uint32_t SSIIntrTxCount[4];
+extern __vo uint32_t SSIIntrRxCount[4];
 
 
 
@@ -158,15 +158,15 @@ void SPIStart(uint8_t SSIx, uint8_t DeviceMode, uint8_t InterruptMode);
 void TiSSIStart(uint8_t SSIx, uint8_t DeviceMode, uint8_t InterruptMode);				//	This is yet to be implemented.
 void uWireSSIStart(uint8_t SSIx, uint8_t DeviceMode, uint8_t InterruptMode);		//	This is yet to be implemented.
 
-void SSISendData(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len);
+void SSISendData(uint8_t SSIx, uint16_t* DataBuf, uint32_t Len);
 void SSISend(uint8_t SSIx, uint16_t Data);
 
-void SSIRecvData(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len);
+void SSIRecvData(uint8_t SSIx, uint16_t* DataBuf, uint32_t Len);
 void SSIRecv(uint8_t SSIx, uint16_t* DataBuf);
 
 
-void SSISendWithIntr(uint8_t SSIx, uint16_t* DataBuf, uint8_t Len);
-void SSIRecvWithIntr(uint8_t SSIx, __vo uint16_t *DataBuf, uint8_t Len);
+void SSISendWithIntr(uint8_t SSIx, uint16_t* DataBuf, uint32_t Len);
+void SSIRecvWithIntr(uint8_t SSIx, __vo uint16_t *DataBuf, uint32_t Len);
 
 void SSIIntrSend(uint8_t SSIx);
 void SSIIntrRecv(uint8_t SSIx);
@@ -0,0 +1,231 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxTIMER_DRIVER.c																																							*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains the definitions of General Purpose Timer Driver APIs.																				*
+*																																																									*
+* @Note			-	All of the code present in the this file applies to TM4C123GH6PM microcontroller.										*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#include "TM4C123xxTIMER_DRIVER.h"
+
+
+// @TimerIRQNumber - Interrupt numbers of Timer A of Timer0 - Timer5 and Timer0W - Timer5W (in that order).
+static const uint8_t TimerIRQNumber[12] = {19, 21, 23, 35, 70, 92, 94, 96, 98, 100, 102, 104};
+
+
+
+/*****************************************************************************************************************
+*	@TimerClockControl()																																														*
+* @brief			-	This function is used to enable or disable clock for a particular Timer module.										*
+*	@Timerx			- Name of the Timer module for which clock needs to be enabled or disabled.													*
+*	@ENorDI			- This variable speifies whether we have to enable or disable the clock.														*
+*								Use (I) ENABLE or (II) DISABLE macros for this variable.																					*
+******************************************************************************************************************/
+void TimerClockControl(uint8_t Timerx, uint8_t ENorDI)
+{
+	if(ENorDI == ENABLE)
+		switch(Timerx)
+		{
+			case Timer0:		Timer0_PCLK_EN();				return;
+			case Timer1:		Timer1_PCLK_EN();				return;
+			case Timer2:		Timer2_PCLK_EN();				return;
+			case Timer3:		Timer3_PCLK_EN();				return;
+			case Timer4:		Timer4_PCLK_EN();				return;
+			case Timer5:		Timer5_PCLK_EN();				return;
+			case Timer0W:		Timer0W_PCLK_EN();			return;
+			case Timer1W:		Timer1W_PCLK_EN();			return;
+			case Timer2W:		Timer2W_PCLK_EN();			return;
+			case Timer3W:		Timer3W_PCLK_EN();			return;
+			case Timer4W:		Timer4W_PCLK_EN();			return;
+			case Timer5W:		Timer5W_PCLK_EN();			return;
+
+			default: return;
+		}
+	else
+		switch(Timerx)
+		{
+			case Timer0:		Timer0_PCLK_DIS();			return;
+			case Timer1:		Timer1_PCLK_DIS();			return;
+			case Timer2:		Timer2_PCLK_DIS();			return;
+			case Timer3:		Timer3_PCLK_DIS();			return;
+			case Timer4:		Timer4_PCLK_DIS();			return;
+			case Timer5:		Timer5_PCLK_DIS();			return;
+			case Timer0W:		Timer0W_PCLK_DIS();			return;
+			case Timer1W:		Timer1W_PCLK_DIS();			return;
+			case Timer2W:		Timer2W_PCLK_DIS();			return;
+			case Timer3W:		Timer3W_PCLK_DIS();			return;
+			case Timer4W:		Timer4W_PCLK_DIS();			return;
+			case Timer5W:		Timer5W_PCLK_DIS();			return;
+
+			default: return;
+		}
+}
+
+
+
+/*****************************************************************************************************************
+*	@TimerInit()																																																		*
+*	@brief						-	This function configures Timer A of a Timer module as a 32-bit timer. The timer is not started. *
+*	@Timerx						- Name of the Timer Module.																																		*
+* @TimerMode				- OneShotTimer or PeriodicTimer.																															*
+* @CountDirection		- CountDown or CountUp.																																				*
+*	@Period						-	No of system clock cycles between two time-outs. 0 => 2^32 cycles (free-running timer).			*
+*																																																									*
+*	@Note							-	See Pg No. 722 (Section 11.4.1) for detailed steps on One-Shot/Periodic Timer Mode.					*
+******************************************************************************************************************/
+void TimerInit(uint8_t Timerx, uint8_t TimerMode, uint8_t CountDirection, uint32_t Period)
+{
+	Timer_Reg* pTimer = TimerGetAddress(Timerx);
+
+	if(pTimer == NULL)		return;
+
+	TimerClockControl(Timerx, ENABLE);
+
+	pTimer->CTL CLR_BIT(TIMER_CTL_TAEN);																	//	Step 1: Disable the timer.
+	pTimer->CFG = (Timerx >= Timer0W) ? TIMER_CFG_INDIVIDUAL : TIMER_CFG_CONCATENATED;		//	Step 2: 32-bit timer
+	pTimer->TAMR = ( (TimerMode & 0x3) << TIMER_TAMR_TAMR ) | ( (CountDirection & 0x1) << TIMER_TAMR_TACDIR );		//	Step 3
+	pTimer->TAILR = Period - 1;																						//	Step 4: Load value
+}
+
+
+
+/*****************************************************************************************************************
+*	@TimerDeInit()																																																	*
+*	@brief			-	This function resets a Timer module and turns off its clock.																			*
+*	@Timerx			- Name of the Timer Module.																																					*
+******************************************************************************************************************/
+void TimerDeInit(uint8_t Timerx)
+{
+	if(TimerGetAddress(Timerx) == NULL)		return;
+
+	if(Timerx < Timer0W)
+	{
+		SYSCTL->SRTIMER	SET_BIT( (Timerx - Timer0) );
+		SYSCTL->SRTIMER	CLR_BIT( (Timerx - Timer0) );
+	}
+	else
+	{
+		SYSCTL->SRWTIMER	SET_BIT( (Timerx - Timer0W) );
+		SYSCTL->SRWTIMER	CLR_BIT( (Timerx - Timer0W) );
+	}
+	TimerClockControl(Timerx, DISABLE);
+}
+
+
+
+/*****************************************************************************************************************
+*	@TimerStart() / @TimerStop()																																										*
+*	@brief			-	These functions start/stop Timer A of a Timer module.																							*
+*	@Timerx			- Name of the Timer Module.																																					*
+******************************************************************************************************************/
+void TimerStart(uint8_t Timerx)
+{
+	Timer_Reg* pTimer = TimerGetAddress(Timerx);
+
+	if(pTimer == NULL)		return;
+
+	pTimer->CTL SET_BIT(TIMER_CTL_TAEN);
+}
+
+void TimerStop(uint8_t Timerx)
+{
+	Timer_Reg* pTimer = TimerGetAddress(Timerx);
+
+	if(pTimer == NULL)		return;
+
+	pTimer->CTL CLR_BIT(TIMER_CTL_TAEN);
+}
+
+
+
+/*****************************************************************************************************************
+*	@TimerGetValue()																																																*
+*	@brief			-	This function returns the current count of Timer A.																								*
+*	@Timerx			- Name of the Timer Module.																																					*
+* @return			- Current count. It increases with every system clock cycle when counting up, and decreases when		*
+*								counting down. 0 for an invalid name.																															*
+******************************************************************************************************************/
+uint32_t TimerGetValue(uint8_t Timerx)
+{
+	Timer_Reg* pTimer = TimerGetAddress(Timerx);
+
+	if(pTimer == NULL)		return 0;
+
+	return pTimer->TAV;
+}
+
+
+
+/*****************************************************************************************************************
+*	@TimerIntControl()																																															*
+*	@brief			-	This function enables/disables the time-out interrupt of Timer A, in the timer and in the NVIC.		*
+*	@Timerx			- Name of the Timer Module.																																					*
+*	@ENorDI			- ENABLE or DISABLE.																																								*
+******************************************************************************************************************/
+void TimerIntControl(uint8_t Timerx, uint8_t ENorDI)
+{
+	Timer_Reg* pTimer = TimerGetAddress(Timerx);
+	uint8_t IRQNumber;
+
+	if(pTimer == NULL)		return;																						//	Also keeps Timerx inside TimerIRQNumber[].
+
+	IRQNumber = TimerIRQNumber[Timerx - Timer0];
+	if(ENorDI == ENABLE)
+	{
+		pTimer->ICR = (1<<TIMER_ICR_TATOCINT);
+		pTimer->IMR SET_BIT(TIMER_IMR_TATOIM);
+		NVIC->EN[IRQNumber/32] = 1<<(IRQNumber%32);													//	Writing 0 to EN has no effect.
+	}
+	else
+	{
+		pTimer->IMR CLR_BIT(TIMER_IMR_TATOIM);
+		NVIC->DIS[IRQNumber/32] = 1<<(IRQNumber%32);
+	}
+}
+
+
+
+/*****************************************************************************************************************
+*	@TimerClearInt()																																																*
+*	@brief			-	This function clears the time-out interrupt of Timer A. Call it from the interrupt handler.				*
+*	@Timerx			- Name of the Timer Module.																																					*
+******************************************************************************************************************/
+void TimerClearInt(uint8_t Timerx)
+{
+	Timer_Reg* pTimer = TimerGetAddress(Timerx);
+
+	if(pTimer == NULL)		return;
+
+	pTimer->ICR = (1<<TIMER_ICR_TATOCINT);
+}
+
+
+
+/*****************************************************************************************************************
+*	@TimerGetAddress()																																															*
+*	@Timerx			-	Name of the Timer Module.																																					*
+* @return			- Module access pointer of the Timer module. NULL for an invalid name.															*
+******************************************************************************************************************/
+Timer_Reg* TimerGetAddress(uint8_t Timerx)
+{
+	switch(Timerx)
+	{
+		case Timer0:			return pTimer0;
+		case Timer1:			return pTimer1;
+		case Timer2:			return pTimer2;
+		case Timer3:			return pTimer3;
+		case Timer4:			return pTimer4;
+		case Timer5:			return pTimer5;
+		case Timer0W:			return pTimer0W;
+		case Timer1W:			return pTimer1W;
+		case Timer2W:			return pTimer2W;
+		case Timer3W:			return pTimer3W;
+		case Timer4W:			return pTimer4W;
+		case Timer5W:			return pTimer5W;
+
+		default:					return NULL;
+	}
+}
@@ -0,0 +1,92 @@
+/*****************************************************************************************************************
+*	@file			-	TM4C123xxTIMER_DRIVER.h																																							*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	This file contains prototypes of General Purpose Timer Driver APIs. Bit position macros and shorthands which are *
+*	used by the Timer Driver APIs are also defined here.																														*
+*																																																									*
+*	All APIs use Timer A of a module as a 32-bit timer:-																														*
+*	<>	16/32-bit timers (Timer0 - Timer5) are used in the concatenated 32-bit configuration.												*
+*	<>	32/64-bit timers (Timer0W - Timer5W) are used in the individual 32-bit configuration.												*
+*																																																									*
+* @Note			-	All of the code present in the this file applies to TM4C123GH6PM microcontroller.										*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#ifndef TM4C123XXTIMER_DRIVER_H
+#define TM4C123XXTIMER_DRIVER_H
+
+#include "TM4C123xx.h"
+
+/*****************************************************************************************************************
+*																								Bit Position Macros																								*
+******************************************************************************************************************/
+// Timer A Mode Register
+#define TIMER_TAMR_TAMR			0				//	Timer A Mode							Bit 0:1
+#define TIMER_TAMR_TACMR		2				//	Timer A Capture Mode
+#define TIMER_TAMR_TAAMS		3				//	Timer A Alternate Mode Select
+#define TIMER_TAMR_TACDIR		4				//	Timer A Count Direction
+#define TIMER_TAMR_TAMIE		5				//	Timer A Match Interrupt Enable
+#define TIMER_TAMR_TAWOT		6				//	Timer A Wait-on-Trigger
+#define TIMER_TAMR_TASNAPS	7				//	Timer A Snap-Shot Mode
+#define TIMER_TAMR_TAILD		8				//	Timer A Interval Load Write (1 => new TAILR is loaded on the next time-out)
+
+// Control Register
+#define TIMER_CTL_TAEN			0				//	Timer A Enable
+#define TIMER_CTL_TASTALL		1				//	Timer A Stall Enable
+#define TIMER_CTL_TBEN			8				//	Timer B Enable
+
+// Interrupt Mask / Raw Interrupt Status / Masked Interrupt Status / Interrupt Clear Registers
+#define TIMER_IMR_TATOIM		0				//	Timer A Time-Out Interrupt Mask
+#define TIMER_RIS_TATORIS		0				//	Timer A Time-Out Raw Interrupt
+#define TIMER_MIS_TATOMIS		0				//	Timer A Time-Out Masked Interrupt
+#define TIMER_ICR_TATOCINT	0				//	Timer A Time-Out Interrupt Clear
+
+
+
+/*****************************************************************************************************************
+*															Miscellaneous macros, shorthands and Global variables																*
+******************************************************************************************************************/
+// Timer Configuration (CFG Register)
+#define TIMER_CFG_CONCATENATED		0x0		//	32-bit (16/32-bit timers) or 64-bit (32/64-bit timers)
+#define TIMER_CFG_INDIVIDUAL			0x4		//	16-bit (16/32-bit timers) or 32-bit (32/64-bit timers)
+
+// @TimerMode
+#define OneShotTimer							0x1
+#define PeriodicTimer							0x2
+
+// @CountDirection
+#define CountDown									0
+#define CountUp										1
+
+
+
+/*****************************************************************************************************************
+*																					APIs Supported by this Driver																						*
+*	Below are the prototypes for driver APIs																																				*
+*																																																									*
+*	1.	TimerClockControl()		-	Enable/Disable clock for a Timer module.																						*
+*	2.	TimerInit()						-	Configure Timer A of a module as a 32-bit one-shot/periodic timer.									*
+*	3.	TimerDeInit()					-	Reset and turn off a Timer module.																									*
+*	4.	TimerStart()					-	Start Timer A.																																			*
+*	5.	TimerStop()						-	Stop Timer A.																																				*
+*	6.	TimerGetValue()				-	Read the current count of Timer A.																									*
+*	7.	TimerIntControl()			-	Enable/Disable the time-out interrupt of Timer A (also in the NVIC).								*
+*	8.	TimerClearInt()				-	Clear the time-out interrupt of Timer A. Call it from the interrupt handler.				*
+*	9.	TimerGetAddress()			-	Get the module access pointer of a Timer module.																		*
+******************************************************************************************************************/
+void TimerClockControl(uint8_t Timerx, uint8_t ENorDI);
+void TimerInit(uint8_t Timerx, uint8_t TimerMode, uint8_t CountDirection, uint32_t Period);
+void TimerDeInit(uint8_t Timerx);
+
+void TimerStart(uint8_t Timerx);
+void TimerStop(uint8_t Timerx);
+uint32_t TimerGetValue(uint8_t Timerx);
+
+void TimerIntControl(uint8_t Timerx, uint8_t ENorDI);
+void TimerClearInt(uint8_t Timerx);
+
+Timer_Reg* TimerGetAddress(uint8_t Timerx);
+
+#endif
@@ -29,7 +29,124 @@ uint8_t UARTTransferPending = 0b00000000;
 uint8_t* UARTTransferBuffer[8];
 
 // @UARTTransferLength - Stores the lengths (in bytes) of data buffers of each UART peripheral.
-int8_t UARTTransferLength[8];
+uint32_t UARTTransferLength[8];
+
+// @UARTIRQNumber - Interrupt numbers of UART0 - UART7.
+const uint8_t UARTIRQNumber[8] = {5, 6, 33, 59, 60, 61, 62, 63};
+
+// Ring buffers of the buffered APIs. The Tx head and the Rx tail are written only by the application, the Tx tail and
+// the Rx head only by UARTIT_H() (and by UARTWrite() while the Tx interrupt is masked).
+typedef struct
+{
+	uint8_t						TxBuf[UART_TX_BUFFER_SIZE];
+	uint8_t						RxBuf[UART_RX_BUFFER_SIZE];
+	__vo uint32_t			TxHead;
+	__vo uint32_t			TxTail;
+	__vo uint32_t			RxHead;
+	__vo uint32_t			RxTail;
+}UARTRing;
+
+static UARTRing UARTRings[8];
+
+// @UARTPolled - Bit n is set while UARTn is in the polled buffered mode (see UARTStartPolled()), so UARTPoll() serves it.
+static uint8_t UARTPolled = 0b00000000;
+
+// @UARTDMAChannel - uDMA channels (Rx, Tx) of UART0 - UART7 and their channel encodings (see Table 9-1 on Pg No. 587).
+static const uint8_t UARTDMARxChannel[8]	= {8, 22, 12, 16, 18, 6, 10, 20};
+static const uint8_t UARTDMATxChannel[8]	= {9, 23, 13, 17, 19, 7, 11, 21};
+static const uint8_t UARTDMAEncoding[8]		= {0, 0, 1, 2, 2, 2, 2, 2};
+
+// @UARTDMAArbSize - Largest burst which fits in the FIFO at each @FIFOLevel. A Tx burst request comes when the Tx
+// FIFO drains to the level (so 16 - level entries are free), an Rx burst request when the Rx FIFO fills to it.
+static const uint8_t UARTDMATxArbSize[5]	= {DMA_Arb_8, DMA_Arb_8, DMA_Arb_8, DMA_Arb_4, DMA_Arb_2};
+static const uint8_t UARTDMARxArbSize[5]	= {DMA_Arb_2, DMA_Arb_4, DMA_Arb_8, DMA_Arb_8, DMA_Arb_8};
+
+// Transfers of the DMA APIs. The buffers hold the data which has not been given to a control structure yet.
+typedef struct
+{
+	const uint8_t*		TxBuf;
+	__vo uint32_t			TxLeft;
+	uint8_t*					RxBuf;
+	__vo uint32_t			RxLeft;
+	__vo uint8_t			TxBusy;
+	__vo uint8_t			RxBusy;
+}UARTDMATransfer;
+
+static UARTDMATransfer UARTDMATransfers[8];
+
+// @UARTStreamArbSize - Half of the Rx trigger level at each @FIFOLevel, so that a burst never empties the Rx FIFO and
+// the Rx time-out can always report the end of a message.
+static const uint8_t UARTStreamArbSize[5]	= {DMA_Arb_1, DMA_Arb_2, DMA_Arb_4, DMA_Arb_4, DMA_Arb_4};
+
+// Continuous receive. A half whose control structure is not stopped belongs to the controller. A stopped half with a
+// length in Ready[] belongs to the application until UARTReleaseBlock(). Fill is written only by UARTDMA_H(), Next only
+// by the application.
+typedef struct
+{
+	uint8_t*					Buf[2];
+	uint32_t					Size;
+	__vo uint32_t			Ready[2];
+	__vo uint8_t			Fill;									//	Half which the controller is filling
+	__vo uint8_t			Next;									//	Half which UARTGetBlock() returns next
+	__vo uint8_t			Active;
+	__vo uint32_t			Stalls;								//	Times both halves were held by the application
+}UARTStream;
+
+static UARTStream UARTStreams[8];
+
+// Framed transport. A slot with a length in Ready[] holds a decoded frame and belongs to the application until
+// UARTReleaseFrame(). Fill and the decoder state are written only by UARTFrame_H(), Next only by the application. The
+// encoder state is written by UARTSendFrame() while the Tx interrupt is masked, and by UARTFrame_H() otherwise.
+typedef struct
+{
+	uint8_t*					Buf;
+	uint32_t					SlotSize;
+	__vo uint32_t			Ready[UART_FRAME_SLOTS];
+	__vo uint8_t			Fill;									//	Slot which the decoder is writing
+	__vo uint8_t			Next;									//	Slot which UARTGetFrame() returns next
+	__vo uint8_t			Active;
+	uint8_t						Framing;
+	uint8_t						InFrame;							//	Bytes of a frame have been received since the last delimiter
+	uint8_t						Discard;							//	Rest of the frame is dropped (too long, no free slot, line error)
+	uint8_t						Escape;								//	SLIP: the last byte was UART_SLIP_ESC
+	uint8_t						Code;									//	COBS: code byte of the current block (0 before the first one)
+	uint8_t						Left;									//	COBS: data bytes left in the current block
+	uint32_t					Len;									//	Bytes decoded into the current slot
+	
+	const uint8_t*		TxBuf;
+	uint32_t					TxLen;
+	uint32_t					TxPos;
+	uint8_t						TxCode;								//	COBS: code byte of the block being sent (0 before the first one)
+	uint8_t						TxLeft;								//	COBS: data bytes left in the block being sent
+	uint8_t						TxPending;						//	SLIP: byte to be sent before the next data byte (0 if none)
+	uint8_t						TxDone;								//	The closing delimiter has been sent
+	__vo uint8_t			TxBusy;
+}UARTFramer;
+
+static UARTFramer UARTFramers[8];
+
+// @UARTStandardRates - Rates to which UARTAutoBaud() rounds a measured rate (see UART_AUTOBAUD_TOLERANCE).
+static const uint32_t UARTStandardRates[] = { 1200, 2400, 4800, 9600, 14400, 19200, 38400, 57600, 115200,
+																							230400, 460800, 921600, 1000000 };
+
+// Line-error and load counters of each UART (see UARTGetStats()). Written by the receive paths and the handler helpers.
+static UARTStats UARTCounters[8];
+
+static void UARTEnableIRQ(uint8_t index);												// see definitions below
+static void UARTFillTxFIFO(UART_Reg* pUART, UARTRing* pRing);
+static void UARTStartRings(uint8_t index);
+static void UARTDMASetup(uint8_t index, uint8_t Channel, uint8_t UseBurst);
+static void UARTDMANextTx(uint8_t index);
+static void UARTDMANextRx(uint8_t index);
+static void UARTStreamArm(uint8_t index, uint8_t Half);
+static void UARTStreamCollect(uint8_t index);
+static void UARTStreamFlush(uint8_t index);
+static void UARTCountErrors(uint8_t index, uint32_t Data);
+static void UARTFramePut(uint8_t index, uint32_t Data);
+static int32_t UARTFrameNextByte(UARTFramer* pFramer);
+static void UARTFrameFillTxFIFO(UART_Reg* pUART, UARTFramer* pFramer);
+static uint8_t UARTWaitRxLevel(GPIO_reg* pGPIO, uint8_t Mask, uint8_t Level);
+static uint32_t UARTStandardBaud(uint32_t Baud);
 
 
 
@@ -74,20 +191,60 @@ void UARTClockControl(uint8_t UARTx, uint8_t ENorDI)
 
 
 
-/******************************************************************************************************************
+/*****************************************************************************************************************
 *	@UARTInit()																																																			*
-*	@brief				-	This function Initializes an UART module.																												*
+*	@brief				-	This function Initializes an UART module at one of the standard baud rates.											*
 *	@UARTx				- Name of the UART Module.																																				*
 * @WordLength		- Length of the data bits to be sent at a time.																										*
 * @BaudRate			- Rate of data transmission.																																			*
 *	@ParityMode		-	Even/Odd/No Parity.																																							*
 *	@NoOfStopBits	-	Used to select if one stop bit is to be transmitted, or two.																		*
 *																																																									*
-*	@Note					->	See Pg No. 902 (Section 14.4) for detailed steps on Initialization and Configuration.					*
+*	@Note					->	See UARTInitBaud() for any other baud rate.																										*
 *								->	Use standard macros defined in the UART header file for all the four variables.								*
 ******************************************************************************************************************/
 void UARTInit(uint8_t UARTx, uint8_t WordLength, uint8_t BaudRate, uint8_t ParityMode, uint8_t NoOfStopBits, uint8_t FIFOControl)
 {
+	if(BaudRate > BaudRate_115200)
+		return;
+	
+	UARTInitBaud(UARTx, WordLength, BaudRateArray[BaudRate]*100UL, ParityMode, NoOfStopBits, FIFOControl);
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTInitBaud()																																																	*
+*	@brief				-	This function Initializes an UART module at any baud rate.																			*
+*	@UARTx				- Name of the UART Module.																																				*
+* @WordLength		- Length of the data bits to be sent at a time.																										*
+* @Baud					- Baud rate in bits per second (Ex: 460800, 921600, 1000000).																			*
+*	@ParityMode		-	Even/Odd/No Parity.																																							*
+*	@NoOfStopBits	-	Used to select if one stop bit is to be transmitted, or two.																		*
+* @return				-	Achieved baud rate, or 0 if the baud rate can't be reached with SYS_CLK or an argument is invalid.	*
+*									Use UART_BAUD_ERROR_PPM(Baud, <return value>) to get the error.																	*
+*									All the arguments are checked before the first register write, so the UART and its pins aren't	*
+*									touched when 0 is returned.																																			*
+*																																																									*
+*	@Note					->	See Pg No. 902 (Section 14.4) for detailed steps on Initialization and Configuration.					*
+*								->	The divisor is computed with integer math only (see UART_BRD64). High-speed mode							*
+*										(UART_CTL_HSE, divide by 8) is selected when the baud rate is above SYS_CLK/16, and also when	*
+*										the error with the divide by 16 is above UART_HSE_ERROR_PPM and the divide by 8 gives a lower	*
+*										error (see UART_USE_HSE).																																			*
+*								->	RTS/CTS flow control isn't changed here (it is off after reset). See UARTSetFlowControl().		*
+******************************************************************************************************************/
+uint32_t UARTInitBaud(uint8_t UARTx, uint8_t WordLength, uint32_t Baud, uint8_t ParityMode, uint8_t NoOfStopBits, uint8_t FIFOControl)
+{
+	if( Baud == 0 || UARTGetAddress(UARTx) == NULL || ParityMode > OddParity || WordLength > _8bit_WordLength ||
+			NoOfStopBits > TwoStopBits )
+		return 0;
+	
+	uint8_t HSE = UART_USE_HSE(SYS_CLK, Baud);
+	uint32_t BRD64 = UART_BRD64(SYS_CLK, Baud, HSE);
+	
+	if(BRD64 < UART_BRD64_MIN || BRD64 > UART_BRD64_MAX)
+		return 0;
+	
 	uint8_t TXPIN = UARTGetTxPin(UARTx);
 	uint8_t RXPIN = UARTGetRxPin(UARTx);
 	
@@ -95,7 +252,7 @@ void UARTInit(uint8_t UARTx, uint8_t WordLength, uint8_t BaudRate, uint8_t Parit
 	uint8_t RxPinNum = getPinNumber(RXPIN);
 	uint8_t UartPins = ( (1<<TxPinNum) | (1<<RxPinNum) );
 	
-	GPIO_reg* pGPIO = getPortAddr(TXPIN, APB_BUS);
+	GPIO_reg* pGPIO = getPortAddr(TXPIN, SELECTED_BUS);
 	UART_Reg* pUART = UARTGetAddress(UARTx);
 	
 	UARTClockControl(UARTx, ENABLE);									// Step 1 - Section 14.4: Enable clock to the UART Module.
@@ -115,18 +272,13 @@ void UARTInit(uint8_t UARTx, uint8_t WordLength, uint8_t BaudRate, uint8_t Parit
 	// Step 5 - Section 14.4: Set the alternate function number (1 for UART) for the pins.
 	pGPIO->GPIO_PCTL |=	 ( ( 0x1<<(TxPinNum*4) ) | ( 0x1<<(RxPinNum*4) ) );
 	
-	uint8_t CLK_DIV = GET_BIT(pUART->CTL, UART_CTL_HSE)?8:16;
-	
-	float BRD = (SYS_CLK)/( CLK_DIV*100.0*BaudRateArray[BaudRate] );
-	
-	
-	uint16_t iBRD = BRD;																			//	Integer Part of Baud Rate
-	uint8_t fBRD = (uint8_t)( (BRD - iBRD)*64 + 0.5 );				//	Fractional Part of Baud Rate Divisor
-	
 	//	Step Numbers written below, refer to the steps on Pg# 903.
 	pUART->CTL CLR_BIT(UART_CTL_UARTEN);					//	Step 1: Disable the UART Module
-	pUART->IBRD = iBRD;														//	Step 2:	Write integer part of Baud Rate Divisor
-	pUART->FBRD = fBRD;														//	Step 3: Write fractional part of Baud Rate Divisor
+	pUART->IBRD = BRD64 >> 6;											//	Step 2:	Write integer part of Baud Rate Divisor
+	pUART->FBRD = BRD64 & 0x3F;										//	Step 3: Write fractional part of Baud Rate Divisor
+	
+	if(HSE)		pUART->CTL SET_BIT(UART_CTL_HSE);
+	else			pUART->CTL CLR_BIT(UART_CTL_HSE);
 	
 	// Step 4: Configure LCRH Register
 	// Stick Parity Select & Send Break fields aren't changed right now. It will be implemented later.
@@ -140,7 +292,6 @@ void UARTInit(uint8_t UARTx, uint8_t WordLength, uint8_t BaudRate, uint8_t Parit
 		case OddParity:					pUART->LCRH SET_BIT(UART_LCRH_PEN);
 														pUART->LCRH CLR_BIT(UART_LCRH_EPS);
 														break;
-		default:								return;
 	}
 	
 	switch(WordLength)
@@ -157,8 +308,6 @@ void UARTInit(uint8_t UARTx, uint8_t WordLength, uint8_t BaudRate, uint8_t Parit
 		case _8bit_WordLength:	pUART->LCRH SET_BIT(5);
 														pUART->LCRH SET_BIT(6);
 														break;
-		
-		default:								return;
 	}
 	
 	switch(NoOfStopBits)
@@ -176,13 +325,14 @@ void UARTInit(uint8_t UARTx, uint8_t WordLength, uint8_t BaudRate, uint8_t Parit
 	// Step 5: Configure Clock Source
 	pUART->CC = 0;						//	Set Clock source to system clock. (Set it as 0x5 for PIOSC)
 	
-	// Step 6: Enable uDMA
-	// This will be implemented later.
-	
+	// Step 6: uDMA is enabled per transfer by UARTSendDMA()/UARTRecvDMA() (UARTDMACTL).
+	pUART->DMACTL = 0;
 	
 	pUART->LCRH SET_BIT(UART_LCRH_FEN);
 	// Step 7: Enable the UART Module
 	pUART->CTL SET_BIT(UART_CTL_UARTEN);
+	
+	return UART_ACHIEVED_BAUD(SYS_CLK, BRD64, HSE);
 }
 
 
@@ -204,62 +354,348 @@ void UARTDeInit(uint8_t UARTx)
 
 
 
+/*****************************************************************************************************************
+*	@UARTSetFIFOLevels()																																														*
+*	@brief				-	This function selects the FIFO levels at which the Tx and Rx interrupts of an UART module come.	*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@TxLevel			-	Tx interrupt comes when the Tx FIFO drains to this level. Use @FIFOLevel macros.								*
+*	@RxLevel			-	Rx interrupt comes when the Rx FIFO fills to this level. Use @FIFOLevel macros.									*
+* @return				-	Nothing.																																												*
+*																																																									*
+*	@Note					->	A higher Rx level means fewer interrupts (FIFOLevel_7_8 gives one interrupt per 14 bytes). Bytes	*
+*										which don't reach the level are flushed by the Rx time-out interrupt after 32 bit periods			*
+*										without data, which UARTRecvIT() and UARTStartBuffered() always enable.												*
+*								->	A lower Tx level means fewer interrupts, but less time to refill the FIFO before it runs empty.	*
+*								->	The levels only apply while the FIFOs are enabled (UART_LCRH_FEN).														*
+******************************************************************************************************************/
+void UARTSetFIFOLevels(uint8_t UARTx, uint8_t TxLevel, uint8_t RxLevel)
+{
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	
+	if(TxLevel > FIFOLevel_7_8 || RxLevel > FIFOLevel_7_8)
+		return;
+	
+	pUART->IFLS = (TxLevel<<UART_IFLS_TX) | (RxLevel<<UART_IFLS_RX);
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTSetFlowControl()																																														*
+*	@brief				-	This function enables/disables RTS/CTS hardware flow control of an UART module and muxes the		*
+*									flow control pins. Call it after UARTInit()/UARTInitBaud().																			*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@HWFlowControl	-	EnableHWFlowControl or DisableHWFlowControl (see @HWFlowControl).															*
+* @return				-	1 if flow control has been configured, 0 if the module has no flow control pins.								*
+*																																																									*
+*	@Note					->	With flow control enabled, the transmitter only starts a byte while CTS is asserted, and RTS	*
+*										is de-asserted while the Rx FIFO is at or above its trigger level (see UARTSetFIFOLevels()).	*
+*										The other side stops sending instead of overrunning the Rx FIFO.															*
+*								->	Only UART1 has flow control signals on this device. U1RTS/U1CTS are used on PC4/PC5, since		*
+*										PF0/PF1 are locked (PF0) and wired to SW2 and the red LED on the LaunchPad. PC4/PC5 are also	*
+*										the pins of UART4, so UART4 can't be used along with it.																			*
+*								->	The module is disabled while CTL is changed, after the byte being sent has gone out.					*
+******************************************************************************************************************/
+uint8_t UARTSetFlowControl(uint8_t UARTx, uint8_t HWFlowControl)
+{
+	uint8_t RTSPIN = UARTGetRTSPin(UARTx);
+	uint8_t CTSPIN = UARTGetCTSPin(UARTx);
+	
+	if(RTSPIN == UART_NO_PIN || CTSPIN == UART_NO_PIN)
+		return 0;
+	
+	uint8_t RTSPinNum = getPinNumber(RTSPIN);
+	uint8_t CTSPinNum = getPinNumber(CTSPIN);
+	uint8_t FlowPins = ( (1<<RTSPinNum) | (1<<CTSPinNum) );
+	
+	GPIO_reg* pGPIO = getPortAddr(RTSPIN, SELECTED_BUS);
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint32_t Enabled = pUART->CTL & (1<<UART_CTL_UARTEN);
+	
+	GPIO_ClockControl(getPortName(RTSPIN), ENABLE);
+	
+	WaitWhileUARTisBusy(pUART);
+	pUART->CTL CLR_BIT(UART_CTL_UARTEN);									//	CTL must not be changed while the module is enabled.
+	
+	if(HWFlowControl == EnableHWFlowControl)
+	{
+		pGPIO->GPIO_AFSEL |= FlowPins;
+		pGPIO->GPIO_DR8R |= FlowPins;
+		pGPIO->GPIO_DEN	|=	FlowPins;
+		
+		pGPIO->GPIO_PCTL &= ~( ( 0xF<<(RTSPinNum*4) ) | ( 0xF<<(CTSPinNum*4) ) );
+		pGPIO->GPIO_PCTL |=	 ( ( 0x8<<(RTSPinNum*4) ) | ( 0x8<<(CTSPinNum*4) ) );		//	Alternate function 8 is U1RTS/U1CTS.
+		
+		pUART->CTL |= (1<<UART_CTL_RTSEN) | (1<<UART_CTL_CTSEN);
+	}
+	else
+	{
+		pUART->CTL &= ~( (1<<UART_CTL_RTSEN) | (1<<UART_CTL_CTSEN) );
+		
+		pGPIO->GPIO_PCTL &= ~( ( 0xF<<(RTSPinNum*4) ) | ( 0xF<<(CTSPinNum*4) ) );
+		pGPIO->GPIO_AFSEL &= ~FlowPins;
+	}
+	
+	pUART->CTL |= Enabled;
+	return 1;
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTSet9BitMode()																																															*
+*	@brief				-	This function enables/disables the 9-bit (multidrop) mode of an UART module, in which the receiver	*
+*									only takes the bytes which are addressed to this node.																					*
+* @UARTx				-	Name of the UART Module. It must have been initialized with an 8-bit word length.								*
+*	@ENorDI				-	ENABLE or DISABLE.																																							*
+*	@Address			-	Address of this node.																																						*
+*	@Mask					-	Address bits which are compared (0xFF for a single address). An address byte matches when				*
+*									(received & Mask) == (Address & Mask), so a mask can also select a group/broadcast address.			*
+* @return				-	Nothing.																																												*
+*																																																									*
+*	@Note					->	The parity bit carries the 9th bit: 1 for an address byte, 0 for a data byte. Data bytes are	*
+*										sent with the bit at 0 (stick parity), so the parity selected at init no longer applies.			*
+*										UARTSendAddress() sends an address byte.																											*
+*								->	After an address byte which matches, the address byte and all the data bytes which follow are	*
+*										put in the Rx FIFO, until an address byte which doesn't match. Everything else is discarded by	*
+*										the hardware and causes no interrupt.																													*
+*								->	UART_RIS_9BIT is set when a matching address byte has been received. Enable UART_IM_9BIT to		*
+*										get an interrupt at the start of every message for this node.																	*
+******************************************************************************************************************/
+void UARTSet9BitMode(uint8_t UARTx, uint8_t ENorDI, uint8_t Address, uint8_t Mask)
+{
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	
+	WaitWhileUARTisBusy(pUART);
+	
+	if(ENorDI == ENABLE)
+	{
+		pUART->LCRH |= (1<<UART_LCRH_PEN) | (1<<UART_LCRH_SPS) | (1<<UART_LCRH_EPS);		//	9th bit is 0 (data).
+		pUART->_9BITAMASK = Mask;
+		pUART->_9BITADDR = Address | (1<<UART_9BITADDR_9BITEN);
+	}
+	else
+	{
+		pUART->_9BITADDR = 0;
+		pUART->LCRH &= ~( (1<<UART_LCRH_PEN) | (1<<UART_LCRH_SPS) | (1<<UART_LCRH_EPS) );
+	}
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTAutoBaud()																																																	*
+*	@brief				-	This function measures the baud rate of the other side on a sync byte (0x55), and switches the UART	*
+*									to it. The Rx pin is read as a GPIO input while the edges of the sync byte are timed, and then	*
+*									given back to the UART.																																					*
+* @UARTx				-	Name of the UART Module. It must have been initialized (UARTInit()/UARTInitBaud()) with the word	*
+*									length, parity and stop bits of the link; the initial rate doesn't matter.											*
+*	@Timerx				-	Timer module used to time the edges. It is stopped when the function returns.										*
+*	@Timeout			-	No of system clock cycles to wait for a valid sync byte.																				*
+* @return				-	Achieved baud rate, or 0 if no valid sync byte has come in time (the rate isn't changed).				*
+*																																																									*
+*	@Note					->	0x55 starts with 5 falling edges two bit periods apart (start bit, bits 1, 3, 5 and 7 low), so	*
+*										the first and the fifth falling edge are 8 bit periods apart, whatever follows. The last five	*
+*										falling edges are checked after every edge, and taken as a sync byte when all four intervals	*
+*										are within 25% of a quarter of the total, so bytes which come before the sync byte are skipped.	*
+*								->	Rates within UART_AUTOBAUD_TOLERANCE percent of a standard rate are rounded to it, as the			*
+*										measurement is a few cycles off at high rates (8 bit periods are 139 cycles at 921600).				*
+*								->	The sync byte itself and anything received meanwhile is discarded. Hosts usually repeat the		*
+*										sync byte until they get an answer; the repeats which come after the measurement are received.	*
+*								->	It blocks the caller, and may run a few bit periods at UART_AUTOBAUD_MIN_BAUD past Timeout.		*
+*										Interrupts which come during the sync byte make the measurement fail or less accurate.				*
+******************************************************************************************************************/
+uint32_t UARTAutoBaud(uint8_t UARTx, uint8_t Timerx, uint32_t Timeout)
+{
+	uint8_t RXPIN = UARTGetRxPin(UARTx);
+	uint8_t RxMask = 1 << getPinNumber(RXPIN);
+	GPIO_reg* pGPIO = getPortAddr(RXPIN, SELECTED_BUS);
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	Timer_Reg* pTimer = TimerGetAddress(Timerx);
+	uint32_t Edges[5];
+	uint32_t Start, Interval;
+	uint32_t Width = 0, BRD64 = 0;
+	uint32_t Baud = 0;
+	uint32_t Count = 0;
+	uint32_t Enabled, Bits;
+	uint8_t HSE = 0;
+	uint8_t i;
+	
+	TimerInit(Timerx, PeriodicTimer, CountUp, 0);
+	TimerStart(Timerx);
+	
+	pGPIO->GPIO_AFSEL &= ~RxMask;												//	DEN is already set, the pin reads the line.
+	Start = pTimer->TAV;
+	
+	while(Baud == 0 && pTimer->TAV - Start < Timeout)
+	{
+		// Every falling edge is timed. A level which lasts too long (idle line) starts the search again.
+		if( !UARTWaitRxLevel(pGPIO, RxMask, 1) || !UARTWaitRxLevel(pGPIO, RxMask, 0) )
+		{
+			Count = 0;
+			continue;
+		}
+		Edges[Count % 5] = pTimer->TAV;
+		if(++Count < 5)
+			continue;
+		
+		// The last five falling edges (the oldest is at Count % 5) must be evenly spaced over 8 bit periods.
+		Width = Edges[(Count+4) % 5] - Edges[Count % 5];
+		for(i = 1; i < 5; i++)
+		{
+			Interval = Edges[(Count+i) % 5] - Edges[(Count+i-1) % 5];
+			if(Interval*16 < Width*3 || Interval*16 > Width*5)
+				break;
+		}
+		if(i < 5 || Width == 0)
+			continue;
+		
+		Baud = UARTStandardBaud( (SYS_CLK*8 + Width/2) / Width );
+		HSE = UART_USE_HSE(SYS_CLK, Baud);
+		BRD64 = UART_BRD64(SYS_CLK, Baud, HSE);
+		if(BRD64 < UART_BRD64_MIN || BRD64 > UART_BRD64_MAX)
+			Baud = 0;
+	}
+	
+	if(Baud)
+	{
+		// Let the rest of the sync byte pass before the pin is given back (the oldest edge is its start bit).
+		Bits = 7 + ( (pUART->LCRH >> UART_LCRH_WLEN) & 0x3 ) + GET_BIT(pUART->LCRH, UART_LCRH_PEN) + GET_BIT(pUART->LCRH, UART_LCRH_STP2);
+		while( pTimer->TAV - Edges[Count % 5] < (Width*Bits)/8 );
+		
+		Enabled = pUART->CTL & (1<<UART_CTL_UARTEN);
+		WaitWhileUARTisBusy(pUART);
+		pUART->CTL CLR_BIT(UART_CTL_UARTEN);
+		pUART->IBRD = BRD64 >> 6;
+		pUART->FBRD = BRD64 & 0x3F;
+		if(HSE)		pUART->CTL SET_BIT(UART_CTL_HSE);
+		else			pUART->CTL CLR_BIT(UART_CTL_HSE);
+		pUART->LCRH = pUART->LCRH;																			//	IBRD/FBRD are loaded on a write to LCRH.
+		pUART->CTL |= Enabled;
+		Baud = UART_ACHIEVED_BAUD(SYS_CLK, BRD64, HSE);
+	}
+	TimerStop(Timerx);
+	
+	pGPIO->GPIO_AFSEL |= RxMask;
+	while( !GET_BIT(pUART->FR, UART_FR_RXFE) )
+		(void)pUART->DR;
+	pUART->ICR = UART_RIS_ERRORS;
+	
+	return Baud;
+}
+
+
+
 /*------------------------------------------ DATA TRANSFER FUNCTIONS --------------------------------------------*/
 
 
 
+/*****************************************************************************************************************
+*	@UARTSendByte()																																																	*
+*	@brief				-	This function puts one byte into the Tx FIFO of an UART module.																	*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@TxData				-	Byte to be sent.																																								*
+* @return				-	Nothing.																																												*
+*																																																									*
+*	@Note					-	It waits only while the Tx FIFO is full, not until the previous byte has been shifted out. Use	*
+*									WaitWhileUARTisBusy() when the line must be idle (e.g. before disabling the module).						*
+******************************************************************************************************************/
 void UARTSendByte(uint8_t UARTx, uint8_t TxData)
 {
 	UART_Reg* pUART = UARTGetAddress(UARTx);
 	
-	WaitWhileUARTisBusy(pUART);
+	WaitWhileTxFIFOisFull(pUART);
 	pUART->DR = TxData;
 }
 
 
 
+/*****************************************************************************************************************
+*	@UARTSendAddress()																																															*
+*	@brief				-	This function sends an address byte in 9-bit mode (see UARTSet9BitMode()). The data bytes which	*
+*									follow, sent with any of the send APIs, go to the node(s) with this address.										*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@Address			-	Address of the node(s).																																					*
+* @return				-	Nothing.																																												*
+*																																																									*
+*	@Note					-	The 9th bit is selected for the whole line, so it waits until the Tx FIFO is empty before the		*
+*									address byte, and until the address byte is out before switching back to data bytes.						*
+******************************************************************************************************************/
+void UARTSendAddress(uint8_t UARTx, uint8_t Address)
+{
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	
+	WaitWhileUARTisBusy(pUART);
+	pUART->LCRH CLR_BIT(UART_LCRH_EPS);					//	Stick parity with EPS clear sends the 9th bit as 1 (address).
+	pUART->DR = Address;
+	WaitWhileUARTisBusy(pUART);
+	pUART->LCRH SET_BIT(UART_LCRH_EPS);
+}
+
+
+
 uint8_t UARTRecvByte(uint8_t UARTx)
 {
 	UART_Reg* pUART = UARTGetAddress(UARTx);
 	
 	WaitWhileUARTisBusy(pUART);
 	
-	uint8_t RxData;
+	uint32_t RxData;
 	RxData = pUART->DR;
+	if(RxData & UART_DR_ERRORS)
+		UARTCountErrors(UARTx - UART0, RxData);
 	
-	return RxData;
+	return (uint8_t)RxData;
 }
 
 
-void UARTSend(uint8_t UARTx, uint8_t *TxBuf, int8_t Len)
+/*****************************************************************************************************************
+*	@UARTSend()																																																			*
+*	@brief				-	This function sends a buffer over an UART module. It waits until the last byte is in the Tx FIFO.	*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@TxBuf				-	Data to be sent.																																								*
+*	@Len					-	No of bytes to be sent.																																					*
+* @return				-	Nothing.																																												*
+*																																																									*
+*	@Note					-	Bytes are written while TXFF is clear, so the FIFO is kept full and the next byte is always ready	*
+*									when the shift register finishes the previous one.																							*
+******************************************************************************************************************/
+void UARTSend(uint8_t UARTx, uint8_t *TxBuf, uint32_t Len)
 {
 	UART_Reg* pUART = UARTGetAddress(UARTx);
 	
 	while(Len>0)
 	{
-		WaitWhileUARTisBusy(pUART);
+		WaitWhileTxFIFOisFull(pUART);
 		
-		pUART->DR = (*TxBuf);						//	Pick data from transmit buffer and put it into data register.
-		TxBuf++;												//	Step the pointer, so that it points to the next data element.
-		Len--;
+		// Write as many bytes as the FIFO takes before reading FR again.
+		do
+		{
+			pUART->DR = (*TxBuf);					//	Pick data from transmit buffer and put it into data register.
+			TxBuf++;											//	Step the pointer, so that it points to the next data element.
+			Len--;
+		}while( Len>0 && !GET_BIT(pUART->FR, UART_FR_TXFF) );
 	}
 }
 
-void UARTRecv(uint8_t UARTx, uint8_t *RxBuf, int8_t Len)
+void UARTRecv(uint8_t UARTx, uint8_t *RxBuf, uint32_t Len)
 {
 	UART_Reg* pUART = UARTGetAddress(UARTx);
 	
 	while(Len>0)
 	{
 		WaitWhileUARTisBusy(pUART);
-		*RxBuf = (uint8_t)(pUART->DR);	//	Pick data from Data register and put it into receive buffer.
+		uint32_t Data = pUART->DR;
+		if(Data & UART_DR_ERRORS)
+			UARTCountErrors(UARTx - UART0, Data);
+		*RxBuf = (uint8_t)Data;					//	Pick data from Data register and put it into receive buffer.
 		RxBuf++;												//	Step the pointer, so that it points to the next data element.
 		Len--;
 	}
 }
 
 
-uint8_t UARTSendIT(uint8_t UARTx, uint8_t *TxBuf, uint8_t Len)
+uint8_t UARTSendIT(uint8_t UARTx, uint8_t *TxBuf, uint32_t Len)
 {
 	uint8_t index = (UARTx - 0xE);
 	
@@ -274,24 +710,17 @@ uint8_t UARTSendIT(uint8_t UARTx, uint8_t *TxBuf, uint8_t Len)
 	
 	UART_Reg* pUART = UARTGetAddress(UARTx);
 	
-	// configure interrupt registers here
-	pUART->IM SET_BIT( UART_IM_TX );					//	Tx Interrupt mask in UART registers.
-	
-	/*	UART #		:		0			1			2			3			4			5			6			7
-	*		INTR #		:		5			6			33		59		60		61		62		63
-	*		NVIC Reg	:		0			0			1			1			1			1			1			1
-	*		Bit #			:		5			6			1			27		28		29		30		31
-	*/
-	if(index <= 1)					NVIC->EN[0] SET_BIT( (index + 5) );
-	else if( index == 2)		NVIC->EN[1] SET_BIT( 1 );
-	else										NVIC->EN[1] SET_BIT( (index + 24) );
+	// Fill the Tx FIFO right away. The Tx interrupt comes when the FIFO drains below its trigger level.
+	pUART->IM CLR_BIT( UART_IM_TX );
+	UARTSendIT_H(UARTx);
+	UARTEnableIRQ(index);
 	
 	
 	// done.
 	return 0;
 }
 
-uint8_t UARTRecvIT(uint8_t UARTx, uint8_t *RxBuf, uint8_t Len)
+uint8_t UARTRecvIT(uint8_t UARTx, uint8_t *RxBuf, uint32_t Len)
 {
 	uint8_t index = (UARTx - 0xE);
 	
@@ -306,17 +735,10 @@ uint8_t UARTRecvIT(uint8_t UARTx, uint8_t *RxBuf, uint8_t Len)
 	
 	UART_Reg* pUART = UARTGetAddress(UARTx);
 	
-	// configure interrupt registers here
-	pUART->IM SET_BIT( UART_IM_RX );					//	Rx Interrupt mask in UART registers.
+	// Rx interrupt comes at the Rx FIFO trigger level, Rx time-out when fewer bytes have been waiting for a while.
+	pUART->IM |= (1<<UART_IM_RX) | (1<<UART_IM_RT);
 	
-	/*	UART #		:		0			1			2			3			4			5			6			7
-	*		INTR #		:		5			6			33		59		60		61		62		63
-	*		NVIC Reg	:		0			0			1			1			1			1			1			1
-	*		Bit #			:		5			6			1			27		28		29		30		31
-	*/
-	if(index <= 1)					NVIC->EN[0] SET_BIT( (index + 5) );
-	else if( index == 2)		NVIC->EN[1] SET_BIT( 1 );
-	else										NVIC->EN[1] SET_BIT( (index + 24) );
+	UARTEnableIRQ(index);
 	
 	
 	// done.
@@ -324,159 +746,1445 @@ uint8_t UARTRecvIT(uint8_t UARTx, uint8_t *RxBuf, uint8_t Len)
 }
 
 
-/*---------------------------------------------- HELPER FUNCTIONS -----------------------------------------------*/
-
-
-
 /******************************************************************************************************************
-* @UARTGetAddress()																																																*
-* @UARTx	-	Name of the UART Module whose address is required.																										*
-* @return	- Access pointer of the requested UART Module.																													*
+*	@UARTStartBuffered()																																														*
+*	@brief				-	This function starts the buffered (ring buffer) mode of an UART module.													*
+* @UARTx				-	Name of the UART Module. It must have been initialized with UARTInit().													*
+* @return				-	Nothing.																																												*
 *																																																									*
-* @Note		- Returns Null if incorrect name is given to the function.																							*
+*	@Note					-	Received bytes are collected into the Rx ring by UARTIT_H(), both at the Rx FIFO trigger level and *
+*									on the Rx time-out, so the last bytes of a message don't wait in the FIFO.											*
+*									Don't use UARTSendIT()/UARTRecvIT() on the same UART in buffered mode.													*
 ******************************************************************************************************************/
-UART_Reg* UARTGetAddress(uint8_t UARTx)
+void UARTStartBuffered(uint8_t UARTx)
 {
-	switch(UARTx)
-	{
-		case UART0:			return pUART0;
-		case UART1:			return pUART1;
-		case UART2:			return pUART2;
-		case UART3:			return pUART3;
-		case UART4:			return pUART4;
-		case UART5:			return pUART5;
-		case UART6:			return pUART6;
-		case UART7:			return pUART7;
-		
-		default:				return NULL;
-	}
+	uint8_t index = (UARTx - UART0);
+	
+	UARTPolled CLR_BIT(index);
+	UARTStartRings(index);
+	UARTEnableIRQ(index);
 }
 
 
 
 /******************************************************************************************************************
-* @UARTGetTxPin()																																																	*
-* @UARTx	-	Name of the UART Module whose Tx Pin is required.																											*
-* @return	- Tx Pin of the UART Module.																																						*
+*	@UARTStartPolled()																																															*
+*	@brief				-	This function starts the buffered mode of an UART module without its interrupt. UARTPoll()			*
+*									serves all UARTs started this way in one pass, so one periodic interrupt (or the main loop)			*
+*									replaces the handlers of up to 8 UARTs.																													*
+* @UARTx				-	Name of the UART Module. It must have been initialized with UARTInit().													*
+* @return				-	Nothing.																																												*
 *																																																									*
-* @Note		- Returns PA1(Tx Pin of UART0) if incorrect name is given to the function.															*
+*	@Note					-	UARTWrite(), UARTRead(), UARTRxCount() and UARTTxSpace() are used as in UARTStartBuffered().		*
+*									The Rx/Rx time-out/Tx interrupts of the UART are unmasked, but its NVIC line stays disabled,		*
+*									so they only make the line pending. UARTPoll() reads the pending bits to find UARTs with work.	*
 ******************************************************************************************************************/
-uint8_t UARTGetTxPin(uint8_t UARTx)
+void UARTStartPolled(uint8_t UARTx)
 {
-	switch(UARTx)
-	{
-		case UART0:				return PA1;
-		case UART1:				return PB1;
-		case UART2:				return PD7;
-		case UART3:				return PC7;
-		case UART4:				return PC5;
-		case UART5:				return PE5;
-		case UART6:				return PD5;
-		case UART7:				return PE1;
-		
-		default:					return PA1;
-	}
+	uint8_t index = (UARTx - UART0);
+	
+	NVIC->DIS[ UARTIRQNumber[index]/32 ] = 1 << (UARTIRQNumber[index]%32);
+	UARTStartRings(index);
+	UARTPolled SET_BIT(index);
 }
 
+
+
 /******************************************************************************************************************
-* @UARTGetRxPin()																																																	*
-* @UARTx	-	Name of the UART Module whose Rx Pin is required.																											*
-* @return	- Rx Pin of the UART Module.																																						*
+*	@UARTWrite()																																																		*
+*	@brief				-	This function queues data for transmission in buffered mode. It never waits.										*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@TxBuf				-	Data to be sent.																																								*
+*	@Len					-	No of bytes to be sent.																																					*
+* @return				-	No of bytes queued. It is less than Len if the Tx ring doesn't have space for all of them.			*
 *																																																									*
-* @Note		- Returns PA0(Rx Pin of UART0) if incorrect name is given to the function.															*
+*	@Note					-	The Tx interrupt is masked while this function fills the Tx FIFO, so the application and UARTIT_H() *
+*									never take bytes out of the Tx ring at the same time.																						*
 ******************************************************************************************************************/
-uint8_t UARTGetRxPin(uint8_t UARTx)
+uint32_t UARTWrite(uint8_t UARTx, const uint8_t *TxBuf, uint32_t Len)
 {
-	switch(UARTx)
-	{
-		case UART0:				return PA0;
-		case UART1:				return PB0;
-		case UART2:				return PD6;
-		case UART3:				return PC6;
-		case UART4:				return PC4;
-		case UART5:				return PE4;
-		case UART6:				return PD4;
-		case UART7:				return PE0;
-		
-		default:					return PA0;
-	}
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	UARTRing* pRing = &UARTRings[UARTx - UART0];
+	uint32_t Head = pRing->TxHead;
+	uint32_t Space = UART_TX_BUFFER_SIZE - (Head - pRing->TxTail);
+	uint32_t Count;
+	
+	if(Len > Space)		Len = Space;
+	for(Count = 0; Count < Len; Count++)
+		pRing->TxBuf[ (Head + Count) & (UART_TX_BUFFER_SIZE-1) ] = TxBuf[Count];
+	pRing->TxHead = Head + Len;
+	
+	pUART->IM CLR_BIT( UART_IM_TX );
+	UARTFillTxFIFO(pUART, pRing);
+	if(pRing->TxTail != pRing->TxHead)
+		pUART->IM SET_BIT( UART_IM_TX );			//	Tx FIFO is full, it will interrupt when it drains below the trigger level.
+	
+	return Len;
 }
 
 
 
 /******************************************************************************************************************
-* @WaitWhileUARTisBusy()																																													*
-* @pUARTx			-	UART Module Access pointer.																																				*
-* @return			-	Nothing(void).																																										*
+*	@UARTRead()																																																			*
+*	@brief				-	This function takes received data out of the Rx ring in buffered mode. It never waits.					*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@RxBuf				-	Buffer for the received data.																																		*
+*	@MaxLen				-	Size of the buffer (in bytes).																																	*
+* @return				-	No of bytes read.																																								*
 ******************************************************************************************************************/
-void WaitWhileUARTisBusy(UART_Reg* pUARTx)
+uint32_t UARTRead(uint8_t UARTx, uint8_t *RxBuf, uint32_t MaxLen)
 {
-	while( GET_BIT(pUARTx->FR, UART_FR_BUSY) );
+	UARTRing* pRing = &UARTRings[UARTx - UART0];
+	uint32_t Tail = pRing->RxTail;
+	uint32_t Count = pRing->RxHead - Tail;
+	uint32_t i;
+	
+	if(Count > MaxLen)		Count = MaxLen;
+	for(i = 0; i < Count; i++)
+		RxBuf[i] = pRing->RxBuf[ (Tail + i) & (UART_RX_BUFFER_SIZE-1) ];
+	pRing->RxTail = Tail + Count;
+	
+	return Count;
 }
 
 
 
 /******************************************************************************************************************
-* @UARTSendIT_H()																																																	*
-*	@brief			-	Takes data from buffer and sends it over an UART module whenever a TX interrupt occurs.						*
-* @UARTx			-	Name of the UART Module.																																					*
-* @return			-	Nothing(void).																																										*
-*																																																									*
-*	@Note				-	Buffer address and length are stored in UARTTransferBuffer & UARTTransferLength[] variables.			*
+*	@UARTRxCount() / @UARTTxSpace()																																									*
+*	@brief				-	No of received bytes waiting in the Rx ring / No of bytes which UARTWrite() can queue right now. *
+* @UARTx				-	Name of the UART Module.																																				*
 ******************************************************************************************************************/
-void UARTSendIT_H(uint8_t UARTx)
+uint32_t UARTRxCount(uint8_t UARTx)
 {
-	uint8_t index = (UARTx - 0xE);
-	UART_Reg* pUART = UARTGetAddress(UARTx);
-	
-	if( UARTTransferLength[index] <= 0 )
-	{
-		pUART->IM CLR_BIT( UART_IM_TX );					//	Tx Interrupt mask in UART registers.
-		return;	// disable interrupt here.
-	}
-	else
-	{
-		uint8_t *buffer = UARTTransferBuffer[index];
+	UARTRing* pRing = &UARTRings[UARTx - UART0];
+	return pRing->RxHead - pRing->RxTail;
+}
 
-		while(UARTTransferLength[index] > 0)
-		{
-			WaitWhileUARTisBusy(pUART);
-		
-			pUART->DR = (*buffer);						//	Pick data from transmit buffer and put it into data register.
-			buffer++;													//	Step the pointer, so that it points to the next data element.
-			UARTTransferLength[index]--;
-		}
-	}
+uint32_t UARTTxSpace(uint8_t UARTx)
+{
+	UARTRing* pRing = &UARTRings[UARTx - UART0];
+	return UART_TX_BUFFER_SIZE - (pRing->TxHead - pRing->TxTail);
 }
 
+
+
 /******************************************************************************************************************
-* @UARTRecvIT_H()																																																	*
-*	@brief			-	Takes data from UART module and puts it in receive buffer, whenever data is available.						*
-*								This function needs to be called from interrupt handler.																					*
-* @UARTx			-	Name of the UART Module.																																					*
-* @return			-	Nothing(void).																																										*
+*	@UARTPoll()																																																			*
+*	@brief				-	This function serves, in one pass, all UARTs in the polled buffered mode (UARTStartPolled())		*
+*									which have work: it empties their Rx FIFOs into the Rx rings and fills their Tx FIFOs from			*
+*									the Tx rings.																																										*
+* @return				-	UARTs which have been served (bit n => UARTn), 0 if none had work.															*
 *																																																									*
-*	@Note				-	Buffer address and length are stored in UARTTransferBuffer & UARTTransferLength[] variables.			*
+*	@Note					-	The work is found with two reads of the NVIC pending registers, which hold the interrupt				*
+*									requests of all UARTs, so an idle UART costs no register access. Each UART with work is					*
+*									served by UARTIT_H().																																						*
+*	@Note2				-	Call it from the main loop or from a periodic interrupt, at least once per (16 - Rx trigger			*
+*									level) byte times of the fastest UART (8 bytes at the default level, 694us at 115200 bauds),		*
+*									or its Rx FIFO overruns.																																				*
 ******************************************************************************************************************/
-void UARTRecvIT_H(uint8_t UARTx)
+uint8_t UARTPoll(void)
 {
-	uint8_t index = (UARTx - 0xE);
-	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint32_t Pend0 = NVIC->PEND[0];
+	uint32_t Pend1 = NVIC->PEND[1];
+	uint8_t Work;
+	uint8_t Served;
 	
+	// IRQ 5, 6 => UART0, UART1;  IRQ 33 => UART2;  IRQ 59 - 63 => UART3 - UART7.
+	Work = UARTPolled & ( ((Pend0 >> 5) & 0x03) | ((Pend1 << 1) & 0x04) | ((Pend1 >> 24) & 0xF8) );
+	if(Work == 0)
+		return 0;
 	
-	if( UARTTransferLength[index] <= 0 )
+	Served = Work;
+	while(Work)
 	{
-		//pUART->IM CLR_BIT( UART_IM_RX );					//	Tx Interrupt mask in UART registers.
-		UARTTransferPending CLR_BIT(index);
-		return;	// disable interrupt here.
+		UARTIT_H( UART0 + CTZ(Work) );
+		Work &= Work - 1;
+	}
+	
+	// Lines are un-pended after the UARTs have been served, which clears the requests that were handled. An UART which
+	// still has work (e.g. a byte came during the service) keeps its request asserted, and pends its line again.
+	if(Served & 0x03)
+		NVIC->UNPEND[0] = (uint32_t)(Served & 0x03) << 5;
+	if(Served & 0xFC)
+		NVIC->UNPEND[1] = ((uint32_t)(Served & 0x04) >> 1) | ((uint32_t)(Served & 0xF8) << 24);
+	
+	return Served;
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTSendDMA()																																																	*
+*	@brief				-	This function starts sending a buffer with the uDMA controller and returns. The CPU is not used per	*
+*									byte: the Tx channel of the UART refills the Tx FIFO on its own, up to DMA_MAX_TRANSFER bytes per	*
+*									control structure, and UARTDMA_H() starts the next part.																				*
+* @UARTx				-	Name of the UART Module. It must have been initialized with UARTInit()/UARTInitBaud().					*
+*	@TxBuf				-	Data to send. It must not be changed until UARTDMATxPending() returns 0.												*
+*	@Len					-	No of bytes.																																										*
+* @return				-	0 if the transfer has started, 1 if a DMA transfer is already going on.													*
+*																																																									*
+*	@Note					-	The uDMA controller is initialized (DMAInit()) on the first use. The completion interrupt of the	*
+*									channel comes on the interrupt of the UART, whose handler must call UARTDMA_H().								*
+******************************************************************************************************************/
+uint8_t UARTSendDMA(uint8_t UARTx, const uint8_t *TxBuf, uint32_t Len)
+{
+	uint8_t index = (UARTx - UART0);
+	UARTDMATransfer* pXfer = &UARTDMATransfers[index];
+	
+	if(pXfer->TxBusy)
+		return 1;
+	if(Len == 0)
+		return 0;
+	
+	pXfer->TxBusy = 1;
+	pXfer->TxBuf = TxBuf;
+	pXfer->TxLeft = Len;
+	
+	UARTDMASetup(index, UARTDMATxChannel[index], 0);
+	UARTDMANextTx(index);
+	
+	UARTGetAddress(UARTx)->DMACTL SET_BIT(UART_DMACTL_TXDMAE);
+	UARTEnableIRQ(index);
+	
+	return 0;
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTRecvDMA()																																																	*
+*	@brief				-	This function starts receiving into a buffer with the uDMA controller and returns. The Rx channel	*
+*									of the UART empties the Rx FIFO on its own.																											*
+* @UARTx				-	Name of the UART Module. It must have been initialized with UARTInit()/UARTInitBaud().					*
+*	@RxBuf				-	Buffer for the received data.																																		*
+*	@Len					-	No of bytes to receive.																																					*
+* @return				-	0 if the transfer has started, 1 if a DMA transfer is already going on.													*
+*																																																									*
+*	@Note					-	The Rx and Rx time-out interrupts are masked, the FIFO is emptied by the controller. The handler of	*
+*									the UART must call UARTDMA_H(). The buffer is complete when UARTDMARxPending() returns 0.				*
+******************************************************************************************************************/
+uint8_t UARTRecvDMA(uint8_t UARTx, uint8_t *RxBuf, uint32_t Len)
+{
+	uint8_t index = (UARTx - UART0);
+	UARTDMATransfer* pXfer = &UARTDMATransfers[index];
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	
+	if(pXfer->RxBusy || UARTStreams[index].Active)
+		return 1;
+	if(Len == 0)
+		return 0;
+	
+	pXfer->RxBusy = 1;
+	pXfer->RxBuf = RxBuf;
+	pXfer->RxLeft = Len;
+	
+	UARTDMASetup(index, UARTDMARxChannel[index], 0);
+	UARTDMANextRx(index);
+	
+	pUART->IM &= ~( (1<<UART_IM_RX) | (1<<UART_IM_RT) );
+	pUART->DMACTL SET_BIT(UART_DMACTL_RXDMAE);
+	UARTEnableIRQ(index);
+	
+	return 0;
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTDMATxPending() / @UARTDMARxPending()																																				*
+*	@brief				-	No of bytes of the current DMA transfer which have not been written to the Tx FIFO / read from the	*
+*									Rx FIFO yet. 0 => the transfer is complete.																											*
+* @UARTx				-	Name of the UART Module.																																				*
+******************************************************************************************************************/
+uint32_t UARTDMATxPending(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - UART0);
+	
+	if( !UARTDMATransfers[index].TxBusy )
+		return 0;
+	return UARTDMATransfers[index].TxLeft + DMAGetRemaining(UARTDMATxChannel[index], DMA_PRIMARY);
+}
+
+uint32_t UARTDMARxPending(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - UART0);
+	
+	if( !UARTDMATransfers[index].RxBusy )
+		return 0;
+	return UARTDMATransfers[index].RxLeft + DMAGetRemaining(UARTDMARxChannel[index], DMA_PRIMARY);
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTStartStream()																																															*
+*	@brief				-	This function starts continuous reception into two buffers (halves) which the Rx channel of the UART	*
+*									fills in turn (ping-pong mode). The application takes whole blocks with UARTGetBlock() and gives	*
+*									them back with UARTReleaseBlock(), while the controller goes on with the other half.						*
+* @UARTx				-	Name of the UART Module. It must have been initialized with FIFOs enabled.											*
+*	@Buf0/@Buf1		-	The two halves.																																									*
+*	@Size					-	Size of each half in bytes (1 - DMA_MAX_TRANSFER).																							*
+* @return				-	0 if reception has started, 1 if a DMA receive is already going on or the size is invalid.			*
+*																																																									*
+*	@Note					->	When the line goes idle (Rx time-out), UARTDMA_H() hands over the half which is being filled as a	*
+*										partial block, so the end of a message does not wait for the half to fill up.									*
+*								->	The channel uses burst requests of half the Rx trigger level, so a few bytes always stay in the	*
+*										Rx FIFO until the next burst. This is what lets the Rx time-out detect an idle line.					*
+*								->	If the application holds both halves, the controller stops and the Rx FIFO fills up (see			*
+*										UARTStreamStalls()). A half must be larger than the data which arrives while one block is being	*
+*										processed.																																										*
+******************************************************************************************************************/
+uint8_t UARTStartStream(uint8_t UARTx, uint8_t *Buf0, uint8_t *Buf1, uint32_t Size)
+{
+	uint8_t index = (UARTx - UART0);
+	UARTStream* pStream = &UARTStreams[index];
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint8_t Channel = UARTDMARxChannel[index];
+	
+	if(UARTDMATransfers[index].RxBusy || pStream->Active)
+		return 1;
+	if(Size == 0 || Size > DMA_MAX_TRANSFER)
+		return 1;
+	
+	pStream->Buf[0] = Buf0;
+	pStream->Buf[1] = Buf1;
+	pStream->Size = Size;
+	pStream->Ready[0] = 0;
+	pStream->Ready[1] = 0;
+	pStream->Fill = 0;
+	pStream->Next = 0;
+	pStream->Stalls = 0;
+	pStream->Active = 1;
+	
+	UARTDMASetup(index, Channel, 1);
+	UARTStreamArm(index, DMA_PRIMARY);
+	UARTStreamArm(index, DMA_ALTERNATE);
+	DMAEnableChannel(Channel);
+	
+	pUART->ICR = (1<<UART_ICR_RX) | (1<<UART_ICR_RT);
+	pUART->IM = ( pUART->IM & ~(1<<UART_IM_RX) ) | (1<<UART_IM_RT);
+	pUART->DMACTL SET_BIT(UART_DMACTL_RXDMAE);
+	UARTEnableIRQ(index);
+	
+	return 0;
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTGetBlock()																																																	*
+*	@brief				-	Oldest block of a continuous receive which has not been released yet.														*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@pBlock				-	Returns the start of the block.																																	*
+* @return				-	No of bytes in the block (the half size, or less if the line went idle). 0 if no block is ready.	*
+******************************************************************************************************************/
+uint32_t UARTGetBlock(uint8_t UARTx, uint8_t **pBlock)
+{
+	UARTStream* pStream = &UARTStreams[UARTx - UART0];
+	uint8_t Half = pStream->Next;
+	
+	if( !pStream->Active || pStream->Ready[Half] == 0 )
+		return 0;
+	
+	*pBlock = pStream->Buf[Half];
+	return pStream->Ready[Half];
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTReleaseBlock()																																															*
+*	@brief				-	Give the block returned by UARTGetBlock() back to the controller. If reception had stopped because	*
+*									both halves were held, it starts again.																													*
+* @UARTx				-	Name of the UART Module.																																				*
+******************************************************************************************************************/
+void UARTReleaseBlock(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - UART0);
+	UARTStream* pStream = &UARTStreams[index];
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint8_t Channel = UARTDMARxChannel[index];
+	uint8_t Half = pStream->Next;
+	
+	if( !pStream->Active || pStream->Ready[Half] == 0 )
+		return;
+	
+	UARTStreamArm(index, Half);													//	Arm before clearing Ready[], see UARTStream.
+	pStream->Ready[Half] = 0;
+	pStream->Next = Half ^ 1;
+	
+	if( !DMAIsChannelEnabled(Channel) )
+	{
+		if(pStream->Fill == DMA_ALTERNATE)		pDMA->ALTSET = 1UL<<Channel;
+		else																	pDMA->ALTCLR = 1UL<<Channel;
+		DMAEnableChannel(Channel);
+		pUART->IM SET_BIT( UART_IM_RT );
+	}
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTStopStream()																																																*
+*	@brief				-	This function ends a continuous receive. Blocks which have not been taken are dropped.					*
+* @UARTx				-	Name of the UART Module.																																				*
+******************************************************************************************************************/
+void UARTStopStream(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - UART0);
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	
+	if( !UARTStreams[index].Active )
+		return;
+	
+	DMADisableChannel(UARTDMARxChannel[index]);
+	pUART->IM CLR_BIT( UART_IM_RT );
+	pUART->DMACTL CLR_BIT(UART_DMACTL_RXDMAE);
+	UARTStreams[index].Active = 0;
+}
+
+
+
+/******************************************************************************************************************
+*	@UARTStreamStalls()																																															*
+* @UARTx				-	Name of the UART Module.																																				*
+* @return				-	No of times reception stopped because the application was holding both halves.									*
+******************************************************************************************************************/
+uint32_t UARTStreamStalls(uint8_t UARTx)
+{
+	return UARTStreams[UARTx - UART0].Stalls;
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTStartFramed()																																															*
+*	@brief				-	This function starts the framed transport of an UART module. Frames are sent with UARTSendFrame(),	*
+*									which encodes them while filling the Tx FIFO, and received frames are decoded straight from the	*
+*									Rx FIFO into slots of Buf, where the application reads them (see UARTGetFrame()).								*
+* @UARTx				-	Name of the UART Module. It must have been initialized with UARTInit().													*
+*	@Framing			-	FramingCOBS or FramingSLIP (see @Framing).																											*
+*	@Buf					-	Receive buffer. It is split into UART_FRAME_SLOTS slots, each of which holds one decoded frame.	*
+*	@Size					-	Size of Buf (in bytes). Size/UART_FRAME_SLOTS is the largest frame which can be received.				*
+* @return				-	0 if started, 1 if the arguments are wrong.																											*
+*																																																									*
+*	@Note					->	The handler of the UART must call UARTFrame_H().																							*
+*								->	COBS frames end with a 0x00 byte. SLIP frames (RFC 1055) start and end with UART_SLIP_END.		*
+*										Malformed frames, frames with line errors, frames longer than a slot and frames which arrive	*
+*										while all slots are held by the application are dropped and counted (see UARTGetStats()).			*
+*								->	Don't use the buffered, IT or DMA APIs on the same UART while framing is running.							*
+******************************************************************************************************************/
+uint8_t UARTStartFramed(uint8_t UARTx, uint8_t Framing, uint8_t *Buf, uint32_t Size)
+{
+	uint8_t index = (UARTx - UART0);
+	UARTFramer* pFramer = &UARTFramers[index];
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint8_t i;
+	
+	if( (Framing != FramingCOBS && Framing != FramingSLIP) || Size < UART_FRAME_SLOTS )
+		return 1;
+	
+	pUART->IM &= ~( (1<<UART_IM_TX) | (1<<UART_IM_RX) | (1<<UART_IM_RT) );
+	
+	pFramer->Buf = Buf;
+	pFramer->SlotSize = Size / UART_FRAME_SLOTS;
+	for(i = 0; i < UART_FRAME_SLOTS; i++)
+		pFramer->Ready[i] = 0;
+	pFramer->Fill = 0;
+	pFramer->Next = 0;
+	pFramer->Framing = Framing;
+	pFramer->InFrame = 0;
+	pFramer->Discard = 0;
+	pFramer->Escape = 0;
+	pFramer->Code = 0;
+	pFramer->Left = 0;
+	pFramer->Len = 0;
+	pFramer->TxBusy = 0;
+	pFramer->Active = 1;
+	
+	pUART->ICR = (1<<UART_ICR_TX) | (1<<UART_ICR_RX) | (1<<UART_ICR_RT);
+	pUART->IM |= (1<<UART_IM_RX) | (1<<UART_IM_RT);
+	UARTEnableIRQ(index);
+	
+	return 0;
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTSendFrame()																																																*
+*	@brief				-	This function starts sending a frame in framed mode. It returns right away; the frame is encoded	*
+*									byte by byte as the Tx FIFO is filled, so no encoded copy is made.															*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@Data					-	Frame to be sent. It must not be changed until UARTFrameTxBusy() returns 0.											*
+*	@Len					-	No of bytes in the frame.																																				*
+* @return				-	0 if the frame is being sent, 1 if the previous frame is still being sent (or Len is 0).				*
+******************************************************************************************************************/
+uint8_t UARTSendFrame(uint8_t UARTx, const uint8_t *Data, uint32_t Len)
+{
+	uint8_t index = (UARTx - UART0);
+	UARTFramer* pFramer = &UARTFramers[index];
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	
+	if( !pFramer->Active || pFramer->TxBusy || Len == 0 )
+		return 1;
+	
+	pUART->IM CLR_BIT( UART_IM_TX );
+	pFramer->TxBuf = Data;
+	pFramer->TxLen = Len;
+	pFramer->TxPos = 0;
+	pFramer->TxCode = 0;
+	pFramer->TxLeft = 0;
+	pFramer->TxPending = (pFramer->Framing == FramingSLIP) ? UART_SLIP_END : 0;		//	Flushes noise before the frame.
+	pFramer->TxDone = 0;
+	pFramer->TxBusy = 1;
+	
+	UARTFrameFillTxFIFO(pUART, pFramer);
+	if(pFramer->TxBusy)
+		pUART->IM SET_BIT( UART_IM_TX );			//	Rest of the frame is sent from UARTFrame_H().
+	
+	return 0;
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTFrameTxBusy()																																															*
+* @UARTx				-	Name of the UART Module.																																				*
+* @return				-	1 while the frame given to UARTSendFrame() hasn't been fully put into the Tx FIFO, 0 otherwise.	*
+******************************************************************************************************************/
+uint8_t UARTFrameTxBusy(uint8_t UARTx)
+{
+	return UARTFramers[UARTx - UART0].TxBusy;
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTGetFrame()																																																	*
+*	@brief				-	Oldest received frame which has not been released yet. The frame is read where it was decoded.	*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@pFrame				-	Returns the start of the frame.																																	*
+* @return				-	No of bytes in the frame. 0 if no frame is ready.																								*
+******************************************************************************************************************/
+uint32_t UARTGetFrame(uint8_t UARTx, uint8_t **pFrame)
+{
+	UARTFramer* pFramer = &UARTFramers[UARTx - UART0];
+	uint8_t Slot = pFramer->Next;
+	
+	if( !pFramer->Active || pFramer->Ready[Slot] == 0 )
+		return 0;
+	
+	*pFrame = pFramer->Buf + Slot*pFramer->SlotSize;
+	return pFramer->Ready[Slot];
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTReleaseFrame()																																															*
+*	@brief				-	Give the slot of the frame returned by UARTGetFrame() back to the decoder.											*
+* @UARTx				-	Name of the UART Module.																																				*
+******************************************************************************************************************/
+void UARTReleaseFrame(uint8_t UARTx)
+{
+	UARTFramer* pFramer = &UARTFramers[UARTx - UART0];
+	uint8_t Slot = pFramer->Next;
+	
+	if( !pFramer->Active || pFramer->Ready[Slot] == 0 )
+		return;
+	
+	pFramer->Next = (Slot + 1) % UART_FRAME_SLOTS;
+	pFramer->Ready[Slot] = 0;
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTStopFramed()																																																*
+*	@brief				-	This function ends the framed transport. A frame being sent is cut short, and frames which have	*
+*									not been taken are dropped.																																			*
+* @UARTx				-	Name of the UART Module.																																				*
+******************************************************************************************************************/
+void UARTStopFramed(uint8_t UARTx)
+{
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	UARTFramer* pFramer = &UARTFramers[UARTx - UART0];
+	
+	pUART->IM &= ~( (1<<UART_IM_TX) | (1<<UART_IM_RX) | (1<<UART_IM_RT) );
+	pFramer->TxBusy = 0;
+	pFramer->Active = 0;
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTGetStats()																																																	*
+*	@brief				-	This function copies the line-error and load counters of an UART module.												*
+* @UARTx				-	Name of the UART Module.																																				*
+*	@pStats				-	Receives the counters (see @UARTStats).																													*
+* @return				-	Nothing.																																												*
+*																																																									*
+*	@Note					->	The counters run all the time. They cost a test of the error bits for every received byte, and	*
+*										a few instructions for every call of a handler helper.																				*
+*								->	The counters are copied one by one, so a handler may update one of them meanwhile.						*
+*								->	In the DMA modes the controller takes the bytes without their error bits, so errors are counted	*
+*										from RIS once per UARTDMA_H() call. Several errors of one kind in a transfer count as one.		*
+******************************************************************************************************************/
+void UARTGetStats(uint8_t UARTx, UARTStats* pStats)
+{
+	*pStats = UARTCounters[UARTx - UART0];
+}
+
+
+
+/*****************************************************************************************************************
+*	@UARTClearStats()																																																*
+*	@brief				-	This function resets the counters of an UART module, e.g. before trying new FIFO levels.				*
+* @UARTx				-	Name of the UART Module.																																				*
+* @return				-	Nothing.																																												*
+******************************************************************************************************************/
+void UARTClearStats(uint8_t UARTx)
+{
+	UARTStats* pStats = &UARTCounters[UARTx - UART0];
+	
+	pStats->FramingErrors = 0;
+	pStats->ParityErrors = 0;
+	pStats->BreakErrors = 0;
+	pStats->Overruns = 0;
+	pStats->RxDropped = 0;
+	pStats->FramesDropped = 0;
+	pStats->RxFIFOHighWater = 0;
+	pStats->RxRingHighWater = 0;
+	pStats->ISRCalls = 0;
+}
+
+
+
+/*---------------------------------------------- HELPER FUNCTIONS -----------------------------------------------*/
+
+
+
+/******************************************************************************************************************
+* @UARTEnableIRQ()																																																*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+* @return	- Nothing(void).																																												*
+******************************************************************************************************************/
+static void UARTEnableIRQ(uint8_t index)
+{
+	NVIC->EN[ UARTIRQNumber[index]/32 ] = 1 << (UARTIRQNumber[index]%32);				//	Writing 0 to EN has no effect.
+}
+
+
+
+/******************************************************************************************************************
+* @UARTDMASetup()																																																	*
+* @brief	-	Initializes the uDMA controller if needed, and assigns a channel to the UART with single and burst requests.	*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+* @Channel	-	Rx or Tx channel of the UART.																																				*
+* @UseBurst	-	1 => the channel responds to burst requests only (see DMAChannelConfig()).													*
+******************************************************************************************************************/
+static void UARTDMASetup(uint8_t index, uint8_t Channel, uint8_t UseBurst)
+{
+	if( !GET_BIT(SYSCTL->RCGCDMA, 0) )
+		DMAInit();
+	
+	DMADisableChannel(Channel);
+	DMAClearIntStatus(1UL<<Channel);
+	DMAAssignChannel(Channel, UARTDMAEncoding[index]);
+	DMAChannelConfig(Channel, UseBurst, 0);
+}
+
+
+
+/******************************************************************************************************************
+* @UARTDMANextTx() / @UARTDMANextRx()																																							*
+* @brief	-	Give the next part (up to DMA_MAX_TRANSFER bytes) of a DMA transfer to the primary control structure of	*
+*						the channel and arm it. The arbitration size follows the FIFO level of the UART (UARTIFLS).						*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+******************************************************************************************************************/
+static void UARTDMANextTx(uint8_t index)
+{
+	UARTDMATransfer* pXfer = &UARTDMATransfers[index];
+	UART_Reg* pUART = UARTGetAddress(UART0 + index);
+	uint32_t Count = (pXfer->TxLeft > DMA_MAX_TRANSFER) ? DMA_MAX_TRANSFER : pXfer->TxLeft;
+	uint8_t Level = (pUART->IFLS >> UART_IFLS_TX) & 7;
+	
+	DMASetTransfer( UARTDMATxChannel[index], DMA_PRIMARY,
+									DMAControlWord(DMA_Mode_Basic, DMA_Size_8bit, DMA_Inc_8bit, DMA_Inc_None,
+																 UARTDMATxArbSize[ Level > FIFOLevel_7_8 ? FIFOLevel_1_2 : Level ], Count),
+									pXfer->TxBuf, &pUART->DR );
+	pXfer->TxBuf += Count;
+	pXfer->TxLeft -= Count;
+	
+	DMAEnableChannel(UARTDMATxChannel[index]);
+}
+
+static void UARTDMANextRx(uint8_t index)
+{
+	UARTDMATransfer* pXfer = &UARTDMATransfers[index];
+	UART_Reg* pUART = UARTGetAddress(UART0 + index);
+	uint32_t Count = (pXfer->RxLeft > DMA_MAX_TRANSFER) ? DMA_MAX_TRANSFER : pXfer->RxLeft;
+	uint8_t Level = (pUART->IFLS >> UART_IFLS_RX) & 7;
+	
+	DMASetTransfer( UARTDMARxChannel[index], DMA_PRIMARY,
+									DMAControlWord(DMA_Mode_Basic, DMA_Size_8bit, DMA_Inc_None, DMA_Inc_8bit,
+																 UARTDMARxArbSize[ Level > FIFOLevel_7_8 ? FIFOLevel_1_2 : Level ], Count),
+									&pUART->DR, pXfer->RxBuf );
+	pXfer->RxBuf += Count;
+	pXfer->RxLeft -= Count;
+	
+	DMAEnableChannel(UARTDMARxChannel[index]);
+}
+
+
+
+/******************************************************************************************************************
+* @UARTStreamArm()																																																*
+* @brief	-	Give one half of a continuous receive to the controller (ping-pong mode, burst requests).							*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+* @Half		-	DMA_PRIMARY (Buf0) or DMA_ALTERNATE (Buf1).																														*
+******************************************************************************************************************/
+static void UARTStreamArm(uint8_t index, uint8_t Half)
+{
+	UARTStream* pStream = &UARTStreams[index];
+	UART_Reg* pUART = UARTGetAddress(UART0 + index);
+	uint8_t Level = (pUART->IFLS >> UART_IFLS_RX) & 7;
+	
+	DMASetTransfer( UARTDMARxChannel[index], Half,
+									DMAControlWord(DMA_Mode_PingPong, DMA_Size_8bit, DMA_Inc_None, DMA_Inc_8bit,
+																 UARTStreamArbSize[ Level > FIFOLevel_7_8 ? FIFOLevel_1_2 : Level ], pStream->Size),
+									&pUART->DR, pStream->Buf[Half] );
+}
+
+
+
+/******************************************************************************************************************
+* @UARTStreamCollect()																																														*
+* @brief	-	Hand every half which the controller has completed to the application, in order. Counts a stall when	*
+*						the controller has moved on to a half which the application still holds.															*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+******************************************************************************************************************/
+static void UARTStreamCollect(uint8_t index)
+{
+	UARTStream* pStream = &UARTStreams[index];
+	uint8_t Channel = UARTDMARxChannel[index];
+	uint8_t i;
+	
+	for(i = 0; i < 2; i++)
+	{
+		uint8_t Half = pStream->Fill;
+		
+		if( DMAGetMode(Channel, Half) != DMA_Mode_Stop || pStream->Ready[Half] != 0 )
+			break;
+		
+		pStream->Ready[Half] = pStream->Size;
+		pStream->Fill = Half ^ 1;
+		
+		if( pStream->Ready[Half ^ 1] != 0 )
+		{
+			pStream->Stalls++;
+			UARTGetAddress(UART0 + index)->IM CLR_BIT( UART_IM_RT );			//	UARTReleaseBlock() starts again.
+			break;
+		}
+	}
+}
+
+
+
+/******************************************************************************************************************
+* @UARTStreamFlush()																																															*
+* @brief	-	Called on the Rx time-out. Stops the channel, moves the bytes left in the Rx FIFO behind the data of	*
+*						the half being filled, hands that half over as a partial block, and resumes on the other half.				*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+******************************************************************************************************************/
+static void UARTStreamFlush(uint8_t index)
+{
+	UARTStream* pStream = &UARTStreams[index];
+	UART_Reg* pUART = UARTGetAddress(UART0 + index);
+	uint8_t Channel = UARTDMARxChannel[index];
+	uint8_t Half;
+	uint32_t Filled;
+	
+	DMADisableChannel(Channel);
+	UARTStreamCollect(index);												//	A half may have completed meanwhile.
+	
+	Half = pStream->Fill;
+	if( DMAGetMode(Channel, Half) == DMA_Mode_Stop )
+		return;																				//	Stalled, the data waits in the Rx FIFO.
+	
+	Filled = pStream->Size - DMAGetRemaining(Channel, Half);
+	while( Filled < pStream->Size && !GET_BIT(pUART->FR, UART_FR_RXFE) )
+		pStream->Buf[Half][Filled++] = (uint8_t)( pUART->DR );
+	
+	if(Filled)
+	{
+		DMAGetEntry(Channel, Half)->Control = DMA_Mode_Stop;
+		pStream->Ready[Half] = Filled;
+		pStream->Fill = Half ^ 1;
+		Half ^= 1;
+	}
+	
+	if( DMAGetMode(Channel, Half) == DMA_Mode_Stop )
+	{
+		pStream->Stalls++;
+		pUART->IM CLR_BIT( UART_IM_RT );
+		return;
+	}
+	
+	if(Half == DMA_ALTERNATE)		pDMA->ALTSET = 1UL<<Channel;
+	else												pDMA->ALTCLR = 1UL<<Channel;
+	DMAEnableChannel(Channel);
+}
+
+
+
+/******************************************************************************************************************
+* @UARTCountErrors()																																															*
+* @brief	-	Counts the error bits of a received byte. Called only when one of them is set.												*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+* @Data		-	Value read from DR (or the error bits in the same positions).																					*
+******************************************************************************************************************/
+static void UARTCountErrors(uint8_t index, uint32_t Data)
+{
+	UARTStats* pStats = &UARTCounters[index];
+	
+	pStats->FramingErrors += GET_BIT(Data, UART_DR_FE);
+	pStats->ParityErrors += GET_BIT(Data, UART_DR_PE);
+	pStats->BreakErrors += GET_BIT(Data, UART_DR_BE);
+	pStats->Overruns += GET_BIT(Data, UART_DR_OE);
+}
+
+
+
+/******************************************************************************************************************
+* @UARTWaitRxLevel()																																															*
+* @brief	-	Polls the Rx pin (in GPIO mode) until it is at Level. Only the pin is read in the loop, so an edge is seen	*
+*						within a few cycles; the wait is bounded by a count of polls instead of the timer.										*
+* @return	-	1 if the level has come, 0 if the pin stayed for longer than UART_AUTOBAUD_POLLS polls.								*
+******************************************************************************************************************/
+static uint8_t UARTWaitRxLevel(GPIO_reg* pGPIO, uint8_t Mask, uint8_t Level)
+{
+	uint32_t Polls = UART_AUTOBAUD_POLLS;
+	uint8_t Wanted = Level ? Mask : 0;
+	
+	while( pGPIO->GPIO_DATA_A[Mask] != Wanted )
+		if(--Polls == 0)
+			return 0;
+	return 1;
+}
+
+/******************************************************************************************************************
+* @UARTStandardBaud()																																															*
+* @brief	-	Rounds a measured baud rate to the nearest rate of UARTStandardRates[] within UART_AUTOBAUD_TOLERANCE	*
+*						percent. Other rates are returned as they are.																												*
+******************************************************************************************************************/
+static uint32_t UARTStandardBaud(uint32_t Baud)
+{
+	uint8_t i;
+	
+	for(i = 0; i < sizeof(UARTStandardRates)/sizeof(UARTStandardRates[0]); i++)
+	{
+		uint32_t Rate = UARTStandardRates[i];
+		uint32_t Diff = (Baud > Rate) ? Baud - Rate : Rate - Baud;
+		
+		if(Diff*100 <= Rate*UART_AUTOBAUD_TOLERANCE)
+			return Rate;
+	}
+	return Baud;
+}
+
+/******************************************************************************************************************
+* @UARTFramePut()																																																	*
+* @brief	-	Decodes one byte received in framed mode into the slot being filled, and hands the slot to the				*
+*						application when the byte ends a frame.																																*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+* @Data		-	Value read from DR, with the error bits.																															*
+******************************************************************************************************************/
+static void UARTFramePut(uint8_t index, uint32_t Data)
+{
+	UARTFramer* pFramer = &UARTFramers[index];
+	uint8_t Byte = (uint8_t)Data;
+	uint8_t Delimiter = (pFramer->Framing == FramingSLIP) ? UART_SLIP_END : UART_COBS_DELIMITER;
+	uint8_t Put = 1;
+	
+	if( !(Data & UART_DR_ERRORS) && Byte == Delimiter )
+	{
+		if(pFramer->InFrame)
+		{
+			if( !pFramer->Discard && (pFramer->Left || pFramer->Escape) )
+				UARTCounters[index].FramesDropped++;					//	Frame ended in the middle of a COBS block or a SLIP escape.
+			else if( !pFramer->Discard && pFramer->Len )
+			{
+				pFramer->Ready[pFramer->Fill] = pFramer->Len;
+				pFramer->Fill = (pFramer->Fill + 1) % UART_FRAME_SLOTS;
+			}
+			pFramer->InFrame = 0;
+			pFramer->Discard = 0;
+			pFramer->Escape = 0;
+			pFramer->Code = 0;
+			pFramer->Left = 0;
+			pFramer->Len = 0;
+		}
+		return;
+	}
+	
+	if(!pFramer->InFrame)
+	{
+		pFramer->InFrame = 1;
+		if(pFramer->Ready[pFramer->Fill])
+		{
+			pFramer->Discard = 1;												//	All slots are held by the application.
+			UARTCounters[index].FramesDropped++;
+		}
+	}
+	if(pFramer->Discard)
+		return;
+	if(Data & UART_DR_ERRORS)
+	{
+		pFramer->Discard = 1;
+		UARTCounters[index].FramesDropped++;
+		return;
+	}
+	
+	if(pFramer->Framing == FramingSLIP)
+	{
+		if(pFramer->Escape)
+		{
+			pFramer->Escape = 0;
+			if(Byte == UART_SLIP_ESC_END)				Byte = UART_SLIP_END;
+			else if(Byte == UART_SLIP_ESC_ESC)	Byte = UART_SLIP_ESC;
+		}
+		else if(Byte == UART_SLIP_ESC)
+		{
+			pFramer->Escape = 1;
+			return;
+		}
+	}
+	else if(pFramer->Left == 0)
+	{
+		// A code byte starts a block. Every block but the first one, and but the ones after a full (0xFF) block,
+		// stands for a 0x00 byte before it.
+		Put = ( pFramer->Code != 0 && pFramer->Code != 0xFF );
+		pFramer->Code = Byte;
+		pFramer->Left = Byte - 1;
+		Byte = 0x00;
+	}
+	else
+		pFramer->Left--;
+	
+	if(!Put)
+		return;
+	if(pFramer->Len == pFramer->SlotSize)
+	{
+		pFramer->Discard = 1;														//	Frame doesn't fit in a slot.
+		UARTCounters[index].FramesDropped++;
+		return;
+	}
+	pFramer->Buf[ pFramer->Fill*pFramer->SlotSize + pFramer->Len++ ] = Byte;
+}
+
+
+
+/******************************************************************************************************************
+* @UARTFrameNextByte()																																														*
+* @brief	-	Encodes the next byte of the frame being sent.																												*
+* @return	- The byte, or -1 when the whole frame (with its closing delimiter) has been returned.									*
+******************************************************************************************************************/
+static int32_t UARTFrameNextByte(UARTFramer* pFramer)
+{
+	uint8_t Byte;
+	uint32_t n;
+	
+	if(pFramer->Framing == FramingSLIP)
+	{
+		if(pFramer->TxPending)
+		{
+			Byte = pFramer->TxPending;
+			pFramer->TxPending = 0;
+			return Byte;
+		}
+		if(pFramer->TxPos == pFramer->TxLen)
+		{
+			if(pFramer->TxDone)		return -1;
+			pFramer->TxDone = 1;
+			return UART_SLIP_END;
+		}
+		Byte = pFramer->TxBuf[pFramer->TxPos++];
+		if(Byte == UART_SLIP_END)					{	pFramer->TxPending = UART_SLIP_ESC_END;		return UART_SLIP_ESC;	}
+		if(Byte == UART_SLIP_ESC)					{	pFramer->TxPending = UART_SLIP_ESC_ESC;		return UART_SLIP_ESC;	}
+		return Byte;
+	}
+	
+	if(pFramer->TxLeft)
+	{
+		pFramer->TxLeft--;
+		return pFramer->TxBuf[pFramer->TxPos++];
+	}
+	if(pFramer->TxDone)
+		return -1;
+	if(pFramer->TxCode)
+	{
+		// A block has ended. It stands for the 0x00 byte which follows it, unless it is full or the frame has ended.
+		if(pFramer->TxPos == pFramer->TxLen)
+		{
+			pFramer->TxDone = 1;
+			return UART_COBS_DELIMITER;
+		}
+		if(pFramer->TxCode != 0xFF)
+			pFramer->TxPos++;
+	}
+	
+	// Start a block: its code is 1 + the no of non-zero bytes before the next 0x00 (254 at most).
+	for(n = 0; n < 254 && pFramer->TxPos + n < pFramer->TxLen && pFramer->TxBuf[pFramer->TxPos + n] != 0; n++);
+	pFramer->TxCode = n + 1;
+	pFramer->TxLeft = n;
+	return pFramer->TxCode;
+}
+
+
+
+/******************************************************************************************************************
+* @UARTFrameFillTxFIFO()																																													*
+* @brief	-	Encodes bytes of the frame being sent into the Tx FIFO until the FIFO is full or the frame is out.		*
+* @return	- Nothing(void).																																												*
+******************************************************************************************************************/
+static void UARTFrameFillTxFIFO(UART_Reg* pUART, UARTFramer* pFramer)
+{
+	while( !GET_BIT(pUART->FR, UART_FR_TXFF) )
+	{
+		int32_t Byte = UARTFrameNextByte(pFramer);
+		
+		if(Byte < 0)
+		{
+			pFramer->TxBusy = 0;
+			break;
+		}
+		pUART->DR = (uint32_t)Byte;
 	}
-	else
+}
+
+
+
+/******************************************************************************************************************
+* @UARTFillTxFIFO()																																																*
+* @brief	-	Moves bytes from the Tx ring into the Tx FIFO until the FIFO is full or the ring is empty.						*
+* @return	- Nothing(void).																																												*
+******************************************************************************************************************/
+static void UARTFillTxFIFO(UART_Reg* pUART, UARTRing* pRing)
+{
+	uint32_t Tail = pRing->TxTail;
+	uint32_t Head = pRing->TxHead;
+	
+	while( Tail != Head && !GET_BIT(pUART->FR, UART_FR_TXFF) )
+		pUART->DR = pRing->TxBuf[ (Tail++) & (UART_TX_BUFFER_SIZE-1) ];
+	
+	pRing->TxTail = Tail;
+}
+
+
+
+/******************************************************************************************************************
+* @UARTStartRings()																																																*
+* @brief	-	Empties the rings of the UART, clears and unmasks its Rx and Rx time-out interrupts. The Tx interrupt	*
+*						stays masked until UARTWrite() queues data.																														*
+* @index	-	UART number (0 for UART0 ... 7 for UART7).																														*
+******************************************************************************************************************/
+static void UARTStartRings(uint8_t index)
+{
+	UART_Reg* pUART = UARTGetAddress(UART0 + index);
+	UARTRing* pRing = &UARTRings[index];
+	
+	pUART->IM &= ~( (1<<UART_IM_TX) | (1<<UART_IM_RX) | (1<<UART_IM_RT) );
+	pRing->TxHead = pRing->TxTail = 0;
+	pRing->RxHead = pRing->RxTail = 0;
+	
+	pUART->ICR = (1<<UART_ICR_TX) | (1<<UART_ICR_RX) | (1<<UART_ICR_RT);
+	pUART->IM |= (1<<UART_IM_RX) | (1<<UART_IM_RT);
+}
+
+
+
+/******************************************************************************************************************
+* @UARTGetAddress()																																																*
+* @UARTx	-	Name of the UART Module whose address is required.																										*
+* @return	- Access pointer of the requested UART Module.																													*
+*																																																									*
+* @Note		- Returns Null if incorrect name is given to the function.																							*
+******************************************************************************************************************/
+UART_Reg* UARTGetAddress(uint8_t UARTx)
+{
+	switch(UARTx)
+	{
+		case UART0:			return pUART0;
+		case UART1:			return pUART1;
+		case UART2:			return pUART2;
+		case UART3:			return pUART3;
+		case UART4:			return pUART4;
+		case UART5:			return pUART5;
+		case UART6:			return pUART6;
+		case UART7:			return pUART7;
+		
+		default:				return NULL;
+	}
+}
+
+
+
+/******************************************************************************************************************
+* @UARTGetTxPin()																																																	*
+* @UARTx	-	Name of the UART Module whose Tx Pin is required.																											*
+* @return	- Tx Pin of the UART Module.																																						*
+*																																																									*
+* @Note		- Returns PA1(Tx Pin of UART0) if incorrect name is given to the function.															*
+******************************************************************************************************************/
+uint8_t UARTGetTxPin(uint8_t UARTx)
+{
+	switch(UARTx)
 	{
-		uint8_t *buffer = UARTTransferBuffer[index];
+		case UART0:				return PA1;
+		case UART1:				return PB1;
+		case UART2:				return PD7;
+		case UART3:				return PC7;
+		case UART4:				return PC5;
+		case UART5:				return PE5;
+		case UART6:				return PD5;
+		case UART7:				return PE1;
+		
+		default:					return PA1;
+	}
+}
+
+/******************************************************************************************************************
+* @UARTGetRxPin()																																																	*
+* @UARTx	-	Name of the UART Module whose Rx Pin is required.																											*
+* @return	- Rx Pin of the UART Module.																																						*
+*																																																									*
+* @Note		- Returns PA0(Rx Pin of UART0) if incorrect name is given to the function.															*
+******************************************************************************************************************/
+uint8_t UARTGetRxPin(uint8_t UARTx)
+{
+	switch(UARTx)
+	{
+		case UART0:				return PA0;
+		case UART1:				return PB0;
+		case UART2:				return PD6;
+		case UART3:				return PC6;
+		case UART4:				return PC4;
+		case UART5:				return PE4;
+		case UART6:				return PD4;
+		case UART7:				return PE0;
 		
-		( *buffer ) = (uint8_t)( pUART->DR );
+		default:					return PA0;
+	}
+}
+
+/******************************************************************************************************************
+* @UARTGetRTSPin()																																																*
+* @UARTx	-	Name of the UART Module whose RTS Pin is required.																										*
+* @return	- RTS Pin of the UART Module, UART_NO_PIN if the module has no flow control signals.										*
+******************************************************************************************************************/
+uint8_t UARTGetRTSPin(uint8_t UARTx)
+{
+	switch(UARTx)
+	{
+		case UART1:				return PC4;
+		
+		default:					return UART_NO_PIN;
+	}
+}
+
+/******************************************************************************************************************
+* @UARTGetCTSPin()																																																*
+* @UARTx	-	Name of the UART Module whose CTS Pin is required.																										*
+* @return	- CTS Pin of the UART Module, UART_NO_PIN if the module has no flow control signals.										*
+******************************************************************************************************************/
+uint8_t UARTGetCTSPin(uint8_t UARTx)
+{
+	switch(UARTx)
+	{
+		case UART1:				return PC5;
 		
+		default:					return UART_NO_PIN;
+	}
+}
+
+
+
+/******************************************************************************************************************
+* @WaitWhileUARTisBusy()																																													*
+* @pUARTx			-	UART Module Access pointer.																																				*
+* @return			-	Nothing(void).																																										*
+******************************************************************************************************************/
+void WaitWhileUARTisBusy(UART_Reg* pUARTx)
+{
+	while( GET_BIT(pUARTx->FR, UART_FR_BUSY) );
+}
+
+
+
+/*****************************************************************************************************************
+* @WaitWhileTxFIFOisFull()																																												*
+* @pUARTx			-	UART Module Access pointer.																																				*
+* @return			-	Nothing(void).																																										*
+******************************************************************************************************************/
+void WaitWhileTxFIFOisFull(UART_Reg* pUARTx)
+{
+	while( GET_BIT(pUARTx->FR, UART_FR_TXFF) );
+}
+
+
+
+/******************************************************************************************************************
+* @UARTSendIT_H()																																																	*
+*	@brief			-	Takes data from buffer and sends it over an UART module whenever a TX interrupt occurs.						*
+* @UARTx			-	Name of the UART Module.																																					*
+* @return			-	Nothing(void).																																										*
+*																																																									*
+*	@Note				-	Buffer address and length are stored in UARTTransferBuffer & UARTTransferLength[] variables.			*
+******************************************************************************************************************/
+void UARTSendIT_H(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - 0xE);
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint8_t *buffer = UARTTransferBuffer[index];
+	uint32_t Len = UARTTransferLength[index];
+	
+	UARTCounters[index].ISRCalls++;
+	pUART->ICR = (1<<UART_ICR_TX);
+	
+	// Fill the Tx FIFO and return. The next interrupt comes when the FIFO drains below its trigger level.
+	while( Len > 0 && !GET_BIT(pUART->FR, UART_FR_TXFF) )
+	{
+		pUART->DR = (*buffer);							//	Pick data from transmit buffer and put it into data register.
+		buffer++;														//	Step the pointer, so that it points to the next data element.
+		Len--;
+	}
+	UARTTransferBuffer[index] = buffer;
+	UARTTransferLength[index] = Len;
+	
+	if(Len > 0)
+		pUART->IM SET_BIT( UART_IM_TX );
+	else
+	{
+		pUART->IM CLR_BIT( UART_IM_TX );		//	Whole buffer is in the FIFO, the buffer can be reused.
+		UARTTransferPending CLR_BIT(index);
+	}
+}
+
+/******************************************************************************************************************
+* @UARTRecvIT_H()																																																	*
+*	@brief			-	Takes data from UART module and puts it in receive buffer, whenever data is available.						*
+*								This function needs to be called from interrupt handler.																					*
+* @UARTx			-	Name of the UART Module.																																					*
+* @return			-	Nothing(void).																																										*
+*																																																									*
+*	@Note				-	Buffer address and length are stored in UARTTransferBuffer & UARTTransferLength[] variables.			*
+******************************************************************************************************************/
+void UARTRecvIT_H(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - 0xE);
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint8_t *buffer = UARTTransferBuffer[index];
+	uint32_t Len = UARTTransferLength[index];
+	UARTStats* pStats = &UARTCounters[index];
+	uint32_t Count = 0;
+	
+	pStats->ISRCalls++;
+	pUART->ICR = (1<<UART_ICR_RX) | (1<<UART_ICR_RT);
+	
+	// Empty the Rx FIFO and return.
+	while( Len > 0 && !GET_BIT(pUART->FR, UART_FR_RXFE) )
+	{
+		uint32_t Data = pUART->DR;
+		if(Data & UART_DR_ERRORS)
+			UARTCountErrors(index, Data);
+		( *buffer ) = (uint8_t)Data;
 		buffer++;
-		UARTTransferLength[index]--;
+		Len--;
+		Count++;
+	}
+	if(Count > pStats->RxFIFOHighWater)
+		pStats->RxFIFOHighWater = Count;
+	UARTTransferBuffer[index] = buffer;
+	UARTTransferLength[index] = Len;
+	
+	if(Len == 0)
+	{
+		pUART->IM &= ~( (1<<UART_IM_RX) | (1<<UART_IM_RT) );
+		UARTTransferPending CLR_BIT(index);
+	}
+}
+
+
+
+/******************************************************************************************************************
+* @UARTIT_H()																																																			*
+*	@brief			-	Interrupt handler helper for the buffered mode (see UARTStartBuffered()). Call it from the handler of *
+*								the UART. It empties the Rx FIFO into the Rx ring and fills the Tx FIFO from the Tx ring, and			*
+*								returns without waiting for the UART.																															*
+* @UARTx			-	Name of the UART Module.																																					*
+* @return			-	Nothing(void).																																										*
+*																																																									*
+*	@Note				-	UARTMIS is read once, and the pending interrupts are cleared with a single write to UARTICR.			*
+******************************************************************************************************************/
+void UARTIT_H(uint8_t UARTx)
+{
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	UARTRing* pRing = &UARTRings[UARTx - UART0];
+	UARTStats* pStats = &UARTCounters[UARTx - UART0];
+	uint32_t Status = pUART->MIS;
+	
+	pStats->ISRCalls++;
+	pUART->ICR = Status;
+	
+	if( Status & ( (1<<UART_MIS_RX) | (1<<UART_MIS_RT) ) )
+	{
+		uint8_t* RxBuf = pRing->RxBuf;
+		uint32_t Head = pRing->RxHead;
+		uint32_t End = pRing->RxTail + UART_RX_BUFFER_SIZE;
+		uint32_t Count = 0;
+		
+		while( !GET_BIT(pUART->FR, UART_FR_RXFE) )
+		{
+			uint32_t Data = pUART->DR;
+			
+			Count++;
+			if(Data & UART_DR_ERRORS)
+				UARTCountErrors(UARTx - UART0, Data);
+			if(Head != End)
+				RxBuf[ (Head++) & (UART_RX_BUFFER_SIZE-1) ] = (uint8_t)Data;
+			else
+			{
+				pStats->RxDropped++;
+				End = pRing->RxTail + UART_RX_BUFFER_SIZE;		//	UARTRead() may have made space meanwhile.
+			}
+		}
+		pRing->RxHead = Head;										//	Publish the new bytes to UARTRead().
+		
+		if(Count > pStats->RxFIFOHighWater)
+			pStats->RxFIFOHighWater = Count;
+		if(Head - (End - UART_RX_BUFFER_SIZE) > pStats->RxRingHighWater)
+			pStats->RxRingHighWater = Head - (End - UART_RX_BUFFER_SIZE);
+	}
+	
+	if( Status & (1<<UART_MIS_TX) )
+	{
+		UARTFillTxFIFO(pUART, pRing);
+		if(pRing->TxTail == pRing->TxHead)
+			pUART->IM CLR_BIT( UART_IM_TX );			//	Nothing more to send. UARTWrite() enables it again.
+	}
+}
+
+
+
+/******************************************************************************************************************
+* @UARTDMA_H()																																																		*
+*	@brief			-	Interrupt handler helper for the DMA APIs (see UARTSendDMA()/UARTRecvDMA()). Call it from the handler	*
+*								of the UART. For each channel of the UART which has completed, it starts the next part of the			*
+*								transfer, or ends the transfer and turns off the DMA requests of the UART.												*
+* @UARTx			-	Name of the UART Module.																																					*
+* @return			-	Nothing(void).																																										*
+*																																																									*
+*	@Note				-	Only the DMACHIS bits of the two channels of this UART are read and cleared, so several UARTs can use	*
+*								DMA at the same time. During a continuous receive (UARTStartStream()) it also hands completed			*
+*								halves to the application, and flushes a partial half on the Rx time-out.													*
+******************************************************************************************************************/
+void UARTDMA_H(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - UART0);
+	UARTDMATransfer* pXfer = &UARTDMATransfers[index];
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	uint32_t TxMask = 1UL << UARTDMATxChannel[index];
+	uint32_t RxMask = 1UL << UARTDMARxChannel[index];
+	uint32_t Status = DMAGetIntStatus() & (TxMask | RxMask);
+	uint32_t Errors = pUART->RIS & UART_RIS_ERRORS;
+	
+	DMAClearIntStatus(Status);
+	
+	// The controller takes the bytes without their error bits, so the errors are counted from RIS instead. Its error
+	// bits are one position below those of DR.
+	UARTCounters[index].ISRCalls++;
+	if(Errors)
+	{
+		pUART->ICR = Errors;
+		UARTCountErrors(index, Errors << 1);
+	}
+	
+	if( (Status & TxMask) && pXfer->TxBusy )
+	{
+		if(pXfer->TxLeft > 0)
+			UARTDMANextTx(index);
+		else
+		{
+			pUART->DMACTL CLR_BIT(UART_DMACTL_TXDMAE);
+			pXfer->TxBusy = 0;
+		}
+	}
+	
+	if( UARTStreams[index].Active )
+	{
+		uint32_t Timeout = pUART->MIS & (1<<UART_MIS_RT);
+		
+		pUART->ICR = Timeout;
+		UARTStreamCollect(index);
+		if(Timeout)
+			UARTStreamFlush(index);
+	}
+	else if( (Status & RxMask) && pXfer->RxBusy )
+	{
+		if(pXfer->RxLeft > 0)
+			UARTDMANextRx(index);
+		else
+		{
+			pUART->DMACTL CLR_BIT(UART_DMACTL_RXDMAE);
+			pXfer->RxBusy = 0;
+		}
+	}
+}
+
+
+
+/******************************************************************************************************************
+* @UARTFrame_H()																																																	*
+*	@brief			-	Interrupt handler helper for the framed transport (see UARTStartFramed()). Call it from the handler of	*
+*								the UART. It decodes the bytes in the Rx FIFO into the slot being filled, and encodes the frame being	*
+*								sent into the Tx FIFO.																																						*
+* @UARTx			-	Name of the UART Module.																																					*
+* @return			-	Nothing(void).																																										*
+******************************************************************************************************************/
+void UARTFrame_H(uint8_t UARTx)
+{
+	uint8_t index = (UARTx - UART0);
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+	UARTFramer* pFramer = &UARTFramers[index];
+	UARTStats* pStats = &UARTCounters[index];
+	uint32_t Status = pUART->MIS;
+	
+	pStats->ISRCalls++;
+	pUART->ICR = Status;
+	
+	if( Status & ( (1<<UART_MIS_RX) | (1<<UART_MIS_RT) ) )
+	{
+		uint32_t Count = 0;
+		
+		while( !GET_BIT(pUART->FR, UART_FR_RXFE) )
+		{
+			uint32_t Data = pUART->DR;
+			
+			Count++;
+			if(Data & UART_DR_ERRORS)
+				UARTCountErrors(index, Data);
+			UARTFramePut(index, Data);
+		}
+		if(Count > pStats->RxFIFOHighWater)
+			pStats->RxFIFOHighWater = Count;
+	}
+	
+	if( (Status & (1<<UART_MIS_TX)) && pFramer->TxBusy )
+	{
+		UARTFrameFillTxFIFO(pUART, pFramer);
+		if(!pFramer->TxBusy)
+			pUART->IM CLR_BIT( UART_IM_TX );			//	Whole frame is in the FIFO. UARTSendFrame() enables it again.
 	}
 }
@@ -61,6 +61,10 @@
 #define UART_CTL_RTSEN		14				//	Enable Request-To-Send
 #define UART_CTL_CTSEN		15				//	Enable Clear-To-Send
 
+// Interrupt FIFO Level Select Register
+#define UART_IFLS_TX			0					//	Tx FIFO Level Select (3 bits)
+#define UART_IFLS_RX			3					//	Rx FIFO Level Select (3 bits)
+
 // Interrupt Mask Register
 #define UART_IM_CTS				1					//	Clear-To-Send Modem Interrupt
 #define UART_IM_RX				4					//	Receive Interrupt
@@ -105,6 +109,10 @@
 #define UART_ICR_OE				10				//	Overrun Error
 #define UART_ICR_9BIT			12				//	9-Bit Mode
 
+// 9-Bit Self Address Register
+#define UART_9BITADDR_ADDR		0				//	Self Address for 9-Bit Mode (8 bits)
+#define UART_9BITADDR_9BITEN	15			//	Enable 9-Bit Mode
+
 // DMA Control Register
 #define UART_DMACTL_RXDMAE		0			//	Rx DMA Enable
 #define UART_DMACTL_TXDMAE		1			//	Tx DMA Enable
@@ -141,7 +149,7 @@ extern uint8_t* UARTTransferBuffer[8];
 	This array stores the lengths (in bytes) of data buffers of each UART peripheral. These are used by interrupt
 	handlers.
 ******************************************************************************************************************/
-extern int8_t UARTTransferLength[8];
+extern uint32_t UARTTransferLength[8];
 
 /******************************************************************************************************************
 	@BaudRateArray
@@ -151,6 +159,12 @@ extern int8_t UARTTransferLength[8];
 ******************************************************************************************************************/
 extern uint16_t BaudRateArray[8];
 
+/******************************************************************************************************************
+	@UARTIRQNumber
+	Interrupt numbers (NVIC) of UART0 - UART7. Index = UARTx - UART0.
+******************************************************************************************************************/
+extern const uint8_t UARTIRQNumber[8];
+
 // @BaudRate
 #define BaudRate_1200					0
 #define BaudRate_2400					1
@@ -161,6 +175,41 @@ extern uint16_t BaudRateArray[8];
 #define BaudRate_57600				6
 #define BaudRate_115200				7
 
+/*****************************************************************************************************************
+	@UART_BRD64
+	Baud rate divisor multiplied by 64 (i.e. IBRD*64 + FBRD), rounded to the nearest integer. HSE selects a clock
+	divider of 8 instead of 16. Only integer math is used, so the result is a constant for constant inputs.
+	Ex: UART_BRD64(16000000, 115200, 0) = 556 => IBRD = 8, FBRD = 44.
+
+	@UART_ACHIEVED_BAUD		-	Baud rate which the UART really runs at, for a given divisor.
+	@UART_BAUD_ERROR_PPM	-	Error of the achieved baud rate in parts per million (signed).
+	@UART_USE_HSE					-	1 if high-speed mode (clock divider of 8) should be used. It is used when the baud rate can't be
+													reached with a divider of 16, or when the error with a divider of 16 is above
+													UART_HSE_ERROR_PPM and the error with a divider of 8 is lower.
+													Ex: At 16 MHz, 921600 baud has an error of +6440 ppm with 16, and -799 ppm with 8.
+******************************************************************************************************************/
+#define UART_BRD64(Clk, Baud, HSE)						( (uint32_t)( ( (uint64_t)(Clk)*((HSE)?8:4) + (Baud)/2 ) / (Baud) ) )
+#define UART_ACHIEVED_BAUD(Clk, BRD64, HSE)		( (uint32_t)( ( (uint64_t)(Clk)*((HSE)?8:4) + (BRD64)/2 ) / (BRD64) ) )
+#define UART_BAUD_ERROR_PPM(Baud, Achieved)		( (int32_t)( ( ((int64_t)(Achieved) - (int64_t)(Baud))*1000000 ) / (int64_t)(Baud) ) )
+
+#define UART_HSE_ERROR_PPM										1000
+#define UART_ABS_ERROR_PPM(Clk, Baud, HSE)		( UART_BAUD_ERROR_PPM(Baud, UART_ACHIEVED_BAUD(Clk, UART_BRD64(Clk, Baud, HSE), HSE)) < 0	\
+																								? -UART_BAUD_ERROR_PPM(Baud, UART_ACHIEVED_BAUD(Clk, UART_BRD64(Clk, Baud, HSE), HSE))	\
+																								:  UART_BAUD_ERROR_PPM(Baud, UART_ACHIEVED_BAUD(Clk, UART_BRD64(Clk, Baud, HSE), HSE)) )
+#define UART_USE_HSE(Clk, Baud)								( UART_BRD64(Clk, Baud, 0) < 64																												\
+																								|| ( UART_ABS_ERROR_PPM(Clk, Baud, 0) > UART_HSE_ERROR_PPM													\
+																										&& UART_ABS_ERROR_PPM(Clk, Baud, 1) < UART_ABS_ERROR_PPM(Clk, Baud, 0) ) )
+
+// Limits of the divisor (IBRD is 16 bits and must not be 0, FBRD is 6 bits).
+#define UART_BRD64_MIN				64
+#define UART_BRD64_MAX				0x3FFFFF
+
+// Automatic baud rate detection (UARTAutoBaud()). A level of the Rx pin which lasts longer than UART_AUTOBAUD_POLLS
+// polls (at least one bit period at UART_AUTOBAUD_MIN_BAUD) ends the sync byte being timed.
+#define UART_AUTOBAUD_MIN_BAUD		1200
+#define UART_AUTOBAUD_POLLS				(SYS_CLK / UART_AUTOBAUD_MIN_BAUD)
+#define UART_AUTOBAUD_TOLERANCE		3				//	Percent within which a measured rate is rounded to a standard rate
+
 // @ParityControl
 #define DisableParity					0
 #define EvenParity						1
@@ -176,6 +225,9 @@ extern uint16_t BaudRateArray[8];
 #define EnableHWFlowControl				ENABLE
 #define DisableHWFlowControl			DISABLE
 
+// Returned by UARTGetRTSPin()/UARTGetCTSPin() for modules without flow control signals.
+#define UART_NO_PIN								0xFF
+
 // @NoOfStopBits
 #define OneStopBit						0
 #define TwoStopBits						1
@@ -184,49 +236,188 @@ extern uint16_t BaudRateArray[8];
 #define EnableFIFO						ENABLE
 #define DisableFIFO						DISABLE
 
+// @FIFOLevel
+// Tx interrupt comes when the Tx FIFO drains to this level, Rx interrupt when the Rx FIFO fills to this level.
+#define FIFOLevel_1_8					0				//	2 of 16 entries
+#define FIFOLevel_1_4					1				//	4 of 16 entries
+#define FIFOLevel_1_2					2				//	8 of 16 entries (reset value)
+#define FIFOLevel_3_4					3				//	12 of 16 entries
+#define FIFOLevel_7_8					4				//	14 of 16 entries
+
+// @Framing - Framing of the framed transport (UARTStartFramed()).
+#define FramingCOBS						0				//	Consistent Overhead Byte Stuffing, frames end with 0x00
+#define FramingSLIP						1				//	RFC 1055, frames start and end with UART_SLIP_END
+
+#define UART_COBS_DELIMITER		0x00
+#define UART_SLIP_END					0xC0
+#define UART_SLIP_ESC					0xDB
+#define UART_SLIP_ESC_END			0xDC
+#define UART_SLIP_ESC_ESC			0xDD
+
+// No of frames which the framed transport can hold for the application.
+#define UART_FRAME_SLOTS			4
+
+// Error bits of DR (a received byte) and of RIS/MIS/ICR.
+#define UART_DR_ERRORS				( (1<<UART_DR_FE) | (1<<UART_DR_PE) | (1<<UART_DR_BE) | (1<<UART_DR_OE) )
+#define UART_RIS_ERRORS				( (1<<UART_RIS_FE) | (1<<UART_RIS_PE) | (1<<UART_RIS_BE) | (1<<UART_RIS_OE) )
+
+// Sizes of the Tx/Rx ring buffers of each UART, used by the buffered APIs (UARTStartBuffered()). Must be powers of 2.
+#define UART_TX_BUFFER_SIZE		64
+#define UART_RX_BUFFER_SIZE		64
+
+
+/******************************************************************************************************************
+	@UARTStats
+	Line-error and load counters of an UART module, read with UARTGetStats(). Errors are counted per received byte by
+	the APIs which read DR, and once per UARTDMA_H() call in which RIS shows them when the uDMA controller receives.
+******************************************************************************************************************/
+typedef struct
+{
+	uint32_t FramingErrors;								//	Bytes received without a valid stop bit
+	uint32_t ParityErrors;								//	Bytes received with a wrong parity bit
+	uint32_t BreakErrors;									//	Rx line held low for longer than a frame
+	uint32_t Overruns;										//	Times a byte was lost because the Rx FIFO was full
+	uint32_t RxDropped;										//	Bytes lost because the Rx ring was full (buffered mode)
+	uint32_t FramesDropped;								//	Received frames dropped by the framed transport
+	uint32_t RxFIFOHighWater;							//	Most bytes taken out of the Rx FIFO by one handler call
+	uint32_t RxRingHighWater;							//	Most bytes waiting in the Rx ring (buffered mode)
+	uint32_t ISRCalls;										//	Calls of the handler helpers (UARTIT_H(), UARTDMA_H(), UARTFrame_H() etc.)
+}UARTStats;
+
 
 /******************************************************************************************************************
 *																					APIs Supported by this Driver																						*
 *	Below are the prototypes for driver APIs																																				*
-*
+*																																																									*
 ******************************************************************************************************************/
 void UARTClockControl(uint8_t UARTx, uint8_t ENorDI);
 void UARTInit(uint8_t UARTx, uint8_t WordLength, uint8_t BaudRate, uint8_t ParityMode, uint8_t NoOfStopBits, uint8_t FIFOControl);
+uint32_t UARTInitBaud(uint8_t UARTx, uint8_t WordLength, uint32_t Baud, uint8_t ParityMode, uint8_t NoOfStopBits, uint8_t FIFOControl);
 void UARTDeInit(uint8_t UARTx);
+void UARTSetFIFOLevels(uint8_t UARTx, uint8_t TxLevel, uint8_t RxLevel);
+uint8_t UARTSetFlowControl(uint8_t UARTx, uint8_t HWFlowControl);
+void UARTSet9BitMode(uint8_t UARTx, uint8_t ENorDI, uint8_t Address, uint8_t Mask);
+uint32_t UARTAutoBaud(uint8_t UARTx, uint8_t Timerx, uint32_t Timeout);
 
-void UARTSend(uint8_t UARTx, uint8_t *TxBuf, int8_t Len);
-void UARTRecv(uint8_t UARTx, uint8_t *RxBuf, int8_t Len);
+void UARTSend(uint8_t UARTx, uint8_t *TxBuf, uint32_t Len);
+void UARTRecv(uint8_t UARTx, uint8_t *RxBuf, uint32_t Len);
 
 void UARTSendByte(uint8_t UARTx, uint8_t TxData);
+void UARTSendAddress(uint8_t UARTx, uint8_t Address);
 uint8_t UARTRecvByte(uint8_t UARTx);
 
-uint8_t UARTSendIT(uint8_t UARTx, uint8_t *TxBuf, uint8_t Len);
-uint8_t UARTRecvIT(uint8_t UARTx, uint8_t *RxBuf, uint8_t Len);
+uint8_t UARTSendIT(uint8_t UARTx, uint8_t *TxBuf, uint32_t Len);
+uint8_t UARTRecvIT(uint8_t UARTx, uint8_t *RxBuf, uint32_t Len);
 void UARTSendIT_H(uint8_t UARTx);
 void UARTRecvIT_H(uint8_t UARTx);
 
+/*	Buffered (ring buffer) APIs. After UARTStartBuffered(), UARTWrite() and UARTRead() only copy to/from the ring
+*		buffers of the UART and never wait. The handler of the UART must call UARTIT_H(), which moves the data between
+*		the rings and the hardware FIFOs. After UARTStartPolled() no handler is needed: UARTPoll() does it for all such
+*		UARTs in one pass.
+*/
+void UARTStartBuffered(uint8_t UARTx);
+void UARTStartPolled(uint8_t UARTx);
+uint32_t UARTWrite(uint8_t UARTx, const uint8_t *TxBuf, uint32_t Len);
+uint32_t UARTRead(uint8_t UARTx, uint8_t *RxBuf, uint32_t MaxLen);
+uint32_t UARTRxCount(uint8_t UARTx);
+uint32_t UARTTxSpace(uint8_t UARTx);
+uint8_t UARTPoll(void);
+void UARTIT_H(uint8_t UARTx);
+
+/*	DMA APIs. UARTSendDMA() and UARTRecvDMA() hand a buffer to the Tx/Rx channel of the UART and return; the uDMA
+*		controller moves the data between the buffer and the FIFOs. The handler of the UART must call UARTDMA_H().
+*/
+uint8_t UARTSendDMA(uint8_t UARTx, const uint8_t *TxBuf, uint32_t Len);
+uint8_t UARTRecvDMA(uint8_t UARTx, uint8_t *RxBuf, uint32_t Len);
+uint32_t UARTDMATxPending(uint8_t UARTx);
+uint32_t UARTDMARxPending(uint8_t UARTx);
+void UARTDMA_H(uint8_t UARTx);
+
+/*	Continuous receive. The Rx channel fills two halves in turn; the application is handed whole halves, or a partial
+*		half when the line goes idle, and gives each one back when it is done with it.
+*/
+uint8_t UARTStartStream(uint8_t UARTx, uint8_t *Buf0, uint8_t *Buf1, uint32_t Size);
+uint32_t UARTGetBlock(uint8_t UARTx, uint8_t **pBlock);
+void UARTReleaseBlock(uint8_t UARTx);
+void UARTStopStream(uint8_t UARTx);
+uint32_t UARTStreamStalls(uint8_t UARTx);
+
+/*	Framed transport. Frames are COBS/SLIP encoded while the Tx FIFO is filled, and decoded from the Rx FIFO into the
+*		slot where the application reads them. The handler of the UART must call UARTFrame_H().
+*/
+uint8_t UARTStartFramed(uint8_t UARTx, uint8_t Framing, uint8_t *Buf, uint32_t Size);
+uint8_t UARTSendFrame(uint8_t UARTx, const uint8_t *Data, uint32_t Len);
+uint8_t UARTFrameTxBusy(uint8_t UARTx);
+uint32_t UARTGetFrame(uint8_t UARTx, uint8_t **pFrame);
+void UARTReleaseFrame(uint8_t UARTx);
+void UARTStopFramed(uint8_t UARTx);
+void UARTFrame_H(uint8_t UARTx);
+
+/*	Statistics. Counters of line errors, Rx FIFO/ring fill levels and handler calls, to tune FIFO levels and baud rates.
+*/
+void UARTGetStats(uint8_t UARTx, UARTStats* pStats);
+void UARTClearStats(uint8_t UARTx);
+
 
 UART_Reg* UARTGetAddress(uint8_t UARTx);
 uint8_t UARTGetTxPin(uint8_t UARTx);
 uint8_t UARTGetRxPin(uint8_t UARTx);
+uint8_t UARTGetRTSPin(uint8_t UARTx);
+uint8_t UARTGetCTSPin(uint8_t UARTx);
 void WaitWhileUARTisBusy(UART_Reg* pUARTx);
+void WaitWhileTxFIFOisFull(UART_Reg* pUARTx);
 
 #endif
 
 /*
 void UARTClockControl();				[X]
 void UARTInit();								[X]
+uint32_t UARTInitBaud();				[X]
 void UARTDeInit();							[X]
+void UARTSetFIFOLevels();				[X]
+uint8_t UARTSetFlowControl();		[X]
+void UARTSet9BitMode();					[X]
+uint32_t UARTAutoBaud();				[X]
 void UARTSend();								[X]
 void UARTRecv();								[X]
 void UARTSendByte();						[X]
+void UARTSendAddress();					[X]
 uint8_t UARTRecvByte();					[X]
-void UARTSendIT();							[O]
-void UARTRecvIT();							[O]
+void UARTSendIT();							[X]
+void UARTRecvIT();							[X]
+void UARTStartBuffered();				[X]
+void UARTStartPolled();					[X]
+uint32_t UARTWrite();						[X]
+uint32_t UARTRead();						[X]
+uint8_t UARTPoll();							[X]
+void UARTIT_H();								[X]
+uint8_t UARTSendDMA();					[X]
+uint8_t UARTRecvDMA();					[X]
+uint32_t UARTDMATxPending();		[X]
+uint32_t UARTDMARxPending();		[X]
+void UARTDMA_H();								[X]
+uint8_t UARTStartStream();			[X]
+uint32_t UARTGetBlock();				[X]
+void UARTReleaseBlock();				[X]
+void UARTStopStream();					[X]
+uint32_t UARTStreamStalls();		[X]
+uint8_t UARTStartFramed();			[X]
+uint8_t UARTSendFrame();				[X]
+uint8_t UARTFrameTxBusy();			[X]
+uint32_t UARTGetFrame();				[X]
+void UARTReleaseFrame();				[X]
+void UARTStopFramed();					[X]
+void UARTFrame_H();							[X]
+void UARTGetStats();						[X]
+void UARTClearStats();					[X]
 UART_Reg* UARTGetAddress();			[X]
 uint8_t UARTGetTxPin();					[X]
 uint8_t UARTGetRxPin();					[X]
+uint8_t UARTGetRTSPin();				[X]
+uint8_t UARTGetCTSPin();				[X]
 void WaitWhileUARTisBusy();			[X]
+void WaitWhileTxFIFOisFull();		[X]
 
 */
 
@@ -0,0 +1,90 @@
+/******************************************************************************************************************
+*	@file			-	bench_gpio_initport.c
+*
+*	Benchmark of the register accesses needed to configure all eight pins of port B: GPIO_Init() called once per pin
+*	against a single GPIO_InitPort() call with PinMask 0xFF. Both must leave the port registers in the same state.
+*	Reads and writes are counted by the host model, and cycles at its default cost per access.
+******************************************************************************************************************/
+
+#include "TM4C123xxSIM.h"
+#include <stdio.h>
+#include <string.h>
+
+#define REGS		14
+
+typedef struct
+{
+	const char*	Name;
+	uint8_t			ioMode;
+	uint8_t			DriveStrength;
+	uint8_t			Trigger;
+}Config;
+
+static const Config Configs[] = {
+	{ "Output, 2 mA",												Output,						Two_mA,		NoInterrupt	},
+	{ "InputPullUp, 4 mA, FallingEdge",			InputPullUp,			Four_mA,	FallingEdge	},
+	{ "OutputOpenDrain, 8 mA, BothEdges",		OutputOpenDrain,	Eight_mA,	BothEdges		},
+};
+
+static const uint8_t PortB[8] = { PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7 };
+
+
+static void Snapshot(uint32_t* Regs)
+{
+	GPIO_reg* pGPIO = GPIO_B_P;
+	uint8_t i = 0;
+
+	Regs[i++] = pGPIO->GPIO_DIR;		Regs[i++] = pGPIO->GPIO_IS;			Regs[i++] = pGPIO->GPIO_IBE;
+	Regs[i++] = pGPIO->GPIO_IEV;		Regs[i++] = pGPIO->GPIO_IM;			Regs[i++] = pGPIO->GPIO_RIS;
+	Regs[i++] = pGPIO->GPIO_DR2R;		Regs[i++] = pGPIO->GPIO_DR4R;		Regs[i++] = pGPIO->GPIO_DR8R;
+	Regs[i++] = pGPIO->GPIO_ODR;		Regs[i++] = pGPIO->GPIO_PUR;		Regs[i++] = pGPIO->GPIO_PDR;
+	Regs[i++] = pGPIO->GPIO_DEN;		Regs[i++] = pGPIO->GPIO_AMSEL;
+}
+
+
+int main(void)
+{
+	SimStats PerPin, PerPort;
+	uint32_t RegsPin[REGS], RegsPort[REGS];
+	uint8_t c, i, Errors = 0;
+
+	SimInit();
+
+	printf("configuring PB0-PB7                GPIO_Init() x8             GPIO_InitPort()\n");
+	printf("                                   reads writes cycles        reads writes cycles\n");
+
+	for(c = 0; c < sizeof(Configs)/sizeof(Configs[0]); c++)
+	{
+		const Config* p = &Configs[c];
+
+		SimReset();
+		SimResetStats();
+		for(i = 0; i < 8; i++)
+			GPIO_Init(PortB[i], p->ioMode, Digital, p->DriveStrength, p->Trigger);
+		SimGetStats(&PerPin);
+		Snapshot(RegsPin);
+
+		SimReset();
+		SimResetStats();
+		GPIO_InitPort(GPIO_PORT_B, 0xFF, p->ioMode, Digital, p->DriveStrength, p->Trigger);
+		SimGetStats(&PerPort);
+		Snapshot(RegsPort);
+
+		printf("%-35s%5u %6u %6llu        %5u %6u %6llu\n", p->Name,
+					 PerPin.Reads, PerPin.Writes, (unsigned long long)PerPin.Cycles,
+					 PerPort.Reads, PerPort.Writes, (unsigned long long)PerPort.Cycles);
+
+		if( memcmp(RegsPin, RegsPort, sizeof(RegsPin)) != 0 )
+		{
+			printf("FAIL: %s: the port registers differ\n", p->Name);
+			Errors++;
+		}
+		if( PerPort.Reads + PerPort.Writes >= PerPin.Reads + PerPin.Writes )
+		{
+			printf("FAIL: %s: GPIO_InitPort() does not save accesses\n", p->Name);
+			Errors++;
+		}
+	}
+
+	return Errors != 0;
+}
@@ -0,0 +1,137 @@
+/******************************************************************************************************************
+*	@file			-	bench_pin_decode.c
+*
+*	Benchmark of the pin decode on the host model. The table lookup of GPIO_PINS.c is compared with the switch
+*	statements which it replaced, copied below, both for the decode helpers alone and for whole WriteToPin(),
+*	ReadFromPin() and TurnOn() calls. The "switch" copies of those calls have the same bodies as the driver, with
+*	the old decoders. Instructions are counted with SimMeasureBegin()/SimMeasureEnd(), which doesn't count the
+*	register traps, and both decoders must give the same port and bit for every pin on both buses.
+******************************************************************************************************************/
+
+#include "TM4C123xxSIM.h"
+#include <stdio.h>
+
+#define CASES(P)		case P##0: case P##1: case P##2: case P##3: case P##4: case P##5: case P##6: case P##7
+#define BUS(bus, port)		( (bus) == SELECTED_BUS ? GET_BIT(GPIOBusSelect, port) : (bus) )
+
+static const uint8_t Pins[48] = { PA0, PA1, PA2, PA3, PA4, PA5, PA6, PA7, PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7,
+																	PC0, PC1, PC2, PC3, PC4, PC5, PC6, PC7, PD0, PD1, PD2, PD3, PD4, PD5, PD6, PD7,
+																	PE0, PE1, PE2, PE3, PE4, PE5, PE6, PE7, PF0, PF1, PF2, PF3, PF4, PF5, PF6, PF7 };
+
+
+//	Switch-based decode as it was before the lookup table (with the missing break of port C fixed, and the bus
+//	selection of GPIO_SelectBus() added). Not inlined or analysed across calls, like the functions of GPIO_PINS.c
+//	which are called from another file.
+static __attribute__((noipa)) GPIO_reg* SwitchPortAddr(uint8_t pin, uint8_t bus)
+{
+	switch(pin)
+	{
+		case GPIO_PORT_A:	CASES(PA):	return (BUS(bus, GPIO_PORT_A) == AHB_BUS) ? GPIO_A_H : GPIO_A_P;
+		case GPIO_PORT_B:	CASES(PB):	return (BUS(bus, GPIO_PORT_B) == AHB_BUS) ? GPIO_B_H : GPIO_B_P;
+		case GPIO_PORT_C:	CASES(PC):	return (BUS(bus, GPIO_PORT_C) == AHB_BUS) ? GPIO_C_H : GPIO_C_P;
+		case GPIO_PORT_D:	CASES(PD):	return (BUS(bus, GPIO_PORT_D) == AHB_BUS) ? GPIO_D_H : GPIO_D_P;
+		case GPIO_PORT_E:	CASES(PE):	return (BUS(bus, GPIO_PORT_E) == AHB_BUS) ? GPIO_E_H : GPIO_E_P;
+		case GPIO_PORT_F:	CASES(PF):	return (BUS(bus, GPIO_PORT_F) == AHB_BUS) ? GPIO_F_H : GPIO_F_P;
+		default:											return GPIO_A_H;
+	}
+}
+
+static __attribute__((noipa)) uint8_t SwitchPinNumber(uint8_t pin)
+{
+	switch(pin)
+	{
+		case PA0: case PB0: case PC0: case PD0: case PE0: case PF0:		return 0;
+		case PA1: case PB1: case PC1: case PD1: case PE1: case PF1:		return 1;
+		case PA2: case PB2: case PC2: case PD2: case PE2: case PF2:		return 2;
+		case PA3: case PB3: case PC3: case PD3: case PE3: case PF3:		return 3;
+		case PA4: case PB4: case PC4: case PD4: case PE4: case PF4:		return 4;
+		case PA5: case PB5: case PC5: case PD5: case PE5: case PF5:		return 5;
+		case PA6: case PB6: case PC6: case PD6: case PE6: case PF6:		return 6;
+		case PA7: case PB7: case PC7: case PD7: case PE7: case PF7:		return 7;
+		default:																											return 0;
+	}
+}
+
+
+//	WriteToPin(), ReadFromPin() and TurnOn() of the driver, on the switch-based decode.
+static __attribute__((noipa)) void SwitchWriteToPin(uint8_t pin, uint8_t Value)
+{
+	GPIO_reg* pGPIO = SwitchPortAddr(pin, SELECTED_BUS);
+	uint8_t PinMask = 1<<SwitchPinNumber(pin);
+
+	if(Value == PIN_SET)					pGPIO->GPIO_DATA_A[PinMask] = 0xFF;
+	else if(Value == PIN_RESET)		pGPIO->GPIO_DATA_A[PinMask] = 0x00;
+}
+
+static __attribute__((noipa)) uint8_t SwitchReadFromPin(uint8_t pin)
+{
+	GPIO_reg* pGPIOx = SwitchPortAddr(pin, SELECTED_BUS);
+	return GET_BIT( pGPIOx->GPIO_DATA, SwitchPinNumber(pin) );
+}
+
+static __attribute__((noipa)) void SwitchTurnOn(uint8_t pin)
+{
+	(SwitchPortAddr(pin,SELECTED_BUS))->GPIO_DATA_A[1<<SwitchPinNumber(pin)] = 0xFF;
+}
+
+
+// Keeps the compiler from dropping the calls which are measured.
+static GPIO_reg* __vo Sink;
+static __vo uint8_t SinkBit;
+
+#define NO_OF_TESTS		5
+static const char* const TestNames[NO_OF_TESTS] = { "getPinNumber()", "getPortAddr()", "WriteToPin()", "ReadFromPin()",
+																										"TurnOn()" };
+
+#define MEASURE(Sum, Call)		do{ SimMeasureBegin(); Call; (Sum) += SimMeasureEnd(); }while(0)
+
+
+int main(void)
+{
+	uint64_t Count[NO_OF_TESTS][2] = {{0}};
+	uint8_t i, t, bus, Errors = 0;
+
+	SimInit();
+	GPIO_InitPort(GPIO_PORT_A, 0xFF, Output, Digital, Two_mA, NoInterrupt);
+	GPIO_InitPort(GPIO_PORT_B, 0xFF, Output, Digital, Two_mA, NoInterrupt);
+	GPIO_InitPort(GPIO_PORT_C, 0xFF, Output, Digital, Two_mA, NoInterrupt);
+	GPIO_InitPort(GPIO_PORT_D, 0xFF, Output, Digital, Two_mA, NoInterrupt);
+	GPIO_InitPort(GPIO_PORT_E, 0xFF, Output, Digital, Two_mA, NoInterrupt);
+	GPIO_InitPort(GPIO_PORT_F, 0xFF, Output, Digital, Two_mA, NoInterrupt);
+
+	for(i = 0; i < 48; i++)
+	{
+		uint8_t pin = Pins[i];
+
+		for(bus = APB_BUS; bus <= SELECTED_BUS; bus++)
+			if( getPortAddr(pin, bus) != SwitchPortAddr(pin, bus) )
+			{
+				printf("FAIL: pin %u decodes to another port on bus %u\n", pin, bus);
+				Errors++;
+			}
+		if( getPinNumber(pin) != SwitchPinNumber(pin) )
+		{
+			printf("FAIL: pin %u decodes to another bit\n", pin);
+			Errors++;
+		}
+
+		MEASURE( Count[0][0], SinkBit = SwitchPinNumber(pin) );
+		MEASURE( Count[0][1], SinkBit = getPinNumber(pin) );
+		MEASURE( Count[1][0], Sink = SwitchPortAddr(pin, SELECTED_BUS) );
+		MEASURE( Count[1][1], Sink = getPortAddr(pin, SELECTED_BUS) );
+		MEASURE( Count[2][0], SwitchWriteToPin(pin, PIN_SET) );
+		MEASURE( Count[2][1], WriteToPin(pin, PIN_SET) );
+		MEASURE( Count[3][0], SinkBit = SwitchReadFromPin(pin) );
+		MEASURE( Count[3][1], SinkBit = ReadFromPin(pin) );
+		MEASURE( Count[4][0], SwitchTurnOn(pin) );
+		MEASURE( Count[4][1], TurnOn(pin) );
+	}
+
+	printf("average over 48 pins, in host instructions per call (register traps not counted):\n");
+	printf("                    switch   table   saved\n");
+	for(t = 0; t < NO_OF_TESTS; t++)
+		printf("  %-16s %7.1f %7.1f %7.1f\n", TestNames[t], Count[t][0]/48.0, Count[t][1]/48.0,
+					 (Count[t][0] - (double)Count[t][1])/48.0);
+
+	return Errors != 0;
+}
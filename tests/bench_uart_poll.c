@@ -0,0 +1,158 @@
+/******************************************************************************************************************
+*	@file			-	bench_uart_poll.c
+*
+*	Aggregate throughput of 1 and 8 UARTs at 115200 baud, each one sending and receiving N bytes at the same time, in
+*	three modes:
+*	<>	blocking	:	UARTSend() to each UART in turn (send only).
+*	<>	irq				:	UARTStartBuffered(), one interrupt handler call per UART with work.
+*	<>	poll			:	UARTStartPolled(), one UARTPoll() call per tick serves all UARTs with work.
+*	Every tick, each UART gets up to 8 more bytes on its Rx line and the application moves data through the rings.
+*	The program reports the time, the aggregate Tx bytes/s, the handler calls or polls, and the register accesses.
+*	It fails if a byte is lost or changed, or if an Rx FIFO overruns.
+******************************************************************************************************************/
+
+#include "TM4C123xxSIM.h"
+#include <stdio.h>
+#include <string.h>
+
+#define N					2000
+#define MAX_TICKS	200000
+#define TICK			( 4 * 10 * SYS_CLK / 115200 )					//	About 4 byte times at 115200 8N1
+
+#define BLOCKING	0
+#define IRQ				1
+#define POLL			2
+
+static const char* const ModeNames[3] = { "blocking", "irq", "poll" };
+static const uint8_t IRQs[8] = { SIM_IRQ_UART0, SIM_IRQ_UART1, SIM_IRQ_UART2, SIM_IRQ_UART3, SIM_IRQ_UART4,
+																 SIM_IRQ_UART5, SIM_IRQ_UART6, SIM_IRQ_UART7 };
+
+static uint8_t Src[8][N], Got[8][N], Line[8][N];
+static uint32_t Sent[8], Rcvd[8], Fed[8];
+static unsigned Errors;
+
+#define HANDLER(n)		static void UART##n##_Handler(void)		{ UARTIT_H(UART0 + n); }
+HANDLER(0) HANDLER(1) HANDLER(2) HANDLER(3) HANDLER(4) HANDLER(5) HANDLER(6) HANDLER(7)
+static void (* const Handlers[8])(void) = { UART0_Handler, UART1_Handler, UART2_Handler, UART3_Handler,
+																						UART4_Handler, UART5_Handler, UART6_Handler, UART7_Handler };
+
+
+static void Setup(uint8_t Mode, uint8_t NoOfUARTs)
+{
+	uint8_t u;
+
+	SimReset();
+	for(u = 0; u < 8; u++)
+	{
+		Sent[u] = Rcvd[u] = Fed[u] = 0;
+		SimAttachISR(IRQs[u], Mode == IRQ ? Handlers[u] : NULL);
+	}
+	for(u = 0; u < NoOfUARTs; u++)
+	{
+		UARTInitBaud(UART0 + u, _8bit_WordLength, 115200, DisableParity, OneStopBit, EnableFIFO);
+		if(Mode == IRQ)				UARTStartBuffered(UART0 + u);
+		else if(Mode == POLL)	UARTStartPolled(UART0 + u);
+	}
+}
+
+
+static uint8_t Done(uint8_t NoOfUARTs)
+{
+	uint8_t u;
+
+	for(u = 0; u < NoOfUARTs; u++)
+		if( Rcvd[u] < N || Sent[u] < N || UARTTxSpace(UART0 + u) < UART_TX_BUFFER_SIZE )
+			return 0;
+	return 1;
+}
+
+
+static void Run(uint8_t Mode, uint8_t NoOfUARTs)
+{
+	SimStats s;
+	uint32_t Calls = 0, Polls = 0, Ticks = 0, Total = 0, Drops = 0, Overruns = 0;
+	uint8_t u;
+	double Seconds;
+
+	Setup(Mode, NoOfUARTs);
+	SimResetStats();
+
+	if(Mode == BLOCKING)
+	{
+		for(u = 0; u < NoOfUARTs; u++)
+			UARTSend(UART0 + u, Src[u], N);
+	}
+	else while( !Done(NoOfUARTs) && Ticks < MAX_TICKS )
+	{
+		Ticks++;
+		for(u = 0; u < NoOfUARTs; u++)
+		{
+			if(Fed[u] < N && Ticks % 2 == 0)
+			{
+				uint32_t k = (N - Fed[u] < 8) ? N - Fed[u] : 8;
+				SimUARTInject(UART0 + u, Src[u] + Fed[u], k);
+				Fed[u] += k;
+			}
+			if(Sent[u] < N)
+				Sent[u] += UARTWrite(UART0 + u, Src[u] + Sent[u], N - Sent[u]);
+			Rcvd[u] += UARTRead(UART0 + u, Got[u] + Rcvd[u], N - Rcvd[u]);
+		}
+
+		SimAdvance(TICK);
+		if(Mode == IRQ)
+			Calls += SimDispatchInterrupts();
+		else
+		{
+			Calls += __builtin_popcount( UARTPoll() );
+			Polls++;
+		}
+	}
+	for(u = 0; u < NoOfUARTs; u++)
+		WaitWhileUARTisBusy( UARTGetAddress(UART0 + u) );
+	SimGetStats(&s);
+
+	for(u = 0; u < NoOfUARTs; u++)
+	{
+		UARTStats Stats;
+		uint32_t n = SimUARTTakeTx(UART0 + u, Line[u], N);
+
+		Total += n;
+		if( n != N || memcmp(Line[u], Src[u], N) != 0 || (Mode != BLOCKING && memcmp(Got[u], Src[u], N) != 0) )
+		{
+			printf("FAIL: %s, UART%u: data lost or changed\n", ModeNames[Mode], u);
+			Errors++;
+		}
+		UARTGetStats(UART0 + u, &Stats);
+		Drops += Stats.RxDropped;
+		Overruns += Stats.Overruns;
+	}
+	if(Drops || Overruns)
+	{
+		printf("FAIL: %s, %u UARTs: %u bytes dropped, %u overruns\n", ModeNames[Mode], NoOfUARTs, Drops, Overruns);
+		Errors++;
+	}
+
+	Seconds = (double)s.Cycles / SYS_CLK;
+	printf("%-9s %5u %9.3f %10.0f %8u %7u %9u\n", ModeNames[Mode], NoOfUARTs, Seconds, Total / Seconds, Calls, Polls,
+				 s.Reads + s.Writes);
+}
+
+
+int main(void)
+{
+	uint32_t i;
+	uint8_t u, Mode;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+	for(u = 0; u < 8; u++)
+		for(i = 0; i < N; i++)
+			Src[u][i] = (uint8_t)(i * 7 + u * 31 + i / 253);
+
+	SimInit();
+	printf("mode      uarts  time (s)  Tx bytes/s  served   polls  accesses\n");
+	for(u = 1; u <= 8; u *= 8)
+		for(Mode = BLOCKING; Mode <= POLL; Mode++)
+			Run(Mode, u);
+
+	return Errors != 0;
+}
@@ -0,0 +1,92 @@
+/******************************************************************************************************************
+*	@file			-	bench_uart_send.c
+*
+*	Benchmark of UARTSend() against the send it replaced, copied below, which waited on BUSY before every byte so
+*	the Tx FIFO never held more than one byte. For each baud rate and length, it reports the cycles until the call
+*	returns and until the line is idle, the line throughput in bytes/s, and the FR reads made by the call. FR reads
+*	beyond one per byte are reads which found the UART not ready (stalls). The bytes on the line must match the buffer.
+******************************************************************************************************************/
+
+#include "TM4C123xxSIM.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_LEN		256
+
+static const uint32_t	Bauds[]		= { 115200, 1000000 };
+static const uint32_t	Lengths[]	= { 16, 100, 256 };
+
+static const char* const Names[2] = { "old", "new" };
+
+static uint8_t TxBuf[MAX_LEN], Line[MAX_LEN + 16];
+static unsigned Errors;
+
+
+//	UARTSend() as it was before the Tx FIFO was kept full.
+static void OldSend(uint8_t UARTx, uint8_t *pBuf, uint32_t Len)
+{
+	UART_Reg* pUART = UARTGetAddress(UARTx);
+
+	while(Len>0)
+	{
+		WaitWhileUARTisBusy(pUART);
+		pUART->DR = (*pBuf);
+		pBuf++;
+		Len--;
+	}
+}
+
+
+int main(void)
+{
+	uint32_t FR = (uint32_t)(uintptr_t) &((UART_Reg*)UART0_BASE_ADDRESS)->FR;
+	uint8_t b, l, k;
+	uint32_t i;
+
+	setvbuf(stdout, NULL, _IONBF, 0);
+	for(i = 0; i < MAX_LEN; i++)
+		TxBuf[i] = (uint8_t)(i * 7 + 1);
+
+	SimInit();
+	printf("  baud  len  send   return cycles   idle cycles    bytes/s   FR reads   stalls\n");
+
+	for(b = 0; b < sizeof(Bauds)/sizeof(Bauds[0]); b++)
+	{
+		for(l = 0; l < sizeof(Lengths)/sizeof(Lengths[0]); l++)
+		{
+			uint32_t Len = Lengths[l];
+
+			for(k = 0; k < 2; k++)
+			{
+				SimStats Returned, Idle;
+				uint32_t Reads, n;
+
+				SimReset();
+				UARTInitBaud(UART0, _8bit_WordLength, Bauds[b], DisableParity, OneStopBit, EnableFIFO);
+				pUART0->CTL |= (1<<UART_CTL_TXE) | (1<<UART_CTL_RXE);
+
+				SimResetStats();
+				if(k == 0)		OldSend(UART0, TxBuf, Len);
+				else					UARTSend(UART0, TxBuf, Len);
+				SimGetStats(&Returned);
+				Reads = SimRegReads(FR);
+
+				WaitWhileUARTisBusy(pUART0);
+				SimGetStats(&Idle);
+				n = SimUARTTakeTx(UART0, Line, sizeof(Line));
+
+				printf("%7u %4u  %s  %14llu %13llu %10.0f %10u %8u\n", Bauds[b], Len, Names[k],
+							 (unsigned long long)Returned.Cycles, (unsigned long long)Idle.Cycles,
+							 Len * (double)SYS_CLK / Idle.Cycles, Reads, Reads > Len ? Reads - Len : 0);
+
+				if(n != Len || memcmp(Line, TxBuf, Len) != 0)
+				{
+					printf("FAIL: %s send of %u bytes at %u baud put %u bytes on the line\n", Names[k], Len, Bauds[b], n);
+					Errors++;
+				}
+			}
+		}
+	}
+
+	return Errors != 0;
+}
@@ -0,0 +1,120 @@
+/******************************************************************************************************************
+*	@file			-	test_debounce.c
+*
+*	Host test of the vertical-counter debouncer. Bouncing and stable levels are driven on the pins, one sample per
+*	DebounceIT_H() call. A press or release must be reported on the DEBOUNCE_SAMPLES-th equal sample in a row and not
+*	before, a glitch shorter than that must be rejected, and pins of one port and of another port must be debounced
+*	independently. Both pin polarities (InputPullDown and InputPullUp) are covered.
+******************************************************************************************************************/
+
+#include "TM4C123xxSIM.h"
+#include <stdio.h>
+
+typedef struct
+{
+	const char*	Name;
+	uint8_t			pin;
+	const char*	Levels;											//	Level of the pin on each tick
+	const char*	Events;											//	'P' (press) or 'R' (release) on the tick where it's expected, else '.'
+}Case;
+
+//	PB0 is active high (InputPullDown), PB1 and PF4 are active low (InputPullUp).
+static const Case Cases[] = {
+	{ "stable released",										PB0,	"0000000000",	".........."	},
+	{ "clean press",												PB0,	"1111111111",	"...P......"	},
+	{ "clean release",											PB0,	"0000000000",	"...R......"	},
+	{ "glitch of 1 sample",									PB0,	"0100000000",	".........."	},
+	{ "glitch of 3 samples",								PB0,	"0111000000",	".........."	},
+	{ "bouncing press",											PB0,	"1011011111",	"........P."	},
+	{ "bouncing release",										PB0,	"0100100000",	"........R."	},
+	{ "glitch of 3 samples, active low",		PB1,	"1000111111",	".........."	},
+	{ "bouncing press, active low",					PB1,	"0101000000",	".......P.."	},
+	{ "clean release, active low",					PB1,	"1111111111",	"...R......"	},
+	{ "press on another port",							PF4,	"0000000000",	"...P......"	},
+	{ "glitch, then release",								PF4,	"1101111111",	"......R..."	},
+};
+
+static unsigned Errors;
+
+
+static void Fail(const char* Name, const char* What, uint32_t Tick)
+{
+	printf("FAIL: %s: %s on tick %u\n", Name, What, Tick);
+	Errors++;
+}
+
+
+int main(void)
+{
+	static const uint8_t Pins[3] = { PB0, PB1, PF4 };
+	uint8_t State[3] = { 0, 0, 0 };										//	Debounced states the pins should have
+	DebounceEvent Events[DEBOUNCE_EVENT_BUFFER_SIZE];
+	uint32_t c, t, n;
+	uint8_t p;
+
+	SimInit();
+	SimSetPinLevel(PB0, 0);
+	SimSetPinLevel(PB1, 1);
+	SimSetPinLevel(PF4, 1);
+	DebouncePin(PB0, InputPullDown);
+	DebouncePin(PB1, InputPullUp);
+	DebouncePin(PF4, InputPullUp);
+	GPIO_DebounceInit(Timer1, 80000);
+
+	for(c = 0; c < sizeof(Cases)/sizeof(Cases[0]); c++)
+	{
+		const Case* k = &Cases[c];
+		uint8_t Before = ReadDebouncedPin(k->pin);
+
+		for(t = 0; k->Levels[t] != '\0'; t++)
+		{
+			SimSetPinLevel(k->pin, k->Levels[t] - '0');
+			DebounceIT_H();
+			n = GPIO_ReadButtonEvents(Events, DEBOUNCE_EVENT_BUFFER_SIZE);
+
+			if(k->Events[t] == '.')
+			{
+				if(n != 0)
+					Fail(k->Name, "unexpected event", t);
+				if(ReadDebouncedPin(k->pin) != Before)
+					Fail(k->Name, "state changed without an event", t);
+				continue;
+			}
+			if(n != 1 || Events[0].pin != k->pin || Events[0].Pressed != (k->Events[t] == 'P'))
+			{
+				Fail(k->Name, "missing or wrong event", t);
+				continue;
+			}
+			Before = Events[0].Pressed;
+			if(ReadDebouncedPin(k->pin) != Before)
+				Fail(k->Name, "state doesn't match the event", t);
+		}
+
+		//	The other pins are held stable and must keep their state.
+		for(p = 0; p < 3; p++)
+		{
+			if(Pins[p] == k->pin)
+				State[p] = Before;
+			else if(ReadDebouncedPin(Pins[p]) != State[p])
+				Fail(k->Name, "another pin changed", t);
+		}
+	}
+
+	//	Two pins of one port, pressed on the same ticks, give both events from one sample, lowest pin first.
+	for(t = 0; t < DEBOUNCE_SAMPLES; t++)
+	{
+		SimSetPinLevel(PB0, 1);
+		SimSetPinLevel(PB1, 0);
+		DebounceIT_H();
+		n = GPIO_ReadButtonEvents(Events, DEBOUNCE_EVENT_BUFFER_SIZE);
+		if(t < DEBOUNCE_SAMPLES - 1 && n != 0)
+			Fail("two pins of one port", "unexpected event", t);
+	}
+	if(n != 2 || Events[0].pin != PB0 || Events[0].Pressed != 1 || Events[1].pin != PB1 || Events[1].Pressed != 1)
+		Fail("two pins of one port", "missing or wrong events", t - 1);
+	if(DebounceOverflows != 0)
+		Fail("all cases", "events dropped", t);
+
+	printf("%u failures\n", Errors);
+	return Errors != 0;
+}
@@ -0,0 +1,121 @@
+/******************************************************************************************************************
+*	@file			-	test_dma_descriptors.c
+*
+*	Host test of the uDMA control structures. Control words from DMAControlWord() and end pointers from
+*	DMASetTransfer()/DMAFillEntry() are compared with values worked out by hand from the datasheet layout. The
+*	primary structure of DMASetScatterGather() is checked the same way, and an auto-mode copy and a three-task
+*	memory scatter-gather copy are then run on the model.
+******************************************************************************************************************/
+
+#include "TM4C123xxSIM.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct
+{
+	uint8_t		Mode, Size, SrcInc, DstInc, Arb;
+	uint32_t	Count;
+	uint32_t	Control;											//	Expected control word
+	uint32_t	SrcOffset, DstOffset;					//	Expected end pointers, from the start of the buffers
+}Case;
+
+static const Case Cases[] = {
+	//	DSTINC=2 DSTSIZE=2 SRCINC=2 SRCSIZE=2 ARBSIZE=3 XFERSIZE=99 => last item at 99*4
+	{ DMA_Mode_Auto,			DMA_Size_32bit, DMA_Inc_32bit, DMA_Inc_32bit, DMA_Arb_8,		100,	0xAA00C632,	396,	396		},
+	//	Memory to a data register: DSTINC=3 (none), ARBSIZE=2, XFERSIZE=15
+	{ DMA_Mode_Basic,			DMA_Size_8bit,	DMA_Inc_8bit,		DMA_Inc_None,	 DMA_Arb_4,		16,		0xC00080F1,	15,		0			},
+	//	Data register to memory, largest transfer: DSTINC=1 DSTSIZE=1 SRCINC=3 SRCSIZE=1, XFERSIZE=1023
+	{ DMA_Mode_PingPong,	DMA_Size_16bit, DMA_Inc_None,		DMA_Inc_16bit, DMA_Arb_1,		1024,	0x5D003FF3,	0,		2046	},
+	//	Single item: both end pointers are the start addresses
+	{ DMA_Mode_MemSGAlt,	DMA_Size_8bit,	DMA_Inc_8bit,		DMA_Inc_8bit,	 DMA_Arb_8,		1,		0x0000C005,	0,		0			},
+	//	16-bit items with 32-bit source increment (every other half-word)
+	{ DMA_Mode_Basic,			DMA_Size_16bit, DMA_Inc_32bit,	DMA_Inc_16bit, DMA_Arb_1024, 10,	0x59028091,	36,		18		},
+};
+
+static uint8_t Src[4096], Dst[4096];
+static unsigned Errors;
+
+
+static void Expect(const char* What, uint32_t Value, uint32_t Expected)
+{
+	if(Value != Expected)
+	{
+		printf("FAIL: %s = %08X, expected %08X\n", What, Value, Expected);
+		Errors++;
+	}
+}
+
+
+int main(void)
+{
+	static DMAControl Tasks[3];
+	DMAControl* pEntry;
+	uint32_t i;
+
+	for(i = 0; i < sizeof(Src); i++)
+		Src[i] = (uint8_t)(i * 7 + 3);
+
+	SimInit();
+	DMAInit();
+
+	Expect("CTLBASE", pDMA->CTLBASE, BUS_ADDR(DMAControlTable));
+	Expect("CTLBASE alignment", BUS_ADDR(DMAControlTable) & 0x3FF, 0);
+	Expect("alternate structure of channel 5", (uint32_t)(DMAGetEntry(5, DMA_ALTERNATE) - DMAControlTable), 37);
+	Expect("count 0", DMAControlWord(DMA_Mode_Basic, DMA_Size_8bit, DMA_Inc_8bit, DMA_Inc_8bit, DMA_Arb_1, 0), 0);
+	Expect("count 1025", DMAControlWord(DMA_Mode_Basic, DMA_Size_8bit, DMA_Inc_8bit, DMA_Inc_8bit, DMA_Arb_1, 1025), 0);
+
+	for(i = 0; i < sizeof(Cases)/sizeof(Cases[0]); i++)
+	{
+		const Case* c = &Cases[i];
+		uint32_t Control = DMAControlWord(c->Mode, c->Size, c->SrcInc, c->DstInc, c->Arb, c->Count);
+
+		Expect("control word", Control, c->Control);
+
+		DMASetTransfer(12, DMA_ALTERNATE, Control, Src, Dst);
+		pEntry = DMAGetEntry(12, DMA_ALTERNATE);
+		Expect("source end", pEntry->SrcEnd, BUS_ADDR(Src) + c->SrcOffset);
+		Expect("destination end", pEntry->DstEnd, BUS_ADDR(Dst) + c->DstOffset);
+		Expect("control", pEntry->Control, c->Control);
+	}
+
+	//	Auto mode: the whole transfer runs on one software request.
+	DMASetTransfer(30, DMA_PRIMARY, Cases[0].Control, Src, Dst);
+	DMAChannelConfig(30, 0, 0);
+	DMAEnableChannel(30);
+	DMARequest(30);
+	Expect("auto copy", memcmp(Src, Dst, 400) != 0, 0);
+	Expect("byte after the auto copy", Dst[400], 0);
+	Expect("auto completion", GET_BIT(DMAGetIntStatus(), 30), 1);
+	Expect("auto mode after completion", DMAGetMode(30, DMA_PRIMARY), DMA_Mode_Stop);
+	DMAClearIntStatus(~0U);
+
+	//	Memory scatter-gather: three tasks of different sizes, the last one in auto mode.
+	memset(Dst, 0, sizeof(Dst));
+	DMAFillEntry(&Tasks[0], DMAControlWord(DMA_Mode_MemSGAlt, DMA_Size_8bit, DMA_Inc_8bit, DMA_Inc_8bit, DMA_Arb_8, 10),
+							 Src + 100, Dst);
+	DMAFillEntry(&Tasks[1], DMAControlWord(DMA_Mode_MemSGAlt, DMA_Size_16bit, DMA_Inc_16bit, DMA_Inc_16bit, DMA_Arb_8, 20),
+							 Src + 200, Dst + 10);
+	DMAFillEntry(&Tasks[2], DMAControlWord(DMA_Mode_Auto, DMA_Size_8bit, DMA_Inc_8bit, DMA_Inc_8bit, DMA_Arb_8, 5),
+							 Src + 300, Dst + 50);
+	Expect("task 1 source end", Tasks[1].SrcEnd, BUS_ADDR(Src) + 200 + 38);
+	Expect("task 1 destination end", Tasks[1].DstEnd, BUS_ADDR(Dst) + 10 + 38);
+
+	DMASetScatterGather(29, 0, Tasks, 3);
+	pEntry = DMAGetEntry(29, DMA_PRIMARY);
+	//	DSTINC=2 DSTSIZE=2 SRCINC=2 SRCSIZE=2 ARBSIZE=2 XFERSIZE=11 (3 tasks * 4 words - 1) MODE=4
+	Expect("scatter-gather control", pEntry->Control, 0xAA0080B4);
+	Expect("scatter-gather source end", pEntry->SrcEnd, BUS_ADDR(&Tasks[2].Unused));
+	Expect("scatter-gather destination end", pEntry->DstEnd, BUS_ADDR(&DMAGetEntry(29, DMA_ALTERNATE)->Unused));
+
+	DMAChannelConfig(29, 0, 0);
+	DMAEnableChannel(29);
+	DMARequest(29);
+	Expect("task 0 copy", memcmp(Dst, Src + 100, 10) != 0, 0);
+	Expect("task 1 copy", memcmp(Dst + 10, Src + 200, 40) != 0, 0);
+	Expect("task 2 copy", memcmp(Dst + 50, Src + 300, 5) != 0, 0);
+	Expect("scatter-gather completion", GET_BIT(DMAGetIntStatus(), 29), 1);
+	Expect("bus error", DMAGetError(), 0);
+
+	printf("%u failures\n", Errors);
+	return Errors != 0;
+}
@@ -0,0 +1,114 @@
+/******************************************************************************************************************
+*	@file			-	test_gpio_masked_write.c
+*
+*	Host test of the address-masked GPIO data writes. For every mask and a few values, WriteToPortMasked() must change
+*	only the masked pins of the port, with one register write and no register read. WriteToPin(), TurnOn() and
+*	TurnOff() must do the same for a single pin, and ToggleGPIOPin() must change only its own pin. A read through the
+*	masked window must return only the masked bits.
+******************************************************************************************************************/
+
+#include "TM4C123xxSIM.h"
+#include <stdio.h>
+
+static const uint8_t PortB[8] = { PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7 };
+static const uint8_t Values[4] = { 0x00, 0xFF, 0xA5, 0x3C };
+
+static unsigned Errors;
+
+
+//	Levels of PB0-PB7 as seen from outside. Does not access the registers.
+static uint8_t PinsB(void)
+{
+	uint8_t i, Levels = 0;
+
+	for(i = 0; i < 8; i++)
+		Levels |= SimGetPinLevel(PortB[i]) << i;
+
+	return Levels;
+}
+
+static void Check(const char* What, uint8_t Before, uint8_t Expected, const SimStats* s, uint32_t Reads, uint32_t Writes)
+{
+	uint8_t After = PinsB();
+
+	if(After != Expected || s->Reads != Reads || s->Writes != Writes)
+	{
+		if(Errors++ < 10)
+			printf("FAIL: %s: pins %02X -> %02X (expected %02X), %u reads, %u writes (expected %u, %u)\n",
+						 What, Before, After, Expected, s->Reads, s->Writes, Reads, Writes);
+	}
+}
+
+
+int main(void)
+{
+	SimStats s;
+	uint8_t Before, Expected, v, i;
+	uint16_t Mask;
+	unsigned Cases = 0;
+
+	SimInit();
+	GPIO_InitPort(GPIO_PORT_B, 0xFF, Output, Digital, Two_mA, NoInterrupt);
+
+	for(Mask = 0; Mask < 256; Mask++)
+	{
+		for(v = 0; v < 4; v++)
+		{
+			WriteToPort(GPIO_PORT_B, (uint8_t)(0x96 ^ Mask));
+			Before = PinsB();
+			Expected = (Before & ~Mask) | (Values[v] & Mask);
+
+			SimResetStats();
+			WriteToPortMasked(GPIO_PORT_B, (uint8_t)Mask, Values[v]);
+			SimGetStats(&s);
+			Check("WriteToPortMasked", Before, Expected, &s, 0, 1);
+			Cases++;
+
+			if( GPIO_B_P->GPIO_DATA_A[Mask] != (Expected & Mask) )
+			{
+				if(Errors++ < 10)
+					printf("FAIL: masked read %02X returns other bits\n", Mask);
+			}
+		}
+	}
+
+	for(i = 0; i < 8; i++)
+	{
+		WriteToPort(GPIO_PORT_B, 0x5A);
+
+		Before = PinsB();
+		SimResetStats();
+		WriteToPin(PortB[i], PIN_SET);
+		SimGetStats(&s);
+		Check("WriteToPin(SET)", Before, Before | (1 << i), &s, 0, 1);
+
+		Before = PinsB();
+		SimResetStats();
+		WriteToPin(PortB[i], PIN_RESET);
+		SimGetStats(&s);
+		Check("WriteToPin(RESET)", Before, Before & ~(1 << i), &s, 0, 1);
+
+		Before = PinsB();
+		SimResetStats();
+		TurnOn(PortB[i]);
+		SimGetStats(&s);
+		Check("TurnOn", Before, Before | (1 << i), &s, 0, 1);
+
+		Before = PinsB();
+		SimResetStats();
+		TurnOff(PortB[i]);
+		SimGetStats(&s);
+		Check("TurnOff", Before, Before & ~(1 << i), &s, 0, 1);
+
+		//	The toggle reads the masked window once, which returns only the bit of this pin.
+		Before = PinsB();
+		SimResetStats();
+		ToggleGPIOPin(PortB[i]);
+		SimGetStats(&s);
+		Check("ToggleGPIOPin", Before, Before ^ (1 << i), &s, 1, 1);
+		Cases += 5;
+	}
+
+	printf("%u cases, %u failures\n", Cases, Errors);
+	return Errors != 0;
+}
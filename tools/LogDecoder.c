@@ -0,0 +1,277 @@
+/******************************************************************************************************************
+*	@file			-	LogDecoder.c																																												*
+*	@author		-	Ronit Vairagi																																												*
+*																																																									*
+*	Decoder of the deferred (binary) log of TM4C123xxLOG.c. It reads the format strings from the "logstr" section of	*
+*	the ELF file of the firmware, and turns the bytes received from the UART back into text.												*
+*																																																									*
+*	Build	:	gcc -O2 -o logdecoder tools/LogDecoder.c																																*
+*	Use		:	logdecoder <firmware.elf> [capture]			(reads the capture from stdin if it isn't given)								*
+*					Ex:	stty -F /dev/ttyACM0 115200 raw && logdecoder firmware.elf < /dev/ttyACM0														*
+*																																																									*
+*	@Note			-	Runs on the build machine (Linux). It is not a part of the firmware.																*
+*																																																									*
+*	@Note2		- Feel free to use, modify, and/or re-distribute this code at your will.															*
+******************************************************************************************************************/
+
+#include<stdint.h>
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<fcntl.h>
+#include<unistd.h>
+
+// Must match TM4C123xxLOG.h
+#define LOG_MAX_ARGS					15
+#define LOG_SYNC							0xA5
+#define LOG_LOST_ID						0xFFFFF
+
+#define READ_CHUNK						4096
+
+
+// GLOBAL VARIABLES
+
+// @Strings - Contents of the "logstr" section. A format ID is an offset into it.
+static char* Strings;
+static uint32_t StringsSize;
+
+
+static uint32_t Get16(const uint8_t* p)		{ return p[0] | (p[1]<<8); }
+static uint32_t Get32(const uint8_t* p)		{ return p[0] | (p[1]<<8) | (p[2]<<16) | ((uint32_t)p[3]<<24); }
+static uint64_t Get64(const uint8_t* p)		{ return Get32(p) | ((uint64_t)Get32(p+4)<<32); }
+
+
+
+/******************************************************************************************************************
+*	@LoadStrings()																																																	*
+*	@brief				-	Reads the ELF file (32 or 64-bit, little-endian) and copies its "logstr" section into Strings.	*
+* @return				-	0 on success, 1 on error (a message has been printed).																					*
+******************************************************************************************************************/
+static int LoadStrings(const char* Path)
+{
+	FILE* f = fopen(Path, "rb");
+	uint8_t* Elf;
+	long Size;
+	int Is64;
+	uint64_t ShOff;
+	uint32_t ShEntSize, ShNum, ShStrNdx, i;
+	const uint8_t* ShStr;
+	
+	if(!f)
+	{
+		perror(Path);
+		return 1;
+	}
+	fseek(f, 0, SEEK_END);
+	Size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	Elf = malloc(Size);
+	if( !Elf || fread(Elf, 1, Size, f) != (size_t)Size )
+	{
+		fprintf(stderr, "%s: read error\n", Path);
+		fclose(f);
+		return 1;
+	}
+	fclose(f);
+	
+	if( Size < 52 || memcmp(Elf, "\177ELF", 4) || Elf[5] != 1 )
+	{
+		fprintf(stderr, "%s: not a little-endian ELF file\n", Path);
+		return 1;
+	}
+	
+	Is64 = (Elf[4] == 2);
+	ShOff = Is64 ? Get64(Elf + 0x28) : Get32(Elf + 0x20);
+	ShEntSize = Get16(Elf + (Is64 ? 0x3A : 0x2E));
+	ShNum = Get16(Elf + (Is64 ? 0x3C : 0x30));
+	ShStrNdx = Get16(Elf + (Is64 ? 0x3E : 0x32));
+	if( ShOff + (uint64_t)ShEntSize*ShNum > (uint64_t)Size || ShStrNdx >= ShNum )
+	{
+		fprintf(stderr, "%s: bad section header table\n", Path);
+		return 1;
+	}
+	
+	// Section header: name (+0), type (+4), offset (+0x10/+0x18) and size (+0x14/+0x20).
+	ShStr = Elf + ShOff + (uint64_t)ShStrNdx*ShEntSize;
+	ShStr = Elf + (Is64 ? Get64(ShStr + 0x18) : Get32(ShStr + 0x10));
+	
+	for(i = 0; i < ShNum; i++)
+	{
+		const uint8_t* Sh = Elf + ShOff + (uint64_t)i*ShEntSize;
+		uint64_t Offset = Is64 ? Get64(Sh + 0x18) : Get32(Sh + 0x10);
+		uint64_t Length = Is64 ? Get64(Sh + 0x20) : Get32(Sh + 0x14);
+	
+		if( strcmp((const char*)ShStr + Get32(Sh), "logstr") )
+			continue;
+		if( Get32(Sh + 4) == 8 || Offset + Length > (uint64_t)Size )		// SHT_NOBITS: the contents are not in the file
+		{
+			fprintf(stderr, "%s: the logstr section has no contents\n", Path);
+			return 1;
+		}
+		Strings = malloc(Length + 1);
+		memcpy(Strings, Elf + Offset, Length);
+		Strings[Length] = '\0';
+		StringsSize = (uint32_t)Length;
+		free(Elf);
+		return 0;
+	}
+	
+	fprintf(stderr, "%s: no logstr section (is LOG() used?)\n", Path);
+	return 1;
+}
+
+
+
+/******************************************************************************************************************
+*	@PrintRecord()																																																	*
+*	@brief				-	Expands one format string with its arguments, like printf() would on the target.								*
+******************************************************************************************************************/
+static void PrintRecord(const char* Format, const uint32_t* Args, uint32_t Count)
+{
+	char Spec[32];
+	uint32_t Next = 0;
+	const char* p = Format;
+	
+	while(*p)
+	{
+		uint32_t Len = 0;
+		char Conv;
+	
+		if(*p != '%')
+		{
+			putchar(*p++);
+			continue;
+		}
+	
+		Spec[Len++] = *p++;
+		while( *p && strchr("-+ #0", *p) && Len < sizeof(Spec) - 4 )				Spec[Len++] = *p++;
+		while( *p && strchr("0123456789.", *p) && Len < sizeof(Spec) - 4 )		Spec[Len++] = *p++;
+		while( *p && strchr("hlzjt", *p) )		p++;											//	Arguments are 32 bits on the line
+		Conv = *p;
+		if(Conv)	p++;
+	
+		if(Conv == '%')
+		{
+			putchar('%');
+			continue;
+		}
+		if( !strchr("diuxXocp", Conv) || Conv == '\0' )
+		{
+			printf("<%%%c?>", Conv);
+			continue;
+		}
+		if(Next >= Count)
+		{
+			printf("<missing>");
+			continue;
+		}
+	
+		if(Conv == 'p')
+		{
+			printf("0x%08x", Args[Next++]);
+			continue;
+		}
+		Spec[Len++] = Conv;
+		Spec[Len] = '\0';
+		if(Conv == 'd' || Conv == 'i' || Conv == 'c')
+			printf(Spec, (int)(int32_t)Args[Next++]);
+		else
+			printf(Spec, (unsigned)Args[Next++]);
+	}
+}
+
+
+
+/******************************************************************************************************************
+*	@Decode()																																																				*
+*	@brief				-	Decodes the complete records at the start of Buf.																								*
+* @return				-	No of bytes used. The rest (a part of a record) must be given again with more bytes.						*
+*																																																									*
+*	@Note					-	A word which is not a valid header (sync byte, no of arguments, format ID at the start of a string)	*
+*									is skipped one byte at a time, so the decoder finds the records again after lost bytes.					*
+******************************************************************************************************************/
+static size_t Decode(const uint8_t* Buf, size_t Len, int Final)
+{
+	size_t Pos = 0;
+	size_t Skipped = 0;
+	
+	while(Pos + 4 <= Len)
+	{
+		uint32_t Header = Get32(Buf + Pos);
+		uint32_t Count = (Header >> 20) & 0xF;
+		uint32_t Id = Header & 0xFFFFF;
+		uint32_t Args[LOG_MAX_ARGS];
+		uint32_t i;
+	
+		if( (Header >> 24) != LOG_SYNC || !( (Id == LOG_LOST_ID && Count == 1) ||
+				(Id < StringsSize && (Id == 0 || Strings[Id-1] == '\0')) ) )
+		{
+			Pos++;
+			Skipped++;
+			continue;
+		}
+		if(Pos + 4 + 4*Count > Len)
+			break;
+	
+		if(Skipped)
+		{
+			printf("<%zu bytes skipped>\n", Skipped);
+			Skipped = 0;
+		}
+		for(i = 0; i < Count; i++)
+			Args[i] = Get32(Buf + Pos + 4 + 4*i);
+		if(Id == LOG_LOST_ID)
+			printf("<%u records lost>\n", Args[0]);
+		else
+			PrintRecord(Strings + Id, Args, Count);
+		Pos += 4 + 4*Count;
+	}
+	
+	if(Final)
+	{
+		Skipped += Len - Pos;
+		Pos = Len;
+	}
+	if(Skipped)
+		printf("<%zu bytes skipped>\n", Skipped);
+	fflush(stdout);
+	
+	return Pos;
+}
+
+
+
+int main(int argc, char** argv)
+{
+	uint8_t Buf[2*READ_CHUNK];
+	size_t Len = 0;
+	ssize_t n;
+	int fd = 0;
+	
+	if(argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "usage: %s <firmware.elf> [capture]\n", argv[0]);
+		return 2;
+	}
+	if( LoadStrings(argv[1]) )
+		return 1;
+	if( argc == 3 && (fd = open(argv[2], O_RDONLY)) < 0 )
+	{
+		perror(argv[2]);
+		return 1;
+	}
+	
+	// read() returns what has arrived so far, so records are printed as soon as they are complete on a live port.
+	while( (n = read(fd, Buf + Len, READ_CHUNK)) > 0 )
+	{
+		size_t Used;
+	
+		Len += n;
+		Used = Decode(Buf, Len, 0);
+		memmove(Buf, Buf + Used, Len - Used);
+		Len -= Used;
+	}
+	Decode(Buf, Len, 1);
+	
+	return 0;
+}